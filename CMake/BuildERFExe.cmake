@@ -28,11 +28,17 @@ function(build_erf_lib erf_lib_name)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_WARM_NO_PRECIP)
   endif()
 
+  if(ERF_ENABLE_MIXED_PRECISION)
+    target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_MIXED_PRECISION)
+  endif()
+
   if(ERF_ENABLE_POISSON_SOLVE)
     target_sources(${erf_lib_name} PRIVATE
                    ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_inc.cpp
                    ${SRC_DIR}/Utils/ERF_PoissonSolve.cpp
-                   ${SRC_DIR}/Utils/ERF_PoissonSolve_tb.cpp)
+                   ${SRC_DIR}/Utils/ERF_PoissonSolve_tb.cpp
+                   ${SRC_DIR}/Utils/ERF_PoissonSolve_terrain.cpp
+                   ${SRC_DIR}/Utils/ERF_TerrainPoisson.cpp)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_POISSON_SOLVE)
   endif()
 
@@ -41,8 +47,12 @@ function(build_erf_lib erf_lib_name)
                    ${SRC_DIR}/Particles/ERFPCEvolve.cpp
                    ${SRC_DIR}/Particles/ERFPCInitializations.cpp
                    ${SRC_DIR}/Particles/ERFPCUtils.cpp
-                   ${SRC_DIR}/Particles/ERFTracers.cpp)
+                   ${SRC_DIR}/Particles/ERFTracers.cpp
+                   ${SRC_DIR}/Microphysics/SuperDroplets/ERF_Init_SuperDroplets.cpp
+                   ${SRC_DIR}/Microphysics/SuperDroplets/ERF_Advance_SuperDroplets.cpp
+                   ${SRC_DIR}/Microphysics/SuperDroplets/ERF_Update_SuperDroplets.cpp)
     target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/Particles)
+    target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/Microphysics/SuperDroplets)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_PARTICLES)
   endif()
 
@@ -107,6 +117,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/ERF.cpp
        ${SRC_DIR}/ERF_make_new_arrays.cpp
        ${SRC_DIR}/ERF_make_new_level.cpp
+       ${SRC_DIR}/ERF_load_balance.cpp
        ${SRC_DIR}/ERF_read_waves.cpp
        ${SRC_DIR}/ERF_Tagging.cpp
        ${SRC_DIR}/Advection/ERF_AdvectionSrcForMom.cpp
@@ -132,6 +143,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Diffusion/ERF_ComputeStrain_N.cpp
        ${SRC_DIR}/Diffusion/ERF_ComputeStrain_T.cpp
        ${SRC_DIR}/Diffusion/ERF_ComputeTurbulentViscosity.cpp
+       ${SRC_DIR}/Diffusion/ERF_ImplicitDiff.cpp
        ${SRC_DIR}/Initialization/ERF_init_custom.cpp
        ${SRC_DIR}/Initialization/ERF_init_from_hse.cpp
        ${SRC_DIR}/Initialization/ERF_init_from_input_sounding.cpp
@@ -174,6 +186,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_N.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_T.cpp
        ${SRC_DIR}/TimeIntegration/ERF_fast_rhs_MT.cpp
+       ${SRC_DIR}/Utils/ERF_BoxCosts.cpp
        ${SRC_DIR}/Utils/ERF_ChopGrids.cpp
        ${SRC_DIR}/Utils/ERF_MomentumToVelocity.cpp
        ${SRC_DIR}/Utils/ERF_TerrainMetrics.cpp
@@ -181,10 +194,7 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Utils/ERF_InteriorGhostCells.cpp
        ${SRC_DIR}/Utils/ERF_Time_Avg_Vel.cpp
        ${SRC_DIR}/Microphysics/SAM/ERF_Init_SAM.cpp
-       ${SRC_DIR}/Microphysics/SAM/ERF_Cloud_SAM.cpp
-       ${SRC_DIR}/Microphysics/SAM/ERF_IceFall.cpp
-       ${SRC_DIR}/Microphysics/SAM/ERF_Precip.cpp
-       ${SRC_DIR}/Microphysics/SAM/ERF_PrecipFall.cpp
+       ${SRC_DIR}/Microphysics/SAM/ERF_Advance_SAM.cpp
        ${SRC_DIR}/Microphysics/SAM/ERF_Update_SAM.cpp
        ${SRC_DIR}/Microphysics/Kessler/ERF_Init_Kessler.cpp
        ${SRC_DIR}/Microphysics/Kessler/ERF_Kessler.cpp
@@ -192,6 +202,7 @@ function(build_erf_lib erf_lib_name)
 	   ${SRC_DIR}/WindFarmParametrization/Fitch/ERF_AdvanceFitch.cpp
 	   ${SRC_DIR}/WindFarmParametrization/EWP/ERF_AdvanceEWP.cpp
 	   ${SRC_DIR}/WindFarmParametrization/SimpleActuatorDisk/ERF_AdvanceSimpleAD.cpp
+	   ${SRC_DIR}/WindFarmParametrization/GeneralActuatorDisk/ERF_AdvanceGeneralAD.cpp
        ${SRC_DIR}/LandSurfaceModel/SLM/ERF_SLM.cpp
        ${SRC_DIR}/LandSurfaceModel/MM5/ERF_MM5.cpp
   )
@@ -245,6 +256,7 @@ function(build_erf_lib erf_lib_name)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/Fitch)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/EWP)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/SimpleActuatorDisk)
+  target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/GeneralActuatorDisk)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/LandSurfaceModel)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/LandSurfaceModel/Null)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/LandSurfaceModel/SLM)
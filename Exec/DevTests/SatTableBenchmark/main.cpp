@@ -0,0 +1,131 @@
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include "ERF_SAMCloud.H"
+
+using namespace amrex;
+
+/**
+ * Fill the SAM microphysics state with a moist profile. The temperature falls
+ * from 300 K to 200 K with height, the relative humidity grows from 0 to rh_max
+ * along x and every other y-row starts with cloud condensate, so each column
+ * exercises both the Newton iteration and the evaporation branch of SAMCloud.
+ */
+void
+init_mic (const Box& bx, const Array4<Real>& mic, Real rh_max, Real qn_init)
+{
+    const int  ilo = bx.smallEnd(0);
+    const int  klo = bx.smallEnd(2);
+    const Real nx  = static_cast<Real>(bx.length(0));
+    const Real nz  = static_cast<Real>(bx.length(2));
+    const Real rdOcp = R_d / Cp_d;
+
+    ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real zfrac = (k - klo + 0.5) / nz;
+        Real tabs  = 300.0 - 100.0*zfrac;
+        Real pres  = 1000.0 * std::exp(-7.0*zfrac);
+        Real rh    = rh_max * (i - ilo + 0.5) / nx;
+
+        Real qsatw;
+        erf_qsatw(tabs, pres, qsatw);
+        Real qv = rh * qsatw;
+        Real qn = (j%2 == 0) ? qn_init : 0.0;
+
+        mic(i,j,k,MicVar::qv)    = qv;
+        mic(i,j,k,MicVar::qn)    = qn;
+        mic(i,j,k,MicVar::qcl)   = qn;
+        mic(i,j,k,MicVar::qci)   = 0.0;
+        mic(i,j,k,MicVar::qt)    = qv + qn;
+        mic(i,j,k,MicVar::tabs)  = tabs;
+        mic(i,j,k,MicVar::pres)  = pres;
+        mic(i,j,k,MicVar::rho)   = 100.0*pres / (R_d * tabs * (1.0 + R_v/R_d * qv));
+        mic(i,j,k,MicVar::theta) = getThgivenPandT(tabs, 100.0*pres, rdOcp);
+    });
+}
+
+/**
+ * Average wall time of one SAMCloud sweep over bx, restarting from init each time
+ */
+Real
+time_sam_cloud (const Box& bx, const FArrayBox& init, FArrayBox& work,
+                const SatTableView& sat_tab, int moisture_type, int n_iter)
+{
+    const Real fac_cond = lcond / Cp_d;
+    const Real fac_fus  = lfus  / Cp_d;
+    const Real fac_sub  = lsub  / Cp_d;
+    const Real rdOcp    = R_d   / Cp_d;
+
+    Real elapsed = 0.0;
+    for (int it = 0; it < n_iter; ++it) {
+        work.copy<RunOn::Device>(init);
+        Gpu::streamSynchronize();
+
+        const Real strt = amrex::second();
+        auto const& mic = work.array();
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            SAMCloud(i, j, k, mic, moisture_type,
+                     fac_cond, fac_fus, fac_sub, rdOcp, false, sat_tab);
+        });
+        Gpu::streamSynchronize();
+        elapsed += amrex::second() - strt;
+    }
+    return elapsed / n_iter;
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        Vector<int> n_cell = {64, 64, 64};
+        int  n_iter        = 20;
+        int  moisture_type = 1;
+        Real rh_max        = 1.2;
+        Real qn_init       = 1.0e-4;
+
+        ParmParse pp("bench");
+        pp.queryarr("n_cell", n_cell, 0, AMREX_SPACEDIM);
+        pp.query("n_iter", n_iter);
+        pp.query("moisture_type", moisture_type);
+        pp.query("rh_max", rh_max);
+        pp.query("qn_init", qn_init);
+
+        const Box bx(IntVect(0), IntVect(n_cell[0]-1, n_cell[1]-1, n_cell[2]-1));
+
+        FArrayBox init(bx, MicVar::NumVars, The_Async_Arena());
+        FArrayBox work_fit(bx, MicVar::NumVars, The_Async_Arena());
+        FArrayBox work_tab(bx, MicVar::NumVars, The_Async_Arena());
+        init.setVal<RunOn::Device>(0.0);
+        init_mic(bx, init.array(), rh_max, qn_init);
+
+        Gpu::DeviceVector<Real> table;
+        erf_build_sat_table(table, true);
+
+        // Untimed warm-up of both variants
+        time_sam_cloud(bx, init, work_fit, SatTableView{}, moisture_type, 1);
+        time_sam_cloud(bx, init, work_tab, SatTableView{table.data()}, moisture_type, 1);
+
+        Real t_fit = time_sam_cloud(bx, init, work_fit, SatTableView{}, moisture_type, n_iter);
+        Real t_tab = time_sam_cloud(bx, init, work_tab, SatTableView{table.data()}, moisture_type, n_iter);
+
+        // Difference of the adjusted states
+        FArrayBox diff(bx, MicVar::NumVars, The_Async_Arena());
+        diff.copy<RunOn::Device>(work_tab);
+        diff.minus<RunOn::Device>(work_fit);
+
+        const Real ncells = static_cast<Real>(bx.numPts());
+        amrex::Print() << "SAMCloud on " << bx.size() << " cells, " << n_iter << " sweeps\n"
+                       << "  analytic fits: " << t_fit << " s/sweep, "
+                       << 1.0e9*t_fit/ncells << " ns/cell\n"
+                       << "  table        : " << t_tab << " s/sweep, "
+                       << 1.0e9*t_tab/ncells << " ns/cell\n"
+                       << "  speedup      : " << t_fit/t_tab << "\n"
+                       << "  max |d tabs| : " << diff.maxabs<RunOn::Device>(MicVar::tabs) << " K\n"
+                       << "  max |d qv|   : " << diff.maxabs<RunOn::Device>(MicVar::qv) << "\n"
+                       << "  max |d qn|   : " << diff.maxabs<RunOn::Device>(MicVar::qn) << std::endl;
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,48 @@
+#!/bin/bash
+#
+# Time the simple actuator disk source terms for an increasing number of turbines.
+#
+# Usage: ./turbine_scaling.sh <path to ERF executable built with TINY_PROFILE=TRUE> [nsteps]
+#
+# The turbines are put on a regular lattice in a 2 km x 2 km domain (10 m cells) with
+# a small rotor so that disks never overlap; for each count the TinyProfiler time of
+# SimpleAD::source_terms_cellcentered() is reported.
+
+EXE=${1:?"usage: $0 <ERF executable> [nsteps]"}
+NSTEPS=${2:-20}
+
+WORKDIR=turbine_scaling_runs
+mkdir -p ${WORKDIR}
+
+# hub height 60 m, rotor diameter 40 m
+cat > ${WORKDIR}/windturbines_spec_small.tbl <<SPEC
+4
+60.0 40.0 0.130 2.0
+9   0.805    50.0
+10   0.805    50.0
+11   0.805    50.0
+12   0.805    50.0
+SPEC
+
+printf "%10s %20s\n" "nturbs" "source_terms [s]"
+for NSIDE in 1 4 8 16 24; do
+    NTURB=$((NSIDE*NSIDE))
+    LOC=${WORKDIR}/windturbines_loc_${NTURB}.txt
+    rm -f ${LOC}
+    for ((ix=0; ix<NSIDE; ix++)); do
+        for ((iy=0; iy<NSIDE; iy++)); do
+            echo "$((100 + ix*80)).0 $((100 + iy*80)).0" >> ${LOC}
+        done
+    done
+
+    LOG=${WORKDIR}/run_${NTURB}.log
+    ${EXE} inputs_1WT_x_y max_step=${NSTEPS} \
+        geometry.prob_extent="2000.0 2000.0 500.0" amr.n_cell="200 200 50" \
+        amr.max_grid_size=64 fabarray.mfiter_tile_size="1024 16 1024" \
+        erf.windfarm_loc_table=${LOC} \
+        erf.windfarm_spec_table=${WORKDIR}/windturbines_spec_small.tbl \
+        erf.fixed_dt=0.05 erf.check_int=-1 erf.plot_int_1=-1 > ${LOG} 2>&1
+
+    TIME=$(grep "SimpleAD::source_terms_cellcentered()" ${LOG} | head -1 | awk '{print $4}')
+    printf "%10d %20s\n" ${NTURB} ${TIME:-"n/a"}
+done
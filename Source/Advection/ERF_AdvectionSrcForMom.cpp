@@ -6,6 +6,181 @@
 
 using namespace amrex;
 
+namespace {
+/**
+ * Advective tendency for the momentum equations with terrain (or EB). AreaArr is the
+ * stored Array4 of the face areas or a CompactArea4, so the kernels do not branch on it.
+ */
+template <typename AreaArr>
+void
+AdvectionSrcForMomTerrain (const Box& bxx, const Box& bxy, const Box& bxz,
+                           const Array4<      Real>& rho_u_rhs,
+                           const Array4<      Real>& rho_v_rhs,
+                           const Array4<      Real>& rho_w_rhs,
+                           const Array4<const Real>& u,
+                           const Array4<const Real>& v,
+                           const Array4<const Real>& w,
+                           const Array4<const Real>& rho_u,
+                           const Array4<const Real>& rho_v,
+                           const Array4<const Real>& Omega,
+                           const Array4<const Real>& z_nd,
+                           const AreaArr& ax,
+                           const AreaArr& ay,
+                           const AreaArr& az,
+                           const Array4<const Real>& detJ,
+                           const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                           const Array4<const Real>& mf_m,
+                           const Array4<const Real>& mf_u,
+                           const Array4<const Real>& mf_v,
+                           const Array4<const Real>& mf_u_inv,
+                           const Array4<const Real>& mf_v_inv,
+                           const AdvType horiz_adv_type,
+                           const AdvType vert_adv_type,
+                           const Real horiz_upw_frac,
+                           const Real vert_upw_frac,
+                           const int lo_z_face, const int hi_z_face)
+{
+    auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
+
+    // Inline with 2nd order for efficiency
+    if (horiz_adv_type == AdvType::Centered_2nd && vert_adv_type == AdvType::Centered_2nd)
+    {
+        ParallelFor(bxx, bxy, bxz,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real xflux_hi = 0.25 * (rho_u(i,j,k) * mf_u_inv(i,j,0) + rho_u(i+1,j,k) * mf_u_inv(i+1,j,0)) *
+                                   (u(i+1,j,k) + u(i,j,k)) * 0.5 * (ax(i,j,k) + ax(i+1,j,k));
+
+            Real xflux_lo = 0.25 * (rho_u(i,j,k) * mf_u_inv(i,j,0) + rho_u(i-1,j,k) * mf_u_inv(i-1,j,0)) *
+                                   (u(i-1,j,k) + u(i,j,k)) * 0.5 * (ax(i,j,k) + ax(i-1,j,k));
+
+            Real met_h_zeta_yhi = Compute_h_zeta_AtEdgeCenterK(i,j+1,k,cellSizeInv,z_nd);
+            Real yflux_hi = 0.25 * (rho_v(i,j+1,k)*mf_v_inv(i,j+1,0) + rho_v(i-1,j+1,k)*mf_v_inv(i-1,j+1,0)) *
+                                   (u(i,j+1,k) + u(i,j,k)) * met_h_zeta_yhi;
+
+            Real met_h_zeta_ylo = Compute_h_zeta_AtEdgeCenterK(i,j  ,k,cellSizeInv,z_nd);
+            Real yflux_lo = 0.25 * (rho_v(i,j  ,k)*mf_v_inv(i,j  ,0) + rho_v(i-1,j  ,k)*mf_v_inv(i-1,j  ,0)) *
+                                   (u(i,j-1,k) + u(i,j,k)) * met_h_zeta_ylo;
+
+            Real zflux_hi = 0.25 * (Omega(i,j,k+1) + Omega(i-1,j,k+1)) * (u(i,j,k+1) + u(i,j,k)) *
+                                    0.5 * (az(i,j,k+1) + az(i-1,j,k+1));
+            Real zflux_lo = 0.25 * (Omega(i,j,k  ) + Omega(i-1,j,k  )) * (u(i,j,k-1) + u(i,j,k)) *
+                                    0.5 * (az(i,j,k  ) + az(i-1,j,k  ));
+
+            Real mfsq = mf_u(i,j,0) * mf_u(i,j,0);
+
+            Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
+                              + (yflux_hi - yflux_lo) * dyInv * mfsq
+                              + (zflux_hi - zflux_lo) * dzInv;
+
+            rho_u_rhs(i, j, k) = -advectionSrc / (0.5 * (detJ(i,j,k) + detJ(i-1,j,k)));
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+
+            Real met_h_zeta_xhi = Compute_h_zeta_AtEdgeCenterK(i+1,j,k,cellSizeInv,z_nd);
+            Real xflux_hi = 0.25 * (rho_u(i+1,j,k)*mf_u_inv(i+1,j,0) + rho_u(i+1,j-1,k)*mf_u_inv(i+1,j-1,0)) *
+                                   (v(i+1,j,k) + v(i,j,k)) * met_h_zeta_xhi;
+
+            Real met_h_zeta_xlo = Compute_h_zeta_AtEdgeCenterK(i  ,j,k,cellSizeInv,z_nd);
+            Real xflux_lo = 0.25 * (rho_u(i, j, k)*mf_u_inv(i  ,j,0) + rho_u(i  ,j-1,k)*mf_u_inv(i-1,j  ,0)) *
+                                   (v(i-1,j,k) + v(i,j,k)) * met_h_zeta_xlo;
+
+            Real yflux_hi = 0.25 * (rho_v(i,j+1,k)*mf_v_inv(i,j+1,0) + rho_v(i,j  ,k) * mf_v_inv(i,j  ,0)) *
+                                   (v(i,j+1,k) + v(i,j,k)) * 0.5 * (ay(i,j,k) + ay(i,j+1,k));
+
+            Real yflux_lo = 0.25 * (rho_v(i,j  ,k)*mf_v_inv(i,j  ,0) + rho_v(i,j-1,k) * mf_v_inv(i,j-1,0)) *
+                                   (v(i,j-1,k) + v(i,j,k)) * 0.5 * (ay(i,j,k) + ay(i,j-1,k));
+
+            Real zflux_hi = 0.25 * (Omega(i,j,k+1) + Omega(i, j-1, k+1)) * (v(i,j,k+1) + v(i,j,k)) *
+                                    0.5 * (az(i,j,k+1) + az(i,j-1,k+1));
+            Real zflux_lo = 0.25 * (Omega(i,j,k  ) + Omega(i, j-1, k  )) * (v(i,j,k-1) + v(i,j,k)) *
+                                    0.5 * (az(i,j,k  ) + az(i,j-1,k  ));
+
+            Real mfsq = mf_v(i,j,0) * mf_v(i,j,0);
+
+            Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
+                              + (yflux_hi - yflux_lo) * dyInv * mfsq
+                              + (zflux_hi - zflux_lo) * dzInv;
+
+            rho_v_rhs(i, j, k) = -advectionSrc / (0.5 * (detJ(i,j,k) + detJ(i,j-1,k)));
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real met_h_zeta_xhi = Compute_h_zeta_AtEdgeCenterJ(i+1,j  ,k  ,cellSizeInv,z_nd);
+            Real xflux_hi = 0.25*(rho_u(i+1,j  ,k) + rho_u(i+1,j,k-1)) * mf_u_inv(i+1,j,0) *
+                                 (w(i+1,j,k) + w(i,j,k)) * met_h_zeta_xhi;
+
+            Real met_h_zeta_xlo = Compute_h_zeta_AtEdgeCenterJ(i  ,j  ,k  ,cellSizeInv,z_nd);
+            Real xflux_lo = 0.25*(rho_u(i  ,j  ,k) + rho_u(i  ,j,k-1)) * mf_u_inv(i  ,j,0) *
+                                 (w(i-1,j,k) + w(i,j,k)) * met_h_zeta_xlo;
+
+            Real met_h_zeta_yhi = Compute_h_zeta_AtEdgeCenterI(i  ,j+1,k  ,cellSizeInv,z_nd);
+            Real yflux_hi = 0.25*(rho_v(i,j+1,k) + rho_v(i,j+1,k-1)) * mf_v_inv(i,j+1,0) *
+                                 (w(i,j+1,k) + w(i,j,k)) * met_h_zeta_yhi;
+
+            Real met_h_zeta_ylo = Compute_h_zeta_AtEdgeCenterI(i  ,j  ,k  ,cellSizeInv,z_nd);
+            Real yflux_lo = 0.25*(rho_v(i,j  ,k) + rho_v(i,j  ,k-1)) * mf_v_inv(i,j  ,0) *
+                                 (w(i,j-1,k) + w(i,j,k)) * met_h_zeta_ylo;
+
+            Real zflux_lo = 0.25 * (Omega(i,j,k) + Omega(i,j,k-1)) * (w(i,j,k) + w(i,j,k-1));
+
+            Real zflux_hi = (k == hi_z_face) ? Omega(i,j,k) * w(i,j,k)  * az(i,j,k):
+                0.25 * (Omega(i,j,k) + Omega(i,j,k+1)) * (w(i,j,k) + w(i,j,k+1)) *
+                0.5  * (az(i,j,k) + az(i,j,k+1));
+
+            Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
+
+            Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
+                              + (yflux_hi - yflux_lo) * dyInv * mfsq
+                              + (zflux_hi - zflux_lo) * dzInv;
+
+            rho_w_rhs(i, j, k) = -advectionSrc / (0.5*(detJ(i,j,k) + detJ(i,j,k-1)));
+        });
+    // Template higher order methods
+    } else {
+        if (horiz_adv_type == AdvType::Centered_2nd) {
+            AdvectionSrcForMomVert<CENTERED2>(bxx, bxy, bxz,
+                                            rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                            rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
+                                            cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
+                                            horiz_upw_frac, vert_upw_frac,
+                                            vert_adv_type, lo_z_face, hi_z_face);
+        } else if (horiz_adv_type == AdvType::Upwind_3rd) {
+            AdvectionSrcForMomVert<UPWIND3>(bxx, bxy, bxz,
+                                            rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                            rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
+                                            cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
+                                            horiz_upw_frac, vert_upw_frac,
+                                            vert_adv_type, lo_z_face, hi_z_face);
+        } else if (horiz_adv_type == AdvType::Centered_4th) {
+            AdvectionSrcForMomVert<CENTERED4>(bxx, bxy, bxz,
+                                            rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                            rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
+                                            cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
+                                            horiz_upw_frac, vert_upw_frac,
+                                            vert_adv_type, lo_z_face, hi_z_face);
+        } else if (horiz_adv_type == AdvType::Upwind_5th) {
+            AdvectionSrcForMomVert<UPWIND5>(bxx, bxy, bxz,
+                                            rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                            rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
+                                            cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
+                                            horiz_upw_frac, vert_upw_frac,
+                                            vert_adv_type, lo_z_face, hi_z_face);
+        } else if (horiz_adv_type == AdvType::Centered_6th) {
+            AdvectionSrcForMomVert<CENTERED6>(bxx, bxy, bxz,
+                                            rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                            rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
+                                            cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
+                                            horiz_upw_frac, vert_upw_frac,
+                                            vert_adv_type, lo_z_face, hi_z_face);
+        } else {
+                AMREX_ASSERT_WITH_MESSAGE(false, "Unknown advection scheme!");
+        }
+    } // higher order
+}
+} // namespace
+
 /**
  * Function for computing the advective tendency for the momentum equations
  * This routine has explicit expressions for all cases (terrain or not) when
@@ -51,9 +226,9 @@ AdvectionSrcForMom (const Box& bx,
                     const Array4<const Real>& rho_v,
                     const Array4<const Real>& Omega,
                     const Array4<const Real>& z_nd,
-                    const Array4<const Real>& ax,
-                    const Array4<const Real>& ay,
-                    const Array4<const Real>& az,
+                    const MetricArray4& ax,
+                    const MetricArray4& ay,
+                    const MetricArray4& az,
                     const Array4<const Real>& detJ,
                     const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
                     const Array4<const Real>& mf_m,
@@ -93,7 +268,7 @@ AdvectionSrcForMom (const Box& bx,
     });
 
 #ifdef ERF_USE_EB
-    amrex::ignore_unused(use_terrain);
+    amrex::ignore_unused(use_terrain, dxInv, dyInv, dzInv);
 #else
     if (!use_terrain) {
         // Inline with 2nd order for efficiency
@@ -206,142 +381,24 @@ AdvectionSrcForMom (const Box& bx,
     else
 #endif
     { // now do use_terrain = true (or ERF_USE_EB)
-        // Inline with 2nd order for efficiency
-        if (horiz_adv_type == AdvType::Centered_2nd && vert_adv_type == AdvType::Centered_2nd)
-        {
-            ParallelFor(bxx, bxy, bxz,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                Real xflux_hi = 0.25 * (rho_u(i,j,k) * mf_u_inv(i,j,0) + rho_u(i+1,j,k) * mf_u_inv(i+1,j,0)) *
-                                       (u(i+1,j,k) + u(i,j,k)) * 0.5 * (ax(i,j,k) + ax(i+1,j,k));
-
-                Real xflux_lo = 0.25 * (rho_u(i,j,k) * mf_u_inv(i,j,0) + rho_u(i-1,j,k) * mf_u_inv(i-1,j,0)) *
-                                       (u(i-1,j,k) + u(i,j,k)) * 0.5 * (ax(i,j,k) + ax(i-1,j,k));
-
-                Real met_h_zeta_yhi = Compute_h_zeta_AtEdgeCenterK(i,j+1,k,cellSizeInv,z_nd);
-                Real yflux_hi = 0.25 * (rho_v(i,j+1,k)*mf_v_inv(i,j+1,0) + rho_v(i-1,j+1,k)*mf_v_inv(i-1,j+1,0)) *
-                                       (u(i,j+1,k) + u(i,j,k)) * met_h_zeta_yhi;
-
-                Real met_h_zeta_ylo = Compute_h_zeta_AtEdgeCenterK(i,j  ,k,cellSizeInv,z_nd);
-                Real yflux_lo = 0.25 * (rho_v(i,j  ,k)*mf_v_inv(i,j  ,0) + rho_v(i-1,j  ,k)*mf_v_inv(i-1,j  ,0)) *
-                                       (u(i,j-1,k) + u(i,j,k)) * met_h_zeta_ylo;
-
-                Real zflux_hi = 0.25 * (Omega(i,j,k+1) + Omega(i-1,j,k+1)) * (u(i,j,k+1) + u(i,j,k)) *
-                                        0.5 * (az(i,j,k+1) + az(i-1,j,k+1));
-                Real zflux_lo = 0.25 * (Omega(i,j,k  ) + Omega(i-1,j,k  )) * (u(i,j,k-1) + u(i,j,k)) *
-                                        0.5 * (az(i,j,k  ) + az(i-1,j,k  ));
-
-                Real mfsq = mf_u(i,j,0) * mf_u(i,j,0);
-
-                Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
-                                  + (yflux_hi - yflux_lo) * dyInv * mfsq
-                                  + (zflux_hi - zflux_lo) * dzInv;
-
-                rho_u_rhs(i, j, k) = -advectionSrc / (0.5 * (detJ(i,j,k) + detJ(i-1,j,k)));
-            },
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-
-                Real met_h_zeta_xhi = Compute_h_zeta_AtEdgeCenterK(i+1,j,k,cellSizeInv,z_nd);
-                Real xflux_hi = 0.25 * (rho_u(i+1,j,k)*mf_u_inv(i+1,j,0) + rho_u(i+1,j-1,k)*mf_u_inv(i+1,j-1,0)) *
-                                       (v(i+1,j,k) + v(i,j,k)) * met_h_zeta_xhi;
-
-                Real met_h_zeta_xlo = Compute_h_zeta_AtEdgeCenterK(i  ,j,k,cellSizeInv,z_nd);
-                Real xflux_lo = 0.25 * (rho_u(i, j, k)*mf_u_inv(i  ,j,0) + rho_u(i  ,j-1,k)*mf_u_inv(i-1,j  ,0)) *
-                                       (v(i-1,j,k) + v(i,j,k)) * met_h_zeta_xlo;
-
-                Real yflux_hi = 0.25 * (rho_v(i,j+1,k)*mf_v_inv(i,j+1,0) + rho_v(i,j  ,k) * mf_v_inv(i,j  ,0)) *
-                                       (v(i,j+1,k) + v(i,j,k)) * 0.5 * (ay(i,j,k) + ay(i,j+1,k));
-
-                Real yflux_lo = 0.25 * (rho_v(i,j  ,k)*mf_v_inv(i,j  ,0) + rho_v(i,j-1,k) * mf_v_inv(i,j-1,0)) *
-                                       (v(i,j-1,k) + v(i,j,k)) * 0.5 * (ay(i,j,k) + ay(i,j-1,k));
-
-                Real zflux_hi = 0.25 * (Omega(i,j,k+1) + Omega(i, j-1, k+1)) * (v(i,j,k+1) + v(i,j,k)) *
-                                        0.5 * (az(i,j,k+1) + az(i,j-1,k+1));
-                Real zflux_lo = 0.25 * (Omega(i,j,k  ) + Omega(i, j-1, k  )) * (v(i,j,k-1) + v(i,j,k)) *
-                                        0.5 * (az(i,j,k  ) + az(i,j-1,k  ));
-
-                Real mfsq = mf_v(i,j,0) * mf_v(i,j,0);
-
-                Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
-                                  + (yflux_hi - yflux_lo) * dyInv * mfsq
-                                  + (zflux_hi - zflux_lo) * dzInv;
-
-                rho_v_rhs(i, j, k) = -advectionSrc / (0.5 * (detJ(i,j,k) + detJ(i,j-1,k)));
-            },
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                Real met_h_zeta_xhi = Compute_h_zeta_AtEdgeCenterJ(i+1,j  ,k  ,cellSizeInv,z_nd);
-                Real xflux_hi = 0.25*(rho_u(i+1,j  ,k) + rho_u(i+1,j,k-1)) * mf_u_inv(i+1,j,0) *
-                                     (w(i+1,j,k) + w(i,j,k)) * met_h_zeta_xhi;
-
-                Real met_h_zeta_xlo = Compute_h_zeta_AtEdgeCenterJ(i  ,j  ,k  ,cellSizeInv,z_nd);
-                Real xflux_lo = 0.25*(rho_u(i  ,j  ,k) + rho_u(i  ,j,k-1)) * mf_u_inv(i  ,j,0) *
-                                     (w(i-1,j,k) + w(i,j,k)) * met_h_zeta_xlo;
-
-                Real met_h_zeta_yhi = Compute_h_zeta_AtEdgeCenterI(i  ,j+1,k  ,cellSizeInv,z_nd);
-                Real yflux_hi = 0.25*(rho_v(i,j+1,k) + rho_v(i,j+1,k-1)) * mf_v_inv(i,j+1,0) *
-                                     (w(i,j+1,k) + w(i,j,k)) * met_h_zeta_yhi;
-
-                Real met_h_zeta_ylo = Compute_h_zeta_AtEdgeCenterI(i  ,j  ,k  ,cellSizeInv,z_nd);
-                Real yflux_lo = 0.25*(rho_v(i,j  ,k) + rho_v(i,j  ,k-1)) * mf_v_inv(i,j  ,0) *
-                                     (w(i,j-1,k) + w(i,j,k)) * met_h_zeta_ylo;
-
-                Real zflux_lo = 0.25 * (Omega(i,j,k) + Omega(i,j,k-1)) * (w(i,j,k) + w(i,j,k-1));
-
-                Real zflux_hi = (k == hi_z_face) ? Omega(i,j,k) * w(i,j,k)  * az(i,j,k):
-                    0.25 * (Omega(i,j,k) + Omega(i,j,k+1)) * (w(i,j,k) + w(i,j,k+1)) *
-                    0.5  * (az(i,j,k) + az(i,j,k+1));
-
-                Real mfsq = mf_m(i,j,0) * mf_m(i,j,0);
-
-                Real advectionSrc = (xflux_hi - xflux_lo) * dxInv * mfsq
-                                  + (yflux_hi - yflux_lo) * dyInv * mfsq
-                                  + (zflux_hi - zflux_lo) * dzInv;
-
-                rho_w_rhs(i, j, k) = -advectionSrc / (0.5*(detJ(i,j,k) + detJ(i,j,k-1)));
-            });
-        // Template higher order methods
+        // Branch on the representation of the face areas once, outside the kernels
+        if (ax.compact) {
+            AdvectionSrcForMomTerrain(bxx, bxy, bxz, rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                      u, v, w, rho_u, rho_v, Omega,
+                                      z_nd, ax.cm, ay.cm, az.cm, detJ,
+                                      cellSizeInv, mf_m, mf_u, mf_v, mf_u_inv, mf_v_inv,
+                                      horiz_adv_type, vert_adv_type,
+                                      horiz_upw_frac, vert_upw_frac,
+                                      lo_z_face, hi_z_face);
         } else {
-            if (horiz_adv_type == AdvType::Centered_2nd) {
-                AdvectionSrcForMomVert<CENTERED2>(bxx, bxy, bxz,
-                                                rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                                rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
-                                                cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
-                                                horiz_upw_frac, vert_upw_frac,
-                                                vert_adv_type, lo_z_face, hi_z_face);
-            } else if (horiz_adv_type == AdvType::Upwind_3rd) {
-                AdvectionSrcForMomVert<UPWIND3>(bxx, bxy, bxz,
-                                                rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                                rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
-                                                cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
-                                                horiz_upw_frac, vert_upw_frac,
-                                                vert_adv_type, lo_z_face, hi_z_face);
-            } else if (horiz_adv_type == AdvType::Centered_4th) {
-                AdvectionSrcForMomVert<CENTERED4>(bxx, bxy, bxz,
-                                                rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                                rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
-                                                cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
-                                                horiz_upw_frac, vert_upw_frac,
-                                                vert_adv_type, lo_z_face, hi_z_face);
-            } else if (horiz_adv_type == AdvType::Upwind_5th) {
-                AdvectionSrcForMomVert<UPWIND5>(bxx, bxy, bxz,
-                                                rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                                rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
-                                                cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
-                                                horiz_upw_frac, vert_upw_frac,
-                                                vert_adv_type, lo_z_face, hi_z_face);
-            } else if (horiz_adv_type == AdvType::Centered_6th) {
-                AdvectionSrcForMomVert<CENTERED6>(bxx, bxy, bxz,
-                                                rho_u_rhs, rho_v_rhs, rho_w_rhs,
-                                                rho_u, rho_v, Omega, u, v, w, z_nd, ax, ay, az, detJ,
-                                                cellSizeInv, mf_m, mf_u_inv, mf_v_inv,
-                                                horiz_upw_frac, vert_upw_frac,
-                                                vert_adv_type, lo_z_face, hi_z_face);
-            } else {
-                    AMREX_ASSERT_WITH_MESSAGE(false, "Unknown advection scheme!");
-            }
-        } // higher order
+            AdvectionSrcForMomTerrain(bxx, bxy, bxz, rho_u_rhs, rho_v_rhs, rho_w_rhs,
+                                      u, v, w, rho_u, rho_v, Omega,
+                                      z_nd, ax.arr, ay.arr, az.arr, detJ,
+                                      cellSizeInv, mf_m, mf_u, mf_v, mf_u_inv, mf_v_inv,
+                                      horiz_adv_type, vert_adv_type,
+                                      horiz_upw_frac, vert_upw_frac,
+                                      lo_z_face, hi_z_face);
+        }
     } // terrain
 
     // Open bc will be imposed upon all vars (we only access cons here for simplicity)
@@ -2,53 +2,23 @@
 
 using namespace amrex;
 
-/** Compute advection tendencies for momentum normal to BC */
+namespace {
+// The kernels below are instantiated for the stored face areas (Array4) and for
+// CompactArea4; the public functions pick one per call, see MetricArray4
+template <typename AreaArr>
 void
-AdvectionSrcForOpenBC_Normal (const Box& bx,
-                              const int& dir,
-                              const Array4<      Real>& rhs_arr,
-                              const Array4<const Real>& vel_norm_arr,
-                              const Array4<const Real>& cell_data_arr,
-                              const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
-                              const bool do_lo)
-{
-    // NOTE: Klemp, J. B., and R. Wilhelmson, 1978: The simulation of three-dimensional
-    //       convective storm dynamics, J. Atmos. Sci., 35, 1070-1096.
-    // NOTE: Implementation is for the high bndry side. The low bndry side is obtained
-    //       by flipping sgn = -1.
-    // NOTE: Indices (i,j,k) correspond to data that is ON the open bdy.
-    int sgn = 1; if (do_lo) sgn = -1;
-    Real c_o_star = Real(sgn)*30.0;
-    ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-    {
-        IntVect ivu1(i,j,k); if ( do_lo) ivu1[dir] -= sgn; // Vel indexed into domain for do_lo
-        IntVect ivu2(i,j,k); if (!do_lo) ivu2[dir] -= sgn; // Vel indexed into domain for do_hi
-
-        IntVect ivr1(i,j,k); if (!do_lo) ivr1[dir] -= sgn; // Rho indexed into domain for do_hi
-        IntVect ivr2(i,j,k); if ( do_lo) ivr2[dir] += sgn; // Rho indexed out  domain for do_lo
-
-        Real rho_face  = 0.5 * ( cell_data_arr(ivr1,Rho_comp) + cell_data_arr(ivr2,Rho_comp) );
-        Real mom_star  = rho_face * Real(sgn) * max( Real(sgn)*(vel_norm_arr(ivu1) + c_o_star), 0.0 );
-        Real vel_grad  =  ( vel_norm_arr(ivu1) - vel_norm_arr(ivu2) ) * dxInv[dir];
-        Real flux      = -( mom_star * vel_grad );
-        rhs_arr(i,j,k) = flux;
-    });
-}
-
-/** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
-void
-AdvectionSrcForOpenBC_Tangent_Xmom (const Box& bxx,
-                                    const int& dir,
-                                    const Array4<      Real>& rho_u_rhs,
-                                    const Array4<const Real>& u,
-                                    const Array4<const Real>& rho_u,
-                                    const Array4<const Real>& rho_v,
-                                    const Array4<const Real>& Omega,
-                                    const Array4<const Real>& ax,
-                                    const Array4<const Real>& az,
-                                    const Array4<const Real>& detJ,
-                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                                    const bool do_lo)
+AdvectionSrcForOpenBC_Tangent_XmomImpl (const Box& bxx,
+                                        const int& dir,
+                                        const Array4<      Real>& rho_u_rhs,
+                                        const Array4<const Real>& u,
+                                        const Array4<const Real>& rho_u,
+                                        const Array4<const Real>& rho_v,
+                                        const Array4<const Real>& Omega,
+                                        const AreaArr& ax,
+                                        const AreaArr& az,
+                                        const Array4<const Real>& detJ,
+                                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                        const bool do_lo)
 {
     AMREX_ALWAYS_ASSERT(dir==1);
 
@@ -75,20 +45,20 @@ AdvectionSrcForOpenBC_Tangent_Xmom (const Box& bxx,
     });
 }
 
-/** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
+template <typename AreaArr>
 void
-AdvectionSrcForOpenBC_Tangent_Ymom (const Box& bxy,
-                                    const int& dir,
-                                    const Array4<      Real>& rho_v_rhs,
-                                    const Array4<const Real>& v,
-                                    const Array4<const Real>& rho_u,
-                                    const Array4<const Real>& rho_v,
-                                    const Array4<const Real>& Omega,
-                                    const Array4<const Real>& ay,
-                                    const Array4<const Real>& az,
-                                    const Array4<const Real>& detJ,
-                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                                    const bool do_lo)
+AdvectionSrcForOpenBC_Tangent_YmomImpl (const Box& bxy,
+                                        const int& dir,
+                                        const Array4<      Real>& rho_v_rhs,
+                                        const Array4<const Real>& v,
+                                        const Array4<const Real>& rho_u,
+                                        const Array4<const Real>& rho_v,
+                                        const Array4<const Real>& Omega,
+                                        const AreaArr& ay,
+                                        const AreaArr& az,
+                                        const Array4<const Real>& detJ,
+                                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                        const bool do_lo)
 {
     AMREX_ALWAYS_ASSERT(dir==0);
 
@@ -115,22 +85,22 @@ AdvectionSrcForOpenBC_Tangent_Ymom (const Box& bxy,
     });
 }
 
-/** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
+template <typename AreaArr>
 void
-AdvectionSrcForOpenBC_Tangent_Zmom (const Box& bxz,
-                                    const int& dir,
-                                    const Array4<      Real>& rho_w_rhs,
-                                    const Array4<const Real>& w,
-                                    const Array4<const Real>& rho_u,
-                                    const Array4<const Real>& rho_v,
-                                    const Array4<const Real>& Omega,
-                                    const Array4<const Real>& ax,
-                                    const Array4<const Real>& ay,
-                                    const Array4<const Real>& az,
-                                    const Array4<const Real>& detJ,
-                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                                    const int domhi_z,
-                                    const bool do_lo)
+AdvectionSrcForOpenBC_Tangent_ZmomImpl (const Box& bxz,
+                                        const int& dir,
+                                        const Array4<      Real>& rho_w_rhs,
+                                        const Array4<const Real>& w,
+                                        const Array4<const Real>& rho_u,
+                                        const Array4<const Real>& rho_v,
+                                        const Array4<const Real>& Omega,
+                                        const AreaArr& ax,
+                                        const AreaArr& ay,
+                                        const AreaArr& az,
+                                        const Array4<const Real>& detJ,
+                                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                        const int domhi_z,
+                                        const bool do_lo)
 {
     AMREX_ALWAYS_ASSERT(dir!=2);
 
@@ -174,6 +144,114 @@ AdvectionSrcForOpenBC_Tangent_Zmom (const Box& bxz,
         }
     });
 }
+} // namespace
+
+/** Compute advection tendencies for momentum normal to BC */
+void
+AdvectionSrcForOpenBC_Normal (const Box& bx,
+                              const int& dir,
+                              const Array4<      Real>& rhs_arr,
+                              const Array4<const Real>& vel_norm_arr,
+                              const Array4<const Real>& cell_data_arr,
+                              const GpuArray<Real, AMREX_SPACEDIM>& dxInv,
+                              const bool do_lo)
+{
+    // NOTE: Klemp, J. B., and R. Wilhelmson, 1978: The simulation of three-dimensional
+    //       convective storm dynamics, J. Atmos. Sci., 35, 1070-1096.
+    // NOTE: Implementation is for the high bndry side. The low bndry side is obtained
+    //       by flipping sgn = -1.
+    // NOTE: Indices (i,j,k) correspond to data that is ON the open bdy.
+    int sgn = 1; if (do_lo) sgn = -1;
+    Real c_o_star = Real(sgn)*30.0;
+    ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        IntVect ivu1(i,j,k); if ( do_lo) ivu1[dir] -= sgn; // Vel indexed into domain for do_lo
+        IntVect ivu2(i,j,k); if (!do_lo) ivu2[dir] -= sgn; // Vel indexed into domain for do_hi
+
+        IntVect ivr1(i,j,k); if (!do_lo) ivr1[dir] -= sgn; // Rho indexed into domain for do_hi
+        IntVect ivr2(i,j,k); if ( do_lo) ivr2[dir] += sgn; // Rho indexed out  domain for do_lo
+
+        Real rho_face  = 0.5 * ( cell_data_arr(ivr1,Rho_comp) + cell_data_arr(ivr2,Rho_comp) );
+        Real mom_star  = rho_face * Real(sgn) * max( Real(sgn)*(vel_norm_arr(ivu1) + c_o_star), 0.0 );
+        Real vel_grad  =  ( vel_norm_arr(ivu1) - vel_norm_arr(ivu2) ) * dxInv[dir];
+        Real flux      = -( mom_star * vel_grad );
+        rhs_arr(i,j,k) = flux;
+    });
+}
+
+/** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
+void
+AdvectionSrcForOpenBC_Tangent_Xmom (const Box& bxx,
+                                    const int& dir,
+                                    const Array4<      Real>& rho_u_rhs,
+                                    const Array4<const Real>& u,
+                                    const Array4<const Real>& rho_u,
+                                    const Array4<const Real>& rho_v,
+                                    const Array4<const Real>& Omega,
+                                    const MetricArray4& ax,
+                                    const MetricArray4& az,
+                                    const Array4<const Real>& detJ,
+                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                    const bool do_lo)
+{
+    if (ax.compact) {
+        AdvectionSrcForOpenBC_Tangent_XmomImpl(bxx, dir, rho_u_rhs, u, rho_u, rho_v, Omega,
+                                               ax.cm, az.cm, detJ, cellSizeInv, do_lo);
+    } else {
+        AdvectionSrcForOpenBC_Tangent_XmomImpl(bxx, dir, rho_u_rhs, u, rho_u, rho_v, Omega,
+                                               ax.arr, az.arr, detJ, cellSizeInv, do_lo);
+    }
+}
+
+/** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
+void
+AdvectionSrcForOpenBC_Tangent_Ymom (const Box& bxy,
+                                    const int& dir,
+                                    const Array4<      Real>& rho_v_rhs,
+                                    const Array4<const Real>& v,
+                                    const Array4<const Real>& rho_u,
+                                    const Array4<const Real>& rho_v,
+                                    const Array4<const Real>& Omega,
+                                    const MetricArray4& ay,
+                                    const MetricArray4& az,
+                                    const Array4<const Real>& detJ,
+                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                    const bool do_lo)
+{
+    if (ay.compact) {
+        AdvectionSrcForOpenBC_Tangent_YmomImpl(bxy, dir, rho_v_rhs, v, rho_u, rho_v, Omega,
+                                               ay.cm, az.cm, detJ, cellSizeInv, do_lo);
+    } else {
+        AdvectionSrcForOpenBC_Tangent_YmomImpl(bxy, dir, rho_v_rhs, v, rho_u, rho_v, Omega,
+                                               ay.arr, az.arr, detJ, cellSizeInv, do_lo);
+    }
+}
+
+/** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
+void
+AdvectionSrcForOpenBC_Tangent_Zmom (const Box& bxz,
+                                    const int& dir,
+                                    const Array4<      Real>& rho_w_rhs,
+                                    const Array4<const Real>& w,
+                                    const Array4<const Real>& rho_u,
+                                    const Array4<const Real>& rho_v,
+                                    const Array4<const Real>& Omega,
+                                    const MetricArray4& ax,
+                                    const MetricArray4& ay,
+                                    const MetricArray4& az,
+                                    const Array4<const Real>& detJ,
+                                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                                    const int domhi_z,
+                                    const bool do_lo)
+{
+    if (ax.compact) {
+        AdvectionSrcForOpenBC_Tangent_ZmomImpl(bxz, dir, rho_w_rhs, w, rho_u, rho_v, Omega,
+                                               ax.cm, ay.cm, az.cm, detJ, cellSizeInv, domhi_z, do_lo);
+    } else {
+        AdvectionSrcForOpenBC_Tangent_ZmomImpl(bxz, dir, rho_w_rhs, w, rho_u, rho_v, Omega,
+                                               ax.arr, ay.arr, az.arr, detJ, cellSizeInv, domhi_z, do_lo);
+    }
+}
 
 /** Compute advection tendencies for x momentum tangential to BC (2nd order)*/
 void
@@ -5,46 +5,29 @@
 
 using namespace amrex;
 
-/**
- * Function for computing the advective tendency for the update equations for rho and (rho theta)
- * This routine has explicit expressions for all cases (terrain or not) when
- * the horizontal and vertical spatial orders are <= 2, and calls more specialized
- * functions when either (or both) spatial order(s) is greater than 2.
- *
- * @param[in] bx box over which the scalars are updated
- * @param[out] advectionSrc tendency for the scalar update equation
- * @param[in] rho_u x-component of momentum
- * @param[in] rho_v y-component of momentum
- * @param[in] Omega component of momentum normal to the z-coordinate surface
- * @param[out] avg_xmom x-component of time-averaged momentum defined in this routine
- * @param[out] avg_ymom y-component of time-averaged momentum defined in this routine
- * @param[out] avg_zmom z-component of time-averaged momentum defined in this routine
- * @param[in] detJ Jacobian of the metric transformation (= 1 if use_terrain is false)
- * @param[in] cellSizeInv inverse of the mesh spacing
- * @param[in] mf_m map factor at cell centers
- * @param[in] mf_u map factor at x-faces
- * @param[in] mf_v map factor at y-faces
- */
-
+namespace {
+// The kernels below are instantiated for the stored face areas (Array4) and for
+// CompactArea4; the public functions pick one per call, see MetricArray4
+template <typename AreaArr>
 void
-AdvectionSrcForRho (const Box& bx,
-                    const Array4<Real>& advectionSrc,
-                    const Array4<const Real>& rho_u,
-                    const Array4<const Real>& rho_v,
-                    const Array4<const Real>& Omega,
-                    const Array4<      Real>& avg_xmom,
-                    const Array4<      Real>& avg_ymom,
-                    const Array4<      Real>& avg_zmom,
-                    const Array4<const Real>& ax_arr,
-                    const Array4<const Real>& ay_arr,
-                    const Array4<const Real>& az_arr,
-                    const Array4<const Real>& detJ,
-                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                    const Array4<const Real>& mf_m,
-                    const Array4<const Real>& mf_u,
-                    const Array4<const Real>& mf_v,
-                    const GpuArray<const Array4<Real>, AMREX_SPACEDIM>& flx_arr,
-                    const bool const_rho)
+AdvectionSrcForRhoImpl (const Box& bx,
+                        const Array4<Real>& advectionSrc,
+                        const Array4<const Real>& rho_u,
+                        const Array4<const Real>& rho_v,
+                        const Array4<const Real>& Omega,
+                        const Array4<      Real>& avg_xmom,
+                        const Array4<      Real>& avg_ymom,
+                        const Array4<      Real>& avg_zmom,
+                        const AreaArr& ax_arr,
+                        const AreaArr& ay_arr,
+                        const AreaArr& az_arr,
+                        const Array4<const Real>& detJ,
+                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                        const Array4<const Real>& mf_m,
+                        const Array4<const Real>& mf_u,
+                        const Array4<const Real>& mf_v,
+                        const GpuArray<const Array4<Real>, AMREX_SPACEDIM>& flx_arr,
+                        const bool const_rho)
 {
     BL_PROFILE_VAR("AdvectionSrcForRho", AdvectionSrcForRho);
     auto dxInv = cellSizeInv[0], dyInv = cellSizeInv[1], dzInv = cellSizeInv[2];
@@ -91,6 +74,59 @@ AdvectionSrcForRho (const Box& bx,
         });
     }
 }
+} // namespace
+
+/**
+ * Function for computing the advective tendency for the update equations for rho and (rho theta)
+ * This routine has explicit expressions for all cases (terrain or not) when
+ * the horizontal and vertical spatial orders are <= 2, and calls more specialized
+ * functions when either (or both) spatial order(s) is greater than 2.
+ *
+ * @param[in] bx box over which the scalars are updated
+ * @param[out] advectionSrc tendency for the scalar update equation
+ * @param[in] rho_u x-component of momentum
+ * @param[in] rho_v y-component of momentum
+ * @param[in] Omega component of momentum normal to the z-coordinate surface
+ * @param[out] avg_xmom x-component of time-averaged momentum defined in this routine
+ * @param[out] avg_ymom y-component of time-averaged momentum defined in this routine
+ * @param[out] avg_zmom z-component of time-averaged momentum defined in this routine
+ * @param[in] detJ Jacobian of the metric transformation (= 1 if use_terrain is false)
+ * @param[in] cellSizeInv inverse of the mesh spacing
+ * @param[in] mf_m map factor at cell centers
+ * @param[in] mf_u map factor at x-faces
+ * @param[in] mf_v map factor at y-faces
+ */
+
+void
+AdvectionSrcForRho (const Box& bx,
+                    const Array4<Real>& advectionSrc,
+                    const Array4<const Real>& rho_u,
+                    const Array4<const Real>& rho_v,
+                    const Array4<const Real>& Omega,
+                    const Array4<      Real>& avg_xmom,
+                    const Array4<      Real>& avg_ymom,
+                    const Array4<      Real>& avg_zmom,
+                    const MetricArray4& ax_arr,
+                    const MetricArray4& ay_arr,
+                    const MetricArray4& az_arr,
+                    const Array4<const Real>& detJ,
+                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                    const Array4<const Real>& mf_m,
+                    const Array4<const Real>& mf_u,
+                    const Array4<const Real>& mf_v,
+                    const GpuArray<const Array4<Real>, AMREX_SPACEDIM>& flx_arr,
+                    const bool const_rho)
+{
+    if (ax_arr.compact) {
+        AdvectionSrcForRhoImpl(bx, advectionSrc, rho_u, rho_v, Omega, avg_xmom, avg_ymom, avg_zmom,
+                               ax_arr.cm, ay_arr.cm, az_arr.cm, detJ, cellSizeInv, mf_m, mf_u,
+                               mf_v, flx_arr, const_rho);
+    } else {
+        AdvectionSrcForRhoImpl(bx, advectionSrc, rho_u, rho_v, Omega, avg_xmom, avg_ymom, avg_zmom,
+                               ax_arr.arr, ay_arr.arr, az_arr.arr, detJ, cellSizeInv, mf_m, mf_u,
+                               mf_v, flx_arr, const_rho);
+    }
+}
 
 /**
  * Function for computing the advective tendency for the update equations for all scalars other than rho and (rho theta)
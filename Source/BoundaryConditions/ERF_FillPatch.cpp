@@ -25,6 +25,58 @@ ERF::FillPatch (int lev, Real time,
                 bool fillset, bool cons_only)
 {
     BL_PROFILE_VAR("ERF::FillPatch()",ERF_FillPatch);
+    FillPatchBegin(lev, time, mfs_vel, mfs_mom, fillset, cons_only);
+    FillPatchEnd  (lev, time, mfs_vel, cons_only);
+}
+
+/*
+ * Is filling these MultiFabs only an exchange of ghost cells between the grids of the level
+ * (plus the physical bcs)?  This is the case at level 0 when they hold the stored state at
+ * its own time, as at the start of a time step.
+ *
+ * @param[in] lev       level of refinement at which to fill the data
+ * @param[in] time      time at which the data should be filled
+ * @param[in] mfs_vel   Vector of MultiFabs to be filled containing, in order: cons, xvel, yvel, and zvel
+ * @param[in] cons_only if true then only the conserved variables are filled
+ */
+bool
+ERF::FillPatchExchangeOnly (int lev, Real time, const Vector<MultiFab*>& mfs_vel, bool cons_only)
+{
+    if (lev > 0) return false;
+
+    Real teps = (t_new[lev] - t_old[lev]) * 1.e-3;
+    bool at_old = (std::abs(time - t_old[lev]) <= teps);
+    bool at_new = (std::abs(time - t_new[lev]) <= teps);
+
+    for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+        if (cons_only && var_idx != Vars::cons) continue;
+        bool is_old = (mfs_vel[var_idx] == &vars_old[lev][var_idx]) && at_old;
+        bool is_new = (mfs_vel[var_idx] == &vars_new[lev][var_idx]) && at_new;
+        if (!is_old && !is_new) return false;
+    }
+    return true;
+}
+
+/*
+ * First half of FillPatch: fills the ghost data from the coarser level and starts the
+ * exchange of ghost data between the grids of the level. When this exchange is all that
+ * is needed (see FillPatchExchangeOnly), it is left in flight so that cells whose stencil
+ * stays within their grid can be computed before FillPatchEnd completes the fill and
+ * imposes the physical bcs.
+ *
+ * @param[in] lev  level of refinement at which to fill the data
+ * @param[in] time time at which the data should be filled
+ * @param[out] mfs_vel Vector of MultiFabs to be filled containing, in order: cons, xvel, yvel, and zvel
+ * @param[out] mfs_mom Vector of MultiFabs to be filled containing, in order: cons, xmom, ymom, and zmom
+ * @return true if the exchange of ghost data is still in flight
+ */
+bool
+ERF::FillPatchBegin (int lev, Real time,
+                     const Vector<MultiFab*>& mfs_vel,     // This includes cc quantities and VELOCITIES
+                     const Vector<MultiFab*>& mfs_mom,     // This includes cc quantities and MOMENTA
+                     bool fillset, bool cons_only)
+{
+    BL_PROFILE_VAR("ERF::FillPatchBegin()",ERF_FillPatchBegin);
     Interpolater* mapper = nullptr;
 
     //
@@ -78,10 +130,17 @@ ERF::FillPatch (int lev, Real time,
         }
     }
 
-    IntVect ngvect_cons = mfs_vel[Vars::cons]->nGrowVect();
     IntVect ngvect_vels = mfs_vel[Vars::xvel]->nGrowVect();
 
-    if (lev == 0)
+    if (FillPatchExchangeOnly(lev, time, mfs_vel, cons_only))
+    {
+        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+            if (cons_only && var_idx != Vars::cons) continue;
+            mfs_vel[var_idx]->FillBoundary_nowait(geom[lev].periodicity());
+        }
+        return true;
+    }
+    else if (lev == 0)
     {
         const int icomp = 0;
 
@@ -165,6 +224,45 @@ ERF::FillPatch (int lev, Real time,
         } // !cons_only
     } // lev > 0
 
+    return false;
+}
+
+/*
+ * Second half of FillPatch: completes the exchange of ghost data started by FillPatchBegin
+ * and imposes the physical bcs
+ *
+ * @param[in] lev  level of refinement at which to fill the data
+ * @param[in] time time at which the data should be filled
+ * @param[out] mfs_vel Vector of MultiFabs to be filled containing, in order: cons, xvel, yvel, and zvel
+ */
+void
+ERF::FillPatchEnd (int lev, Real time, const Vector<MultiFab*>& mfs_vel, bool cons_only)
+{
+    BL_PROFILE_VAR("ERF::FillPatchEnd()",ERF_FillPatchEnd);
+
+    if (FillPatchExchangeOnly(lev, time, mfs_vel, cons_only)) {
+        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+            if (cons_only && var_idx != Vars::cons) continue;
+            mfs_vel[var_idx]->FillBoundary_finish();
+        }
+    }
+
+    FillPatchDomainBCs(lev, time, mfs_vel, cons_only);
+}
+
+/*
+ * Impose the physical bcs on the data filled by FillPatch
+ *
+ * @param[in] lev  level of refinement at which to fill the data
+ * @param[in] time time at which the data should be filled
+ * @param[out] mfs_vel Vector of MultiFabs to be filled containing, in order: cons, xvel, yvel, and zvel
+ */
+void
+ERF::FillPatchDomainBCs (int lev, Real time, const Vector<MultiFab*>& mfs_vel, bool cons_only)
+{
+    IntVect ngvect_cons = mfs_vel[Vars::cons]->nGrowVect();
+    IntVect ngvect_vels = mfs_vel[Vars::xvel]->nGrowVect();
+
     // ***************************************************************************
     // Physical bc's at domain boundary
     // ***************************************************************************
@@ -31,7 +31,7 @@ using namespace amrex;
  */
 void ComputeTurbulentViscosityLES (const MultiFab& Tau11, const MultiFab& Tau22, const MultiFab& Tau33,
                                    const MultiFab& Tau12, const MultiFab& Tau13, const MultiFab& Tau23,
-                                   const MultiFab& cons_in, MultiFab& eddyViscosity,
+                                   const MultiFab& cons_in, AuxMultiFab& eddyViscosity,
                                    MultiFab& Hfx1, MultiFab& Hfx2, MultiFab& Hfx3, MultiFab& Diss,
                                    const Geometry& geom,
                                    const MultiFab& mapfac_u, const MultiFab& mapfac_v,
@@ -64,7 +64,7 @@ void ComputeTurbulentViscosityLES (const MultiFab& Tau11, const MultiFab& Tau22,
           //       have been filled from FP Two Levels.
           Box bxcc  = mfi.growntilebox(1) & domain;
 
-          const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
+          const Array4<AuxReal>& mu_turb = eddyViscosity.array(mfi);
           const Array4<Real>& hfx_x   = Hfx1.array(mfi);
           const Array4<Real>& hfx_y   = Hfx2.array(mfi);
           const Array4<Real>& hfx_z   = Hfx3.array(mfi);
@@ -144,7 +144,7 @@ void ComputeTurbulentViscosityLES (const MultiFab& Tau11, const MultiFab& Tau22,
         {
             Box bxcc  = mfi.tilebox();
 
-            const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
+            const Array4<AuxReal>& mu_turb = eddyViscosity.array(mfi);
             const Array4<Real>& hfx_x   = Hfx1.array(mfi);
             const Array4<Real>& hfx_y   = Hfx2.array(mfi);
             const Array4<Real>& hfx_z   = Hfx3.array(mfi);
@@ -252,7 +252,7 @@ void ComputeTurbulentViscosityLES (const MultiFab& Tau11, const MultiFab& Tau22,
         bxcc.growLo(0,ngc); bxcc.growHi(0,ngc);
         bxcc.growLo(1,ngc); bxcc.growHi(1,ngc);
 
-        const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
+        const Array4<AuxReal>& mu_turb = eddyViscosity.array(mfi);
 
         // Extrapolate outside the domain in lateral directions (planex owns corner cells)
         if (i_lo == domain.smallEnd(0)) {
@@ -383,7 +383,7 @@ void ComputeTurbulentViscosityLES (const MultiFab& Tau11, const MultiFab& Tau22,
         planez.growLo(0,ngc); planez.growHi(0,ngc);
         planez.growLo(1,ngc); planez.growHi(1,ngc);
 
-        const Array4<Real>& mu_turb = eddyViscosity.array(mfi);
+        const Array4<AuxReal>& mu_turb = eddyViscosity.array(mfi);
 
         for (auto n = 0; n < (EddyDiff::NumDiffs-1)/2; ++n) {
             int offset = (EddyDiff::NumDiffs-1)/2;
@@ -460,7 +460,7 @@ void ComputeTurbulentViscosity (const MultiFab& xvel , const MultiFab& yvel ,
                                 const MultiFab& Tau11, const MultiFab& Tau22, const MultiFab& Tau33,
                                 const MultiFab& Tau12, const MultiFab& Tau13, const MultiFab& Tau23,
                                 const MultiFab& cons_in,
-                                MultiFab& eddyViscosity,
+                                AuxMultiFab& eddyViscosity,
                                 MultiFab& Hfx1, MultiFab& Hfx2, MultiFab& Hfx3, MultiFab& Diss,
                                 const Geometry& geom,
                                 const MultiFab& mapfac_u, const MultiFab& mapfac_v,
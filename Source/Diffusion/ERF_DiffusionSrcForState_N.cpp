@@ -49,7 +49,7 @@ DiffusionSrcForState_N (const Box& bx, const Box& domain,
                         const Array4<Real>& yflux,
                         const Array4<Real>& zflux,
                         const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                        const Array4<const Real>& SmnSmn_a,
+                        const Array4<const AuxReal>& SmnSmn_a,
                         const Array4<const Real>& mf_m,
                         const Array4<const Real>& mf_u,
                         const Array4<const Real>& mf_v,
@@ -57,7 +57,7 @@ DiffusionSrcForState_N (const Box& bx, const Box& domain,
                               Array4<      Real>& qfx1_z,
                               Array4<      Real>& qfx2_z,
                               Array4<      Real>& diss,
-                        const Array4<const Real>& mu_turb,
+                        const Array4<const AuxReal>& mu_turb,
                         const SolverChoice &solverChoice,
                         const int level,
                         const Array4<const Real>& tm_arr,
@@ -193,6 +193,10 @@ DiffusionSrcForState_N (const Box& bx, const Box& domain,
     int*  d_eddy_diff_idy = eddy_diff_idy_d.data();
     int*  d_eddy_diff_idz = eddy_diff_idz_d.data();
 
+    // Only the explicit share of the vertical eddy diffusivity is applied on interior
+    // z-faces; the remainder is handled by the vertically implicit diffusion stage
+    const Real vert_expl_fac = 1.0 - diffChoice.vert_implicit_fac;
+
     // Compute fluxes at each face
     if (l_consA && l_turb) {
         ParallelFor(xbx, num_comp,[=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
@@ -273,8 +277,9 @@ DiffusionSrcForState_N (const Box& bx, const Box& domain,
 
             Real rhoFace  = 0.5 * ( cell_data(i, j, k, Rho_comp) + cell_data(i, j, k-1, Rho_comp) );
             Real rhoAlpha = rhoFace * d_alpha_eff[prim_scal_index];
-            rhoAlpha += 0.5 * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_scal_index])
-                              + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_scal_index]) );
+            const Real mu_fac = (k > dom_lo.z && k <= dom_hi.z) ? vert_expl_fac : 1.0;
+            rhoAlpha += 0.5 * mu_fac * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_scal_index])
+                                       + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_scal_index]) );
 
             int bc_comp = (qty_index >= RhoScalar_comp && qty_index < RhoScalar_comp+NSCALARS) ?
                            BCVars::RhoScalar_bc_comp : qty_index;
@@ -387,8 +392,9 @@ DiffusionSrcForState_N (const Box& bx, const Box& domain,
             const int prim_index = qty_index - 1;
 
             Real rhoAlpha = d_alpha_eff[prim_index];
-            rhoAlpha += 0.5 * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_index])
-                              + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_index]) );
+            const Real mu_fac = (k > dom_lo.z && k <= dom_hi.z) ? vert_expl_fac : 1.0;
+            rhoAlpha += 0.5 * mu_fac * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_index])
+                                       + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_index]) );
 
             int bc_comp = (qty_index >= RhoScalar_comp && qty_index < RhoScalar_comp+NSCALARS) ?
                            BCVars::RhoScalar_bc_comp : qty_index;
@@ -5,78 +5,48 @@
 
 using namespace amrex;
 
-/**
- * Function for computing the scalar RHS for diffusion operator without terrain.
- *
- * @param[in]  bx cell center box to loop over
- * @param[in]  domain box of the whole domain
- * @param[in]  start_comp starting component index
- * @param[in]  num_comp number of components
- * @param[in]  u velocity in x-dir
- * @param[in]  v velocity in y-dir
- * @param[in]  cell_data conserved cell center vars
- * @param[in]  cell_prim primitive cell center vars
- * @param[out] cell_rhs RHS for cell center vars
- * @param[in]  xflux flux in x-dir
- * @param[in]  yflux flux in y-dir
- * @param[in]  zflux flux in z-dir
- * @param[in]  z_nd physical z height
- * @param[in]  detJ Jacobian determinant
- * @param[in]  cellSizeInv inverse cell size array
- * @param[in]  SmnSmn_a strain rate magnitude
- * @param[in]  mf_m map factor at cell center
- * @param[in]  mf_u map factor at x-face
- * @param[in]  mf_v map factor at y-face
- * @param[inout]  hfx_z heat flux in z-dir
- * @param[inout]  qfx1_z heat flux in z-dir
- * @param[out]    qfx2_z heat flux in z-dir
- * @param[in]  diss dissipation of TKE
- * @param[in]  mu_turb turbulent viscosity
- * @param[in]  diffChoice container of diffusion parameters
- * @param[in]  turbChoice container of turbulence parameters
- * @param[in]  tm_arr theta mean array
- * @param[in]  grav_gpu gravity vector
- * @param[in]  bc_ptr container with boundary conditions
- * @param[in]  use_most whether we have turned on MOST BCs
- */
+namespace {
+// The kernels below are instantiated for the stored face areas (Array4) and for
+// CompactArea4; the public functions pick one per call, see MetricArray4
+template <typename AreaArr>
 void
-DiffusionSrcForState_T (const Box& bx, const Box& domain,
-                        int start_comp, int num_comp,
-                        const bool& exp_most,
-                        const bool& rot_most,
-                        const Array4<const Real>& u,
-                        const Array4<const Real>& v,
-                        const Array4<const Real>& cell_data,
-                        const Array4<const Real>& cell_prim,
-                        const Array4<Real>& cell_rhs,
-                        const Array4<Real>& xflux,
-                        const Array4<Real>& yflux,
-                        const Array4<Real>& zflux,
-                        const Array4<const Real>& z_nd,
-                        const Array4<const Real>& ax,
-                        const Array4<const Real>& ay,
-                        const Array4<const Real>& az,
-                        const Array4<const Real>& detJ,
-                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
-                        const Array4<const Real>& SmnSmn_a,
-                        const Array4<const Real>& mf_m,
-                        const Array4<const Real>& mf_u,
-                        const Array4<const Real>& mf_v,
-                              Array4<      Real>& hfx_x,
-                              Array4<      Real>& hfx_y,
-                              Array4<      Real>& hfx_z,
-                              Array4<      Real>& qfx1_x,
-                              Array4<      Real>& qfx1_y,
-                              Array4<      Real>& qfx1_z,
-                              Array4<      Real>& qfx2_z,
-                              Array4<      Real>& diss,
-                        const Array4<const Real>& mu_turb,
-                        const SolverChoice &solverChoice,
-                        const int level,
-                        const Array4<const Real>& tm_arr,
-                        const GpuArray<Real,AMREX_SPACEDIM> grav_gpu,
-                        const BCRec* bc_ptr,
-                        const bool use_most)
+DiffusionSrcForState_TImpl (const Box& bx, const Box& domain,
+                            int start_comp, int num_comp,
+                            const bool& exp_most,
+                            const bool& rot_most,
+                            const Array4<const Real>& u,
+                            const Array4<const Real>& v,
+                            const Array4<const Real>& cell_data,
+                            const Array4<const Real>& cell_prim,
+                            const Array4<Real>& cell_rhs,
+                            const Array4<Real>& xflux,
+                            const Array4<Real>& yflux,
+                            const Array4<Real>& zflux,
+                            const Array4<const Real>& z_nd,
+                            const AreaArr& ax,
+                            const AreaArr& ay,
+                            const AreaArr& az,
+                            const Array4<const Real>& detJ,
+                            const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                            const Array4<const AuxReal>& SmnSmn_a,
+                            const Array4<const Real>& mf_m,
+                            const Array4<const Real>& mf_u,
+                            const Array4<const Real>& mf_v,
+                                  Array4<      Real>& hfx_x,
+                                  Array4<      Real>& hfx_y,
+                                  Array4<      Real>& hfx_z,
+                                  Array4<      Real>& qfx1_x,
+                                  Array4<      Real>& qfx1_y,
+                                  Array4<      Real>& qfx1_z,
+                                  Array4<      Real>& qfx2_z,
+                                  Array4<      Real>& diss,
+                            const Array4<const AuxReal>& mu_turb,
+                            const SolverChoice &solverChoice,
+                            const int level,
+                            const Array4<const Real>& tm_arr,
+                            const GpuArray<Real,AMREX_SPACEDIM> grav_gpu,
+                            const BCRec* bc_ptr,
+                            const bool use_most)
 {
     BL_PROFILE_VAR("DiffusionSrcForState_T()",DiffusionSrcForState_T);
 
@@ -89,6 +59,7 @@ DiffusionSrcForState_T (const Box& bx, const Box& domain,
     const Real dy_inv = cellSizeInv[1];
     const Real dz_inv = cellSizeInv[2];
 
+    const auto& dom_lo = lbound(domain);
     const auto& dom_hi = ubound(domain);
 
     bool l_use_QKE       = turbChoice.use_QKE;
@@ -206,6 +177,10 @@ DiffusionSrcForState_T (const Box& bx, const Box& domain,
     int*  d_eddy_diff_idy = eddy_diff_idy_d.data();
     int*  d_eddy_diff_idz = eddy_diff_idz_d.data();
 
+    // Only the explicit share of the vertical eddy diffusivity is applied on interior
+    // z-faces; the remainder is handled by the vertically implicit diffusion stage
+    const Real vert_expl_fac = 1.0 - diffChoice.vert_implicit_fac;
+
     // Constant alpha & Turb model
     if (l_consA && l_turb) {
         ParallelFor(xbx, num_comp,[=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
@@ -281,8 +256,9 @@ DiffusionSrcForState_T (const Box& bx, const Box& domain,
 
             Real rhoFace  = 0.5 * ( cell_data(i, j, k, Rho_comp) + cell_data(i, j, k-1, Rho_comp) );
             Real rhoAlpha = rhoFace * d_alpha_eff[prim_scal_index];
-            rhoAlpha += 0.5 * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_scal_index])
-                              + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_scal_index]) );
+            const Real mu_fac = (k > dom_lo.z && k <= dom_hi.z) ? vert_expl_fac : 1.0;
+            rhoAlpha += 0.5 * mu_fac * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_scal_index])
+                                       + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_scal_index]) );
 
             Real met_h_zeta = az(i,j,k);
 
@@ -401,8 +377,9 @@ DiffusionSrcForState_T (const Box& bx, const Box& domain,
 
             Real rhoAlpha = d_alpha_eff[prim_index];
 
-            rhoAlpha += 0.5 * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_index])
-                              + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_index]) );
+            const Real mu_fac = (k > dom_lo.z && k <= dom_hi.z) ? vert_expl_fac : 1.0;
+            rhoAlpha += 0.5 * mu_fac * ( mu_turb(i, j, k  , d_eddy_diff_idz[prim_index])
+                                       + mu_turb(i, j, k-1, d_eddy_diff_idz[prim_index]) );
 
             Real met_h_zeta = az(i,j,k);
 
@@ -847,3 +824,94 @@ DiffusionSrcForState_T (const Box& bx, const Box& domain,
         });
     }
 }
+} // namespace
+
+/**
+ * Function for computing the scalar RHS for diffusion operator without terrain.
+ *
+ * @param[in]  bx cell center box to loop over
+ * @param[in]  domain box of the whole domain
+ * @param[in]  start_comp starting component index
+ * @param[in]  num_comp number of components
+ * @param[in]  u velocity in x-dir
+ * @param[in]  v velocity in y-dir
+ * @param[in]  cell_data conserved cell center vars
+ * @param[in]  cell_prim primitive cell center vars
+ * @param[out] cell_rhs RHS for cell center vars
+ * @param[in]  xflux flux in x-dir
+ * @param[in]  yflux flux in y-dir
+ * @param[in]  zflux flux in z-dir
+ * @param[in]  z_nd physical z height
+ * @param[in]  detJ Jacobian determinant
+ * @param[in]  cellSizeInv inverse cell size array
+ * @param[in]  SmnSmn_a strain rate magnitude
+ * @param[in]  mf_m map factor at cell center
+ * @param[in]  mf_u map factor at x-face
+ * @param[in]  mf_v map factor at y-face
+ * @param[inout]  hfx_z heat flux in z-dir
+ * @param[inout]  qfx1_z heat flux in z-dir
+ * @param[out]    qfx2_z heat flux in z-dir
+ * @param[in]  diss dissipation of TKE
+ * @param[in]  mu_turb turbulent viscosity
+ * @param[in]  diffChoice container of diffusion parameters
+ * @param[in]  turbChoice container of turbulence parameters
+ * @param[in]  tm_arr theta mean array
+ * @param[in]  grav_gpu gravity vector
+ * @param[in]  bc_ptr container with boundary conditions
+ * @param[in]  use_most whether we have turned on MOST BCs
+ */
+void
+DiffusionSrcForState_T (const Box& bx, const Box& domain,
+                        int start_comp, int num_comp,
+                        const bool& exp_most,
+                        const bool& rot_most,
+                        const Array4<const Real>& u,
+                        const Array4<const Real>& v,
+                        const Array4<const Real>& cell_data,
+                        const Array4<const Real>& cell_prim,
+                        const Array4<Real>& cell_rhs,
+                        const Array4<Real>& xflux,
+                        const Array4<Real>& yflux,
+                        const Array4<Real>& zflux,
+                        const Array4<const Real>& z_nd,
+                        const MetricArray4& ax,
+                        const MetricArray4& ay,
+                        const MetricArray4& az,
+                        const Array4<const Real>& detJ,
+                        const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                        const Array4<const AuxReal>& SmnSmn_a,
+                        const Array4<const Real>& mf_m,
+                        const Array4<const Real>& mf_u,
+                        const Array4<const Real>& mf_v,
+                              Array4<      Real>& hfx_x,
+                              Array4<      Real>& hfx_y,
+                              Array4<      Real>& hfx_z,
+                              Array4<      Real>& qfx1_x,
+                              Array4<      Real>& qfx1_y,
+                              Array4<      Real>& qfx1_z,
+                              Array4<      Real>& qfx2_z,
+                              Array4<      Real>& diss,
+                        const Array4<const AuxReal>& mu_turb,
+                        const SolverChoice &solverChoice,
+                        const int level,
+                        const Array4<const Real>& tm_arr,
+                        const GpuArray<Real,AMREX_SPACEDIM> grav_gpu,
+                        const BCRec* bc_ptr,
+                        const bool use_most)
+{
+    if (ax.compact) {
+        DiffusionSrcForState_TImpl(bx, domain, start_comp, num_comp, exp_most, rot_most, u, v,
+                                   cell_data, cell_prim, cell_rhs, xflux, yflux, zflux, z_nd,
+                                   ax.cm, ay.cm, az.cm, detJ, cellSizeInv, SmnSmn_a, mf_m, mf_u,
+                                   mf_v, hfx_x, hfx_y, hfx_z, qfx1_x, qfx1_y, qfx1_z, qfx2_z, diss,
+                                   mu_turb, solverChoice, level, tm_arr, grav_gpu, bc_ptr,
+                                   use_most);
+    } else {
+        DiffusionSrcForState_TImpl(bx, domain, start_comp, num_comp, exp_most, rot_most, u, v,
+                                   cell_data, cell_prim, cell_rhs, xflux, yflux, zflux, z_nd,
+                                   ax.arr, ay.arr, az.arr, detJ, cellSizeInv, SmnSmn_a, mf_m, mf_u,
+                                   mf_v, hfx_x, hfx_y, hfx_z, qfx1_x, qfx1_y, qfx1_z, qfx2_z, diss,
+                                   mu_turb, solverChoice, level, tm_arr, grav_gpu, bc_ptr,
+                                   use_most);
+    }
+}
@@ -0,0 +1,351 @@
+#include <ERF_Diffusion.H>
+#include <ERF_EddyViscosity.H>
+#include <ERF_TerrainMetrics.H>
+
+using namespace amrex;
+
+/**
+ * Map a conserved state component to its vertical eddy diffusivity component
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+int
+VertEddyDiffComp (const int qty_index)
+{
+    if (qty_index == RhoTheta_comp) { return EddyDiff::Theta_v; }
+    if (qty_index == RhoKE_comp)    { return EddyDiff::KE_v;    }
+    if (qty_index == RhoQKE_comp)   { return EddyDiff::QKE_v;   }
+    if (qty_index <  RhoQ1_comp)    { return EddyDiff::Scalar_v; }
+    return EddyDiff::Q_v;
+}
+
+/**
+ * Solve the tridiagonal system a(k) x(k-1) + b(k) x(k) + c(k) x(k+1) = r(k) over a single
+ * column with the Thomas algorithm. The solution overwrites r and cp is scratch storage.
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+void
+SolveColumnTridiag (const int i, const int j, const int klo, const int khi,
+                    const Array4<const Real>& a,
+                    const Array4<const Real>& b,
+                    const Array4<const Real>& c,
+                    const Array4<Real>& r,
+                    const Array4<Real>& cp)
+{
+    Real inv_b  = 1.0 / b(i,j,klo);
+    cp(i,j,klo) = c(i,j,klo) * inv_b;
+    r (i,j,klo) = r(i,j,klo) * inv_b;
+    for (int k(klo+1); k<=khi; ++k) {
+        inv_b     = 1.0 / (b(i,j,k) - a(i,j,k)*cp(i,j,k-1));
+        cp(i,j,k) = c(i,j,k) * inv_b;
+        r (i,j,k) = (r(i,j,k) - a(i,j,k)*r(i,j,k-1)) * inv_b;
+    }
+    for (int k(khi-1); k>=klo; --k) {
+        r(i,j,k) -= cp(i,j,k) * r(i,j,k+1);
+    }
+}
+
+/**
+ * Function for the vertically implicit turbulent diffusion of the cell-centered state.
+ *
+ * Only the share vert_implicit_fac of the vertical eddy diffusivity is treated here; the
+ * explicit share, along with any prescribed or MOST flux on the bottom and top faces, is
+ * applied in the slow RHS. Hence, zero flux is imposed on the domain boundaries.
+ *
+ * @param[in]    bx cell center box to loop over (must span the domain in z)
+ * @param[in]    domain box of the whole domain
+ * @param[in]    start_comp starting component index
+ * @param[in]    num_comp number of components
+ * @param[in]    dt time step
+ * @param[in]    vert_implicit_fac implicit share of the vertical eddy diffusivity
+ * @param[inout] cell_data conserved cell center vars
+ * @param[in]    mu_turb turbulent viscosity
+ * @param[in]    z_nd nodal array of physical z heights
+ * @param[in]    cellSizeInv inverse cell size array
+ * @param[in]    use_terrain whether the grid is terrain-following
+ */
+void
+ImplicitDiffForState (const Box& bx, const Box& domain,
+                      int start_comp, int num_comp,
+                      const Real dt, const Real vert_implicit_fac,
+                      const Array4<      Real>& cell_data,
+                      const Array4<const AuxReal>& mu_turb,
+                      const Array4<const Real>& z_nd,
+                      const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                      const bool use_terrain)
+{
+    BL_PROFILE_VAR("ImplicitDiffForState()",ImplicitDiffForState);
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(bx.smallEnd(2) == domain.smallEnd(2) &&
+                                     bx.bigEnd(2)   == domain.bigEnd(2),
+                                     "Implicit vertical diffusion requires boxes spanning the domain in z");
+
+    const int klo = bx.smallEnd(2);
+    const int khi = bx.bigEnd(2);
+
+    const Real dz     = 1.0 / cellSizeInv[2];
+    const Real imp_dt = vert_implicit_fac * dt;
+
+    FArrayBox tri_fab(bx, 5, The_Async_Arena());
+    Array4<Real> a  = tri_fab.array(0);
+    Array4<Real> b  = tri_fab.array(1);
+    Array4<Real> c  = tri_fab.array(2);
+    Array4<Real> r  = tri_fab.array(3);
+    Array4<Real> cp = tri_fab.array(4);
+
+    Box xybx = makeSlab(bx,2,klo);
+
+    ParallelFor(xybx, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+    {
+        for (int n(0); n<num_comp; ++n) {
+            const int qty_index  = start_comp + n;
+            const int eddy_index = VertEddyDiffComp(qty_index);
+
+            for (int k(klo); k<=khi; ++k) {
+                // Cell heights and distances between cell centers
+                Real h_k, dzc_lo, dzc_hi;
+                if (use_terrain) {
+                    h_k    = Compute_h_zeta_AtCellCenter(i,j,k,cellSizeInv,z_nd) * dz;
+                    dzc_lo = (k > klo) ? 0.5 * ( h_k + Compute_h_zeta_AtCellCenter(i,j,k-1,cellSizeInv,z_nd) * dz ) : h_k;
+                    dzc_hi = (k < khi) ? 0.5 * ( h_k + Compute_h_zeta_AtCellCenter(i,j,k+1,cellSizeInv,z_nd) * dz ) : h_k;
+                } else {
+                    h_k = dzc_lo = dzc_hi = dz;
+                }
+
+                Real K_lo = (k > klo) ? 0.5 * ( mu_turb(i,j,k,eddy_index) + mu_turb(i,j,k-1,eddy_index) ) / dzc_lo : 0.0;
+                Real K_hi = (k < khi) ? 0.5 * ( mu_turb(i,j,k,eddy_index) + mu_turb(i,j,k+1,eddy_index) ) / dzc_hi : 0.0;
+
+                a(i,j,k) = -imp_dt * K_lo / h_k;
+                c(i,j,k) = -imp_dt * K_hi / h_k;
+                b(i,j,k) = cell_data(i,j,k,Rho_comp) - a(i,j,k) - c(i,j,k);
+                r(i,j,k) = cell_data(i,j,k,qty_index);
+            }
+
+            SolveColumnTridiag(i, j, klo, khi, a, b, c, r, cp);
+
+            for (int k(klo); k<=khi; ++k) {
+                cell_data(i,j,k,qty_index) = cell_data(i,j,k,Rho_comp) * r(i,j,k);
+            }
+        }
+    });
+}
+
+/**
+ * Coefficient of the turbulent d(u)/dz flux on the z-face k of the x-momentum column (i,j),
+ * i.e. the flux is ImplicitMomFaceCoefX * (u(i,j,k) - u(i,j,k-1)). The explicit stress
+ * tau13 uses the same mu_turb average and metric, and, as in DiffusionSrcForMom_N/T, its
+ * z-derivative carries no map factor (the map factors only scale the horizontal fluxes).
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+ImplicitMomFaceCoefX (const int i, const int j, const int k,
+                      const Array4<const AuxReal>& mu_turb,
+                      const Array4<const Real>& z_nd,
+                      const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                      const bool use_terrain)
+{
+    Real mu_bar = 0.25 * ( mu_turb(i-1,j,k  ,EddyDiff::Mom_v) + mu_turb(i,j,k  ,EddyDiff::Mom_v)
+                         + mu_turb(i-1,j,k-1,EddyDiff::Mom_v) + mu_turb(i,j,k-1,EddyDiff::Mom_v) );
+    Real met_h_zeta = (use_terrain) ? Compute_h_zeta_AtEdgeCenterJ(i,j,k,cellSizeInv,z_nd) : 1.0;
+    return mu_bar * cellSizeInv[2] / met_h_zeta;
+}
+
+/**
+ * Coefficient of the turbulent d(v)/dz flux on the z-face k of the y-momentum column (i,j)
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+ImplicitMomFaceCoefY (const int i, const int j, const int k,
+                      const Array4<const AuxReal>& mu_turb,
+                      const Array4<const Real>& z_nd,
+                      const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                      const bool use_terrain)
+{
+    Real mu_bar = 0.25 * ( mu_turb(i,j-1,k  ,EddyDiff::Mom_v) + mu_turb(i,j,k  ,EddyDiff::Mom_v)
+                         + mu_turb(i,j-1,k-1,EddyDiff::Mom_v) + mu_turb(i,j,k-1,EddyDiff::Mom_v) );
+    Real met_h_zeta = (use_terrain) ? Compute_h_zeta_AtEdgeCenterI(i,j,k,cellSizeInv,z_nd) : 1.0;
+    return mu_bar * cellSizeInv[2] / met_h_zeta;
+}
+
+/**
+ * Function for the vertically implicit turbulent diffusion of the horizontal momenta.
+ *
+ * Only the share vert_implicit_fac of the vertical eddy viscosity is treated here; the
+ * explicit share and the surface stress are applied in the slow RHS. Hence, zero stress
+ * is imposed on the domain boundaries. The operator is built from the same face
+ * coefficients and Jacobian as the share removed in ImplicitDiffSrcForMom, so the
+ * explicit and implicit parts add up to the full turbulent stress.
+ *
+ * @param[in]    bxx nodal x box for x-mom (must span the domain in z)
+ * @param[in]    bxy nodal y box for y-mom (must span the domain in z)
+ * @param[in]    domain box of the whole domain
+ * @param[in]    dt time step
+ * @param[in]    vert_implicit_fac implicit share of the vertical eddy viscosity
+ * @param[inout] rho_u x-momentum
+ * @param[inout] rho_v y-momentum
+ * @param[in]    cell_data conserved cell center vars
+ * @param[in]    mu_turb turbulent viscosity
+ * @param[in]    z_nd nodal array of physical z heights
+ * @param[in]    detJ Jacobian determinant
+ * @param[in]    cellSizeInv inverse cell size array
+ * @param[in]    use_terrain whether the grid is terrain-following
+ */
+void
+ImplicitDiffForMom (const Box& bxx, const Box& bxy, const Box& domain,
+                    const Real dt, const Real vert_implicit_fac,
+                    const Array4<      Real>& rho_u,
+                    const Array4<      Real>& rho_v,
+                    const Array4<const Real>& cell_data,
+                    const Array4<const AuxReal>& mu_turb,
+                    const Array4<const Real>& z_nd,
+                    const Array4<const Real>& detJ,
+                    const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                    const bool use_terrain)
+{
+    BL_PROFILE_VAR("ImplicitDiffForMom()",ImplicitDiffForMom);
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(bxx.smallEnd(2) == domain.smallEnd(2) &&
+                                     bxx.bigEnd(2)   == domain.bigEnd(2),
+                                     "Implicit vertical diffusion requires boxes spanning the domain in z");
+
+    const int klo = bxx.smallEnd(2);
+    const int khi = bxx.bigEnd(2);
+
+    const Real dzinv  = cellSizeInv[2];
+    const Real imp_dt = vert_implicit_fac * dt;
+
+    // x-momentum
+    {
+        FArrayBox tri_fab(bxx, 5, The_Async_Arena());
+        Array4<Real> a  = tri_fab.array(0);
+        Array4<Real> b  = tri_fab.array(1);
+        Array4<Real> c  = tri_fab.array(2);
+        Array4<Real> r  = tri_fab.array(3);
+        Array4<Real> cp = tri_fab.array(4);
+
+        Box xybx = makeSlab(bxx,2,klo);
+
+        ParallelFor(xybx, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+        {
+            for (int k(klo); k<=khi; ++k) {
+                Real fac = imp_dt * dzinv;
+                if (use_terrain) fac /= 0.5*(detJ(i,j,k) + detJ(i-1,j,k));
+
+                Real K_lo = (k > klo) ? ImplicitMomFaceCoefX(i,j,k  ,mu_turb,z_nd,cellSizeInv,use_terrain) : 0.0;
+                Real K_hi = (k < khi) ? ImplicitMomFaceCoefX(i,j,k+1,mu_turb,z_nd,cellSizeInv,use_terrain) : 0.0;
+
+                a(i,j,k) = -fac * K_lo;
+                c(i,j,k) = -fac * K_hi;
+                b(i,j,k) = 0.5 * ( cell_data(i-1,j,k,Rho_comp) + cell_data(i,j,k,Rho_comp) ) - a(i,j,k) - c(i,j,k);
+                r(i,j,k) = rho_u(i,j,k);
+            }
+
+            SolveColumnTridiag(i, j, klo, khi, a, b, c, r, cp);
+
+            for (int k(klo); k<=khi; ++k) {
+                rho_u(i,j,k) = 0.5 * ( cell_data(i-1,j,k,Rho_comp) + cell_data(i,j,k,Rho_comp) ) * r(i,j,k);
+            }
+        });
+    }
+
+    // y-momentum
+    {
+        FArrayBox tri_fab(bxy, 5, The_Async_Arena());
+        Array4<Real> a  = tri_fab.array(0);
+        Array4<Real> b  = tri_fab.array(1);
+        Array4<Real> c  = tri_fab.array(2);
+        Array4<Real> r  = tri_fab.array(3);
+        Array4<Real> cp = tri_fab.array(4);
+
+        Box xybx = makeSlab(bxy,2,klo);
+
+        ParallelFor(xybx, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+        {
+            for (int k(klo); k<=khi; ++k) {
+                Real fac = imp_dt * dzinv;
+                if (use_terrain) fac /= 0.5*(detJ(i,j,k) + detJ(i,j-1,k));
+
+                Real K_lo = (k > klo) ? ImplicitMomFaceCoefY(i,j,k  ,mu_turb,z_nd,cellSizeInv,use_terrain) : 0.0;
+                Real K_hi = (k < khi) ? ImplicitMomFaceCoefY(i,j,k+1,mu_turb,z_nd,cellSizeInv,use_terrain) : 0.0;
+
+                a(i,j,k) = -fac * K_lo;
+                c(i,j,k) = -fac * K_hi;
+                b(i,j,k) = 0.5 * ( cell_data(i,j-1,k,Rho_comp) + cell_data(i,j,k,Rho_comp) ) - a(i,j,k) - c(i,j,k);
+                r(i,j,k) = rho_v(i,j,k);
+            }
+
+            SolveColumnTridiag(i, j, klo, khi, a, b, c, r, cp);
+
+            for (int k(klo); k<=khi; ++k) {
+                rho_v(i,j,k) = 0.5 * ( cell_data(i,j-1,k,Rho_comp) + cell_data(i,j,k,Rho_comp) ) * r(i,j,k);
+            }
+        });
+    }
+}
+
+/**
+ * Function to remove the implicitly treated share of the turbulent vertical momentum flux
+ * from the slow RHS of the horizontal momenta.
+ *
+ * The stresses tau13/tau23 are computed in full since they also enter the w equation
+ * and carry the dw/dx, dw/dy and metric terms. Only the turbulent d(u,v)/dz part on
+ * interior z-faces, i.e. exactly the flux that ImplicitDiffForMom applies, is taken out.
+ *
+ * @param[in]    bxx nodal x box for x-mom
+ * @param[in]    bxy nodal y box for y-mom
+ * @param[in]    domain box of the whole domain
+ * @param[in]    vert_implicit_fac implicit share of the vertical eddy viscosity
+ * @param[inout] rho_u_rhs RHS for x-mom
+ * @param[inout] rho_v_rhs RHS for y-mom
+ * @param[in]    u x-direction velocity
+ * @param[in]    v y-direction velocity
+ * @param[in]    mu_turb turbulent viscosity
+ * @param[in]    z_nd nodal array of physical z heights
+ * @param[in]    detJ Jacobian determinant
+ * @param[in]    cellSizeInv inverse cell size array
+ * @param[in]    use_terrain whether the grid is terrain-following
+ */
+void
+ImplicitDiffSrcForMom (const Box& bxx, const Box& bxy, const Box& domain,
+                       const Real vert_implicit_fac,
+                       const Array4<      Real>& rho_u_rhs,
+                       const Array4<      Real>& rho_v_rhs,
+                       const Array4<const Real>& u,
+                       const Array4<const Real>& v,
+                       const Array4<const AuxReal>& mu_turb,
+                       const Array4<const Real>& z_nd,
+                       const Array4<const Real>& detJ,
+                       const GpuArray<Real, AMREX_SPACEDIM>& cellSizeInv,
+                       const bool use_terrain)
+{
+    BL_PROFILE_VAR("ImplicitDiffSrcForMom()",ImplicitDiffSrcForMom);
+
+    const int  domlo_z = domain.smallEnd(2);
+    const int  domhi_z = domain.bigEnd(2);
+    const Real dzinv   = cellSizeInv[2];
+
+    ParallelFor(bxx, bxy,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real flux_lo = (k > domlo_z) ?
+            ImplicitMomFaceCoefX(i,j,k  ,mu_turb,z_nd,cellSizeInv,use_terrain) * (u(i,j,k  ) - u(i,j,k-1)) : 0.0;
+        Real flux_hi = (k < domhi_z) ?
+            ImplicitMomFaceCoefX(i,j,k+1,mu_turb,z_nd,cellSizeInv,use_terrain) * (u(i,j,k+1) - u(i,j,k  )) : 0.0;
+        Real diffContrib = vert_implicit_fac * (flux_hi - flux_lo) * dzinv;
+        if (use_terrain) diffContrib /= 0.5*(detJ(i,j,k) + detJ(i-1,j,k));
+        rho_u_rhs(i,j,k) -= diffContrib;
+    },
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        Real flux_lo = (k > domlo_z) ?
+            ImplicitMomFaceCoefY(i,j,k  ,mu_turb,z_nd,cellSizeInv,use_terrain) * (v(i,j,k  ) - v(i,j,k-1)) : 0.0;
+        Real flux_hi = (k < domhi_z) ?
+            ImplicitMomFaceCoefY(i,j,k+1,mu_turb,z_nd,cellSizeInv,use_terrain) * (v(i,j,k+1) - v(i,j,k  )) : 0.0;
+        Real diffContrib = vert_implicit_fac * (flux_hi - flux_lo) * dzinv;
+        if (use_terrain) diffContrib /= 0.5*(detJ(i,j,k) + detJ(i,j-1,k));
+        rho_v_rhs(i,j,k) -= diffContrib;
+    });
+}
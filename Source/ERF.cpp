@@ -25,6 +25,7 @@ Real ERF::startCPUTime        = 0.0;
 Real ERF::previousCPUTimeUsed = 0.0;
 
 Vector<AMRErrorTag> ERF::ref_tags;
+Vector<TagCriterionInfo> ERF::state_tags;
 
 SolverChoice ERF::solverChoice;
 
@@ -73,6 +74,12 @@ Real ERF::column_loc_x     = 0.0;
 Real ERF::column_loc_y     = 0.0;
 std::string ERF::column_file_name = "column_data.nc";
 
+// Per-turbine time series output for windfarm simulations
+int  ERF::windfarm_diag_int       = -1;
+Real ERF::windfarm_diag_per       = -1.0;
+int  ERF::windfarm_diag_flush_int = 100;
+std::string ERF::windfarm_diag_file = "turbine_diagnostics";
+
 // 2D BndryRegister output (for ingestion by AMR-Wind)
 int  ERF::output_bndry_planes            = 0;
 int  ERF::bndry_output_planes_interval   = -1;
@@ -127,6 +134,9 @@ ERF::ERF_shared ()
     qheating_rates.resize(nlevs_max);
     sw_lw_fluxes.resize(nlevs_max);
     solar_zenith.resize(nlevs_max);
+    qheating_rates_rad.resize(nlevs_max);
+    sw_lw_fluxes_rad.resize(nlevs_max);
+    solar_zenith_rad.resize(nlevs_max);
 #endif
 
     // NOTE: size lsm before readparams (chooses the model at all levels)
@@ -191,6 +201,7 @@ ERF::ERF_shared ()
 
 #ifdef ERF_USE_POISSON_SOLVE
     pp_inc.resize(nlevs_max);
+    terrain_poisson.resize(nlevs_max);
 #endif
 
     rU_new.resize(nlevs_max);
@@ -201,6 +212,12 @@ ERF::ERF_shared ()
     rV_old.resize(nlevs_max);
     rW_old.resize(nlevs_max);
 
+    cc_source.resize(nlevs_max);
+    xmom_source.resize(nlevs_max);
+    ymom_source.resize(nlevs_max);
+    zmom_source.resize(nlevs_max);
+    cons_scratch.resize(nlevs_max);
+
     for (int lev = 0; lev < nlevs_max; ++lev) {
         vars_new[lev].resize(Vars::NumTypes);
         vars_old[lev].resize(Vars::NumTypes);
@@ -241,6 +258,10 @@ ERF::ERF_shared ()
     ax.resize(nlevs_max);
     ay.resize(nlevs_max);
     az.resize(nlevs_max);
+    compact_terrain.resize(nlevs_max);
+
+    // Measured costs of the boxes
+    box_costs.resize(nlevs_max);
 
     z_phys_nd_new.resize(nlevs_max);
     detJ_cc_new.resize(nlevs_max);
@@ -419,6 +440,23 @@ ERF::Evolve ()
         }
     }
 
+    if (fast_halo_substeps > 1) {
+        Print() << "Acoustic substeps at level 0: " << fast_halo_exchanges << " halo exchanges for "
+                << fast_halo_substeps_taken << " substeps ("
+                << fast_halo_substeps_taken - fast_halo_exchanges << " saved)" << std::endl;
+    }
+
+#ifdef ERF_USE_POISSON_SOLVE
+    for (int n = 0; n < 2; ++n) {
+        if (projection_solves[n] > 0) {
+            Print() << "Projections with " << ((n == 0) ? "mlmg" : "terrain_mg") << ": "
+                    << projection_solves[n] << " solves, "
+                    << static_cast<Real>(projection_iters[n]) / projection_solves[n] << " iterations and "
+                    << projection_time[n] / projection_solves[n] << " s per solve" << std::endl;
+        }
+    }
+#endif
+
     BL_PROFILE_VAR_STOP(evolve);
 }
 
@@ -429,7 +467,7 @@ ERF::post_timestep (int nstep, Real time, Real dt_lev0)
     BL_PROFILE("ERF::post_timestep()");
 
 #ifdef ERF_USE_PARTICLES
-    particleData.Redistribute();
+    particleData.RedistributeIfNeeded();
 #endif
 
     if (solverChoice.coupling_type == CouplingType::TwoWay)
@@ -492,6 +530,15 @@ ERF::post_timestep (int nstep, Real time, Real dt_lev0)
         sum_integrated_quantities(time);
     }
 
+#ifdef ERF_USE_WINDFARM
+    if (solverChoice.windfarm_type != WindFarmType::None &&
+        is_it_time_for_action(nstep, time, dt_lev0, windfarm_diag_int, windfarm_diag_per)) {
+        windfarm->sample_turbine_diagnostics(geom[0], time, vars_windfarm[0], vars_new[0][Vars::cons],
+                                             vars_new[0][Vars::xvel], vars_new[0][Vars::yvel],
+                                             vars_new[0][Vars::zvel]);
+    }
+#endif
+
     if (solverChoice.pert_type == PerturbationType::perturbSource ||
         solverChoice.pert_type == PerturbationType::perturbDirect) {
         if (is_it_time_for_action(nstep, time, dt_lev0, pert_interval, -1.)) {
@@ -552,6 +599,10 @@ ERF::post_timestep (int nstep, Real time, Real dt_lev0)
         make_zcc(geom[lev],*z_phys_nd[lev],*z_phys_cc[lev]);
       }
     }
+
+    if (load_balance_int > 0 && (nstep+1) % load_balance_int == 0) {
+        load_balance();
+    }
 } // post_timestep
 
 // This is called from main.cpp and handles all initialization, whether from start or restart
@@ -587,6 +638,19 @@ ERF::InitData ()
         Abort("We do not allow non-static terrain_type with use_terrain = false");
     }
 
+#ifdef ERF_USE_POISSON_SOLVE
+    // The terrain-following multigrid of the projection treats the bottom and top as walls
+    bool any_incompressible = false;
+    for (int lev = 0; lev <= max_level; ++lev) {
+        if (solverChoice.incompressible[lev]) any_incompressible = true;
+    }
+    if (any_incompressible && (solverChoice.use_terrain || projection_terrain_mg) &&
+        (get_projection_bc(Orientation::low )[2] == LinOpBCType::Dirichlet ||
+         get_projection_bc(Orientation::high)[2] == LinOpBCType::Dirichlet)) {
+        Abort("The projection with terrain or terrain_mg needs walls at the bottom and top, not Outflow");
+    }
+#endif
+
     last_plot_file_step_1 = -1;
     last_plot_file_step_2 = -1;
     last_check_file_step  = -1;
@@ -696,6 +760,8 @@ ERF::InitData ()
         {
             AMREX_ALWAYS_ASSERT_WITH_MESSAGE(finest_level == 0,
                 "Thin immersed body with refinement not currently supported.");
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!solverChoice.anelastic,
+                "Thin immersed body with the anelastic dycore not currently supported.");
             if (solverChoice.use_terrain == 1) {
                 amrex::Print() << "NOTE: Thin immersed body with terrain has not been tested." << std::endl;
             }
@@ -860,13 +926,65 @@ ERF::InitData ()
 #ifdef ERF_USE_POISSON_SOLVE
     if (restart_chkfile == "")
     {
-        // Note -- this projection is only defined for no terrain
+        // The anelastic density is the reference density of the base state; (rho theta)
+        //    and the other conserved scalars are rescaled so theta and the mixing ratios are kept
+        if (solverChoice.anelastic) {
+            int ncomp = vars_new[0][Vars::cons].nComp();
+            for (int lev = 0; lev <= finest_level; ++lev)
+            {
+                MultiFab& cons = vars_new[lev][Vars::cons];
+                for (MFIter mfi(cons, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                    const Box& gbx = mfi.growntilebox(base_state[lev].nGrowVect());
+                    const Array4<      Real>& cons_arr = cons.array(mfi);
+                    const Array4<const Real>&   r0_arr = base_state[lev].const_array(mfi);
+                    ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                    {
+                        Real fac = r0_arr(i,j,k,0) / cons_arr(i,j,k,Rho_comp);
+                        for (int n = 1; n < ncomp; ++n) {
+                            cons_arr(i,j,k,n) *= fac;
+                        }
+                        cons_arr(i,j,k,Rho_comp) = r0_arr(i,j,k,0);
+                    });
+                } // mfi
+                cons.FillBoundary(geom[lev].periodicity());
+            }
+        }
+
         if (solverChoice.project_initial_velocity) {
-            AMREX_ALWAYS_ASSERT(solverChoice.use_terrain == 0);
             Real dummy_dt = 1.0;
             for (int lev = 0; lev <= finest_level; ++lev)
             {
-                project_velocities(lev, dummy_dt, vars_new[lev], pp_inc[lev]);
+                if (solverChoice.anelastic) {
+                    // The anelastic projection acts on the momenta
+                    VelocityToMomentum(vars_new[lev][Vars::xvel], IntVect(0,0,0),
+                                       vars_new[lev][Vars::yvel], IntVect(0,0,0),
+                                       vars_new[lev][Vars::zvel], IntVect(0,0,0),
+                                       vars_new[lev][Vars::cons],
+                                         rU_new[lev],
+                                         rV_new[lev],
+                                         rW_new[lev],
+                                       Geom(lev).Domain(),
+                                       domain_bcs_type);
+
+                    Vector<MultiFab> mom_mf;
+                    mom_mf.push_back(MultiFab(vars_new[lev][Vars::cons], make_alias, 0, 1));
+                    mom_mf.push_back(MultiFab(rU_new[lev], make_alias, 0, 1));
+                    mom_mf.push_back(MultiFab(rV_new[lev], make_alias, 0, 1));
+                    mom_mf.push_back(MultiFab(rW_new[lev], make_alias, 0, 1));
+                    project_velocities(lev, dummy_dt, mom_mf, pp_inc[lev]);
+
+                    MomentumToVelocity(vars_new[lev][Vars::xvel],
+                                       vars_new[lev][Vars::yvel],
+                                       vars_new[lev][Vars::zvel],
+                                       vars_new[lev][Vars::cons],
+                                         rU_new[lev],
+                                         rV_new[lev],
+                                         rW_new[lev],
+                                       Geom(lev).Domain(),
+                                       domain_bcs_type);
+                } else {
+                    project_velocities(lev, dummy_dt, vars_new[lev], pp_inc[lev]);
+                }
                 pp_inc[lev].setVal(0.);
             }
         }
@@ -1203,6 +1321,7 @@ void
 ERF::initializeWindFarm(const int& a_nlevsmax/*!< number of AMR levels */ )
 {
     windfarm = std::make_unique<WindFarm>(a_nlevsmax, solverChoice.windfarm_type);
+    windfarm->init_turbine_diagnostics(windfarm_diag_file, windfarm_diag_flush_int);
 }
 #endif
 
@@ -1229,6 +1348,11 @@ ERF::restart ()
        ReadCheckpointFile();
     }
 
+#ifdef ERF_USE_WINDFARM
+    // Continue the turbine time series of the run we restart from
+    windfarm->restart_turbine_diagnostics(t_new[0]);
+#endif
+
     // We set this here so that we don't over-write the checkpoint file we just started from
     last_check_file_step = istep[0];
 }
@@ -1454,6 +1578,17 @@ ERF::ReadParameters ()
         pp.query("plot_lsm", plot_lsm);
 #ifdef ERF_USE_RRTMGP
         pp.query("plot_rad", plot_rad);
+
+        // Horizontal coarsening of the radiation grid
+        pp.query("rad_coarsen", rad_coarsen);
+        pp.query("rad_coarsen_check", rad_coarsen_check);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(rad_coarsen >= 1, "erf.rad_coarsen must be at least 1");
+
+        // The full-resolution check keeps its own radiation object so neither call
+        // resizes the other's persistent work arrays
+        if (rad_coarsen > 1 && rad_coarsen_check) {
+            rad_check = std::make_unique<Radiation>();
+        }
 #endif
 
         pp.query("output_1d_column", output_1d_column);
@@ -1463,6 +1598,12 @@ ERF::ReadParameters ()
         pp.query("column_loc_y", column_loc_y);
         pp.query("column_file_name", column_file_name);
 
+        // Per-turbine power and thrust time series
+        pp.query("windfarm_diag_int", windfarm_diag_int);
+        pp.query("windfarm_diag_per", windfarm_diag_per);
+        pp.query("windfarm_diag_flush_int", windfarm_diag_flush_int);
+        pp.query("windfarm_diag_file", windfarm_diag_file);
+
         // Specify information about outputting planes of data
         pp.query("output_bndry_planes", output_bndry_planes);
         pp.query("bndry_output_planes_interval", bndry_output_planes_interval);
@@ -1484,6 +1625,58 @@ ERF::ReadParameters ()
         bool iterate(true);
         pp_amr.query("iterate_grids",iterate);
         if (!iterate) SetIterateToFalse();
+
+        // Keep the data of unchanged fine grids when regridding?
+        pp.query("regrid_incremental", regrid_incremental);
+
+        // Grids made of whole columns? (max_grid_size in z is lifted in main.cpp)
+        pp.query("column_grids", column_grids);
+        std::string column_grids_balance = "SFC";
+        pp.query("column_grids_balance", column_grids_balance);
+        if (column_grids_balance == "SFC" || column_grids_balance == "sfc") {
+            column_grids_sfc = true;
+        } else if (column_grids_balance == "KnapSack" || column_grids_balance == "knapsack") {
+            column_grids_sfc = false;
+        } else {
+            Abort("erf.column_grids_balance must be SFC or KnapSack");
+        }
+
+        // Rebalance with measured costs every load_balance_int coarse steps and/or on regrid
+        pp.query("load_balance_int", load_balance_int);
+        pp.query("load_balance_on_regrid", load_balance_on_regrid);
+        pp.query("load_balance_threshold", load_balance_threshold);
+        std::string load_balance_strategy = "KnapSack";
+        pp.query("load_balance_strategy", load_balance_strategy);
+        if (load_balance_strategy == "KnapSack" || load_balance_strategy == "knapsack") {
+            load_balance_knapsack = true;
+        } else if (load_balance_strategy == "SFC" || load_balance_strategy == "sfc") {
+            load_balance_knapsack = false;
+        } else {
+            Abort("erf.load_balance_strategy must be KnapSack or SFC");
+        }
+
+        // Acoustic substeps per halo exchange of the fast variables
+        pp.query("fast_halo_substeps", fast_halo_substeps);
+        if (fast_halo_substeps < 1) {
+            Abort("erf.fast_halo_substeps must be at least 1");
+        }
+
+#ifdef ERF_USE_POISSON_SOLVE
+        // Solver for the projection of the incompressible velocities
+        std::string projection_solver = "mlmg";
+        pp.query("projection_solver", projection_solver);
+        if (projection_solver == "mlmg" || projection_solver == "MLMG") {
+            projection_terrain_mg = false;
+        } else if (projection_solver == "terrain_mg") {
+            projection_terrain_mg = true;
+        } else {
+            Abort("erf.projection_solver must be mlmg or terrain_mg");
+        }
+        pp.query("projection_mg_max_iter", projection_mg_max_iter);
+        pp.query("projection_mg_sweeps", projection_mg_sweeps);
+        pp.query("projection_mg_bottom_sweeps", projection_mg_bottom_sweeps);
+        pp.query("projection_mg_bicgstab", projection_mg_bicgstab);
+#endif
     }
 
 #ifdef ERF_USE_PARTICLES
@@ -1,8 +1,24 @@
 #include <ERF.H>
-#include <ERF_Derive.H>
 
 using namespace amrex;
 
+namespace {
+
+// Fields the criteria of ERF::state_tags are derived from; the index is the TagField
+const Vector<std::string> tag_field_names = {"density", "theta", "pressure", "scalar", "qv", "qc",
+                                             "tke", "qke", "vorticity", "richardson"};
+
+int
+tag_field_index (const std::string& name)
+{
+    for (int n = 0; n < tag_field_names.size(); ++n) {
+        if (name == tag_field_names[n]) { return n; }
+    }
+    return -1;
+}
+
+} // namespace
+
 /**
  * Function to tag cells for refinement -- this overrides the pure virtual function in AmrCore
  *
@@ -17,45 +33,19 @@ ERF::ErrorEst (int levc, TagBoxArray& tags, Real time, int /*ngrow*/)
     const int clearval = TagBox::CLEAR;
     const int   tagval = TagBox::SET;
 
+    // Criteria derived from the state are all evaluated in one kernel per box
+    if (!state_tags.empty()) {
+        tag_state_criteria(levc, tags, time);
+    }
+
     for (int j=0; j < ref_tags.size(); ++j)
     {
         std::unique_ptr<MultiFab> mf = std::make_unique<MultiFab>(grids[levc], dmap[levc], 1, 0);
 
-        // This allows dynamic refinement based on the value of the density
-        if (ref_tags[j].Field() == "density")
-        {
-            MultiFab::Copy(*mf,vars_new[levc][Vars::cons],Rho_comp,0,1,0);
-
-        // This allows dynamic refinement based on the value of qv
-        } else if ( ref_tags[j].Field() == "qv" ) {
-            MultiFab::Copy(  *mf, vars_new[levc][Vars::cons], RhoQ1_comp, 0, 1, 0);
-            MultiFab::Divide(*mf, vars_new[levc][Vars::cons],   Rho_comp, 0, 1, 0);
-
-
-        // This allows dynamic refinement based on the value of qc
-        } else if (ref_tags[j].Field() == "qc" ) {
-            MultiFab::Copy(  *mf, vars_new[levc][Vars::cons], RhoQ2_comp, 0, 1, 0);
-            MultiFab::Divide(*mf, vars_new[levc][Vars::cons],   Rho_comp, 0, 1, 0);
-
-
-        // This allows dynamic refinement based on the value of the scalar/pressure/theta
-        } else if ( (ref_tags[j].Field() == "scalar"  ) ||
-                    (ref_tags[j].Field() == "pressure") ||
-                    (ref_tags[j].Field() == "theta"   ) )
-        {
-            for (MFIter mfi(*mf, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-            {
-                const Box& bx = mfi.tilebox();
-                auto& dfab = (*mf)[mfi];
-                auto& sfab = vars_new[levc][Vars::cons][mfi];
-                if (ref_tags[j].Field() == "scalar") {
-                    derived::erf_derscalar(bx, dfab, 0, 1, sfab, Geom(levc), time, nullptr, levc);
-                } else if (ref_tags[j].Field() == "theta") {
-                    derived::erf_dertheta(bx, dfab, 0, 1, sfab, Geom(levc), time, nullptr, levc);
-                }
-            } // mfi
+        // The fields of the state are handled by tag_state_criteria; what remains here
+        // are the static boxes and the particle counts
 #ifdef ERF_USE_PARTICLES
-        } else {
+        if (!ref_tags[j].Field().empty()) {
             //
             // This allows dynamic refinement based on the number of particles per cell
             //
@@ -90,13 +80,114 @@ ERF::ErrorEst (int levc, TagBoxArray& tags, Real time, int /*ngrow*/)
                     }
                 }
             }
-#endif
         }
+#endif
 
         ref_tags[j](tags,mf.get(),clearval,tagval,time,levc,geom[levc]);
     } // loop over j
 }
 
+/**
+ * Tag the cells of level levc that meet any of the criteria in state_tags. The criteria
+ * active at this level and time are copied to the device, and a single kernel per box
+ * derives the fields from the state and tests every criterion, so no field is stored.
+ *
+ * @param[in] levc level of refinement at which we tag cells
+ * @param[out] tags array of tagged cells
+ * @param[in] time current time
+*/
+
+void
+ERF::tag_state_criteria (int levc, TagBoxArray& tags, Real time)
+{
+    BL_PROFILE("ERF::tag_state_criteria()");
+
+    Vector<TagCriterion> h_crit;
+    bool need_neighbors = false;
+    for (const auto& info : state_tags)
+    {
+        if (levc >= info.max_level || time < info.min_time || time > info.max_time) { continue; }
+
+        TagCriterion c;
+        c.field = info.field;
+        c.test  = info.test;
+        c.threshold = (info.value.empty()) ? 0.0 : info.value[std::min(levc, int(info.value.size())-1)];
+        c.has_box = info.has_box;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            Real shift = info.box_velocity[d] * (time - info.box_time);
+            c.box_lo[d] = info.realbox.lo(d) + shift;
+            c.box_hi[d] = info.realbox.hi(d) + shift;
+        }
+        h_crit.push_back(c);
+
+        need_neighbors = need_neighbors || (c.test == TagTest::adjacent_diff) || (c.test == TagTest::gradient) ||
+                         (c.field == TagField::vorticity) || (c.field == TagField::richardson);
+    }
+    if (h_crit.empty()) { return; }
+
+    MultiFab& cons = vars_new[levc][Vars::cons];
+    MultiFab& xvel = vars_new[levc][Vars::xvel];
+    MultiFab& yvel = vars_new[levc][Vars::yvel];
+    MultiFab& zvel = vars_new[levc][Vars::zvel];
+
+    // The stencils reach one cell beyond the valid box
+    if (need_neighbors) {
+        cons.FillBoundary(geom[levc].periodicity());
+        xvel.FillBoundary(geom[levc].periodicity());
+        yvel.FillBoundary(geom[levc].periodicity());
+        zvel.FillBoundary(geom[levc].periodicity());
+    }
+
+    const int ncrit = h_crit.size();
+    Gpu::DeviceVector<TagCriterion> d_crit(ncrit);
+    Gpu::copy(Gpu::hostToDevice, h_crit.begin(), h_crit.end(), d_crit.begin());
+    const TagCriterion* crit = d_crit.data();
+
+    const char tagval = TagBox::SET;
+    const Box& domain = geom[levc].Domain();
+
+    TagData d;
+    d.use_terrain = (z_phys_cc[levc] != nullptr);
+    d.dx      = geom[levc].CellSizeArray();
+    d.prob_lo = geom[levc].ProbLoArray();
+    d.dom_lo  = lbound(domain);
+    d.dom_hi  = ubound(domain);
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        d.periodic[dir] = geom[levc].isPeriodic(dir);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(tags, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto tag_arr = tags.array(mfi);
+
+        TagData td = d;
+        td.cons = cons.const_array(mfi);
+        td.u    = xvel.const_array(mfi);
+        td.v    = yvel.const_array(mfi);
+        td.w    = zvel.const_array(mfi);
+        if (td.use_terrain) {
+            td.z_cc = z_phys_cc[levc]->const_array(mfi);
+        }
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            for (int n = 0; n < ncrit; ++n) {
+                if (tag_cell(td, crit[n], i, j, k)) {
+                    tag_arr(i,j,k) = tagval;
+                    break;
+                }
+            }
+        });
+    }
+
+    // d_crit must outlive the kernels
+    Gpu::streamSynchronize();
+}
+
 /**
  * Function to define the refinement criteria based on user input
 */
@@ -121,6 +212,9 @@ ERF::refinement_criteria_setup ()
             int num_real_lo = ppr.countval("in_box_lo");
             int num_indx_lo = ppr.countval("in_box_lo_indices");
 
+            // A moving region is not one of the fixed boxes at its level
+            bool moving_box = (ppr.countval("box_velocity") > 0);
+
             if ( !((num_real_lo == AMREX_SPACEDIM && num_indx_lo == 0) ||
                    (num_indx_lo == AMREX_SPACEDIM && num_real_lo == 0) ||
                    (num_indx_lo ==              0 && num_real_lo == 0)) )
@@ -142,23 +236,25 @@ ERF::refinement_criteria_setup ()
                     realbox = RealBox(&(box_lo[0]),&(box_hi[0]));
 
                     Print() << "Reading " << realbox << " at level " << lev_for_box << std::endl;
-                    num_boxes_at_level[lev_for_box] += 1;
-
-                    const auto* dx  = geom[lev_for_box].CellSize();
-                    const Real* plo = geom[lev_for_box].ProbLo();
-                    int ilo = static_cast<int>((box_lo[0] - plo[0])/dx[0]);
-                    int jlo = static_cast<int>((box_lo[1] - plo[1])/dx[1]);
-                    int klo = static_cast<int>((box_lo[2] - plo[2])/dx[2]);
-                    int ihi = static_cast<int>((box_hi[0] - plo[0])/dx[0]-1);
-                    int jhi = static_cast<int>((box_hi[1] - plo[1])/dx[1]-1);
-                    int khi = static_cast<int>((box_hi[2] - plo[2])/dx[2]-1);
-                    Box bx(IntVect(ilo,jlo,klo),IntVect(ihi,jhi,khi));
-                    if ( (ilo%ref_ratio[lev_for_box-1][0] != 0) || ((ihi+1)%ref_ratio[lev_for_box-1][0] != 0) ||
-                         (jlo%ref_ratio[lev_for_box-1][1] != 0) || ((jhi+1)%ref_ratio[lev_for_box-1][1] != 0) ||
-                         (klo%ref_ratio[lev_for_box-1][2] != 0) || ((khi+1)%ref_ratio[lev_for_box-1][2] != 0) )
-                         amrex::Error("Fine box is not legit with this ref_ratio");
-                    boxes_at_level[lev_for_box].push_back(bx);
-                    Print() << "Saving in 'boxes at level' as " << bx << std::endl;
+                    if (!moving_box) {
+                        num_boxes_at_level[lev_for_box] += 1;
+
+                        const auto* dx  = geom[lev_for_box].CellSize();
+                        const Real* plo = geom[lev_for_box].ProbLo();
+                        int ilo = static_cast<int>((box_lo[0] - plo[0])/dx[0]);
+                        int jlo = static_cast<int>((box_lo[1] - plo[1])/dx[1]);
+                        int klo = static_cast<int>((box_lo[2] - plo[2])/dx[2]);
+                        int ihi = static_cast<int>((box_hi[0] - plo[0])/dx[0]-1);
+                        int jhi = static_cast<int>((box_hi[1] - plo[1])/dx[1]-1);
+                        int khi = static_cast<int>((box_hi[2] - plo[2])/dx[2]-1);
+                        Box bx(IntVect(ilo,jlo,klo),IntVect(ihi,jhi,khi));
+                        if ( (ilo%ref_ratio[lev_for_box-1][0] != 0) || ((ihi+1)%ref_ratio[lev_for_box-1][0] != 0) ||
+                             (jlo%ref_ratio[lev_for_box-1][1] != 0) || ((jhi+1)%ref_ratio[lev_for_box-1][1] != 0) ||
+                             (klo%ref_ratio[lev_for_box-1][2] != 0) || ((khi+1)%ref_ratio[lev_for_box-1][2] != 0) )
+                             amrex::Error("Fine box is not legit with this ref_ratio");
+                        boxes_at_level[lev_for_box].push_back(bx);
+                        Print() << "Saving in 'boxes at level' as " << bx << std::endl;
+                    }
                 } // lev
                 if (init_type == "real" || init_type == "metgrid") {
                     if (num_boxes_at_level[lev_for_box] != num_files_at_level[lev_for_box]) {
@@ -189,14 +285,16 @@ ERF::refinement_criteria_setup ()
                                       plo[0]+(box_hi[0]+1)*dx[0],plo[1]+(box_hi[1]+1)*dx[1],plo[2]+(box_hi[2]+1)*dx[2]);
 
                     Print() << "Reading " << bx << " at level " << lev_for_box << std::endl;
-                    num_boxes_at_level[lev_for_box] += 1;
-
-                    if ( (box_lo[0]%ref_ratio[lev_for_box-1][0] != 0) || ((box_hi[0]+1)%ref_ratio[lev_for_box-1][0] != 0) ||
-                         (box_lo[1]%ref_ratio[lev_for_box-1][1] != 0) || ((box_hi[1]+1)%ref_ratio[lev_for_box-1][1] != 0) ||
-                         (box_lo[2]%ref_ratio[lev_for_box-1][2] != 0) || ((box_hi[2]+1)%ref_ratio[lev_for_box-1][2] != 0) )
-                         amrex::Error("Fine box is not legit with this ref_ratio");
-                    boxes_at_level[lev_for_box].push_back(bx);
-                    Print() << "Saving in 'boxes at level' as " << bx << std::endl;
+                    if (!moving_box) {
+                        num_boxes_at_level[lev_for_box] += 1;
+
+                        if ( (box_lo[0]%ref_ratio[lev_for_box-1][0] != 0) || ((box_hi[0]+1)%ref_ratio[lev_for_box-1][0] != 0) ||
+                             (box_lo[1]%ref_ratio[lev_for_box-1][1] != 0) || ((box_hi[1]+1)%ref_ratio[lev_for_box-1][1] != 0) ||
+                             (box_lo[2]%ref_ratio[lev_for_box-1][2] != 0) || ((box_hi[2]+1)%ref_ratio[lev_for_box-1][2] != 0) )
+                             amrex::Error("Fine box is not legit with this ref_ratio");
+                        boxes_at_level[lev_for_box].push_back(bx);
+                        Print() << "Saving in 'boxes at level' as " << bx << std::endl;
+                    }
                 } // lev
                 if (init_type == "real" || init_type == "metgrid") {
                     if (num_boxes_at_level[lev_for_box] != num_files_at_level[lev_for_box]) {
@@ -224,25 +322,82 @@ ERF::refinement_criteria_setup ()
                 info.SetMaxLevel(ref_max_level);
             }
 
-            if (ppr.countval("value_greater")) {
+            // Criteria on fields we can derive from the state, and moving regions, are
+            // evaluated together by tag_state_criteria
+            std::string field;
+            ppr.query("field_name",field);
+            int state_field = tag_field_index(field);
+            int num_vel = ppr.countval("box_velocity");
+
+            if (state_field >= 0 || (field.empty() && num_vel > 0))
+            {
+                TagCriterionInfo crit;
+                crit.name = refinement_indicators[i];
+                crit.field = (state_field >= 0) ? state_field : TagField::box;
+                crit.min_time = info.m_min_time;
+                crit.max_time = info.m_max_time;
+                crit.max_level = info.m_max_level;
+
+                Vector<std::pair<std::string,int>> tests = {{"value_greater"              , TagTest::greater},
+                                                            {"value_less"                 , TagTest::less},
+                                                            {"adjacent_difference_greater", TagTest::adjacent_diff},
+                                                            {"gradient_greater"           , TagTest::gradient}};
+                for (const auto& test : tests) {
+                    if (ppr.countval(test.first.c_str()) > 0) {
+                        crit.test = test.second;
+                        ppr.getarr(test.first.c_str(),crit.value,0,ppr.countval(test.first.c_str()));
+                        break;
+                    }
+                }
+                if (crit.field != TagField::box && crit.value.empty()) {
+                    Abort("No test given for refinement indicator " + refinement_indicators[i]);
+                }
+                if ( (crit.field == TagField::vorticity || crit.field == TagField::richardson) &&
+                     (crit.test == TagTest::adjacent_diff || crit.test == TagTest::gradient) ) {
+                    Abort("Only value_greater or value_less may be used with " + field);
+                }
+                if ( (crit.field == TagField::qv || crit.field == TagField::qc) &&
+                     solverChoice.moisture_type == MoistureType::None ) {
+                    Abort("Refinement on " + field + " requires a moisture model");
+                }
+
+                if (realbox.ok()) {
+                    crit.has_box = true;
+                    crit.realbox = realbox;
+                    if (num_vel > 0) {
+                        Vector<Real> vel(AMREX_SPACEDIM);
+                        ppr.getarr("box_velocity",vel,0,AMREX_SPACEDIM);
+                        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                            crit.box_velocity[d] = vel[d];
+                        }
+                        // The region is at in_box_lo/hi at start_time, or at time 0
+                        crit.box_time = (ppr.countval("start_time") > 0) ? info.m_min_time : 0.0;
+                    }
+                } else if (num_vel > 0) {
+                    Abort("box_velocity requires in_box_lo and in_box_hi for " + refinement_indicators[i]);
+                }
+
+                state_tags.push_back(crit);
+            }
+            else if (ppr.countval("value_greater")) {
                 int num_val = ppr.countval("value_greater");
                 Vector<Real> value(num_val);
                 ppr.getarr("value_greater",value,0,num_val);
-                std::string field; ppr.get("field_name",field);
+                ppr.get("field_name",field);
                 ref_tags.push_back(AMRErrorTag(value,AMRErrorTag::GREATER,field,info));
             }
             else if (ppr.countval("value_less")) {
                 int num_val = ppr.countval("value_less");
                 Vector<Real> value(num_val);
                 ppr.getarr("value_less",value,0,num_val);
-                std::string field; ppr.get("field_name",field);
+                ppr.get("field_name",field);
                 ref_tags.push_back(AMRErrorTag(value,AMRErrorTag::LESS,field,info));
             }
             else if (ppr.countval("adjacent_difference_greater")) {
                 int num_val = ppr.countval("adjacent_difference_greater");
                 Vector<Real> value(num_val);
                 ppr.getarr("adjacent_difference_greater",value,0,num_val);
-                std::string field; ppr.get("field_name",field);
+                ppr.get("field_name",field);
                 ref_tags.push_back(AMRErrorTag(value,AMRErrorTag::GRAD,field,info));
             }
             else if (realbox.ok())
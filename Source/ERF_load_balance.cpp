@@ -0,0 +1,214 @@
+/**
+ * \file ERF_load_balance.cpp
+ */
+
+/**
+ * Routines for the load balancing of the grids: the DistributionMapping of new grids,
+ * the rebalancing of existing levels with measured costs, and the sharing of the time
+ * spent in the physics modules over the boxes of a level
+*/
+
+#include <ERF.H>
+#include <ERF_Utils.H>
+#include <ERF_BoxCosts.H>
+
+#ifdef ERF_USE_WINDFARM
+#include <ERF_TurbineBins.H>
+#endif
+
+using namespace amrex;
+
+// Make the DistributionMapping for a new BoxArray at level lev
+// (overrides the virtual function in AmrMesh)
+// main.cpp --> ERF::InitData --> InitFromScratch --> MakeNewGrids --> MakeDistributionMap
+//                                       regrid  --> MakeDistributionMap (if the grids changed)
+DistributionMapping
+ERF::MakeDistributionMap (int lev, BoxArray const& ba)
+{
+    bool columns = column_grids && AllBoxesAreColumns(ba, geom[lev].Domain());
+
+    // Use the costs measured on the current grids of this level if we have any
+    Vector<Real> cost;
+    if (load_balance_on_regrid && box_costs[lev] && lev <= finest_level &&
+        box_costs[lev]->boxArray() == grids[lev])
+    {
+        Vector<Real> cost_old = gather_box_costs(*box_costs[lev]);
+        Real total_cost = 0.0;
+        for (const auto& c : cost_old) { total_cost += c; }
+        if (total_cost > 0.0) {
+            cost = remap_box_costs(cost_old, grids[lev], ba);
+        }
+    }
+    bool measured = !cost.empty();
+
+    // Grids that survive a regrid of an existing fine level stay where their data is
+    bool incremental = regrid_incremental && lev > 0 && lev <= finest_level;
+
+    if (!columns && !measured && !incremental) {
+        return AmrCore::MakeDistributionMap(lev, ba);
+    }
+
+    if (!measured) {
+        // The cost of a grid is its number of cells
+        cost.resize(ba.size());
+        for (int i = 0; i < ba.size(); i++) {
+            cost[i] = static_cast<Real>(ba[i].numPts());
+        }
+    }
+
+    DistributionMapping dm;
+    if (incremental) {
+        dm = IncrementalDistributionMapping(ba, cost, grids[lev], dmap[lev]);
+    } else if (columns) {
+        dm = ColumnDistributionMapping(ba, cost, column_grids_sfc);
+    } else if (load_balance_knapsack) {
+        dm = DistributionMapping::makeKnapSack(cost);
+    } else {
+        dm = DistributionMapping::makeSFC(cost, ba);
+    }
+
+    if (measured) {
+        Print() << "Level " << lev << " regridded with measured costs: load balance efficiency "
+                << box_cost_efficiency(cost, dm) << std::endl;
+    }
+    return dm;
+}
+
+// Redistribute the grids of each level according to the costs measured since the last
+// rebalance; the grids themselves are kept and the level is remade by RemakeLevel
+void
+ERF::load_balance ()
+{
+    BL_PROFILE("ERF::load_balance()");
+
+    // The surface layer, land surface model and turbulent perturbations keep data on the
+    //    distribution of level 0 that RemakeLevel does not rebuild
+    std::string keep_level0;
+    if (phys_bc_type[Orientation(Direction::z,Orientation::low)] == ERF_BC::MOST) {
+        keep_level0 = "MOST";
+    } else if (solverChoice.lsm_type != LandSurfaceType::None) {
+        keep_level0 = "the land surface model";
+    } else if (solverChoice.pert_type != PerturbationType::None) {
+        keep_level0 = "turbulent perturbations";
+    }
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (!box_costs[lev]) { continue; }
+
+        const BoxArray& ba = grids[lev];
+        const DistributionMapping& dm_old = dmap[lev];
+
+        Vector<Real> cost = gather_box_costs(*box_costs[lev]);
+        Real efficiency_old = box_cost_efficiency(cost, dm_old);
+
+        if (lev == 0 && !keep_level0.empty()) {
+            Print() << "Level 0 load balance efficiency " << efficiency_old
+                    << " (not rebalanced with " << keep_level0 << ")" << std::endl;
+            box_costs[lev]->setVal(0.0);
+            continue;
+        }
+
+        DistributionMapping dm_new;
+        if (column_grids && AllBoxesAreColumns(ba, geom[lev].Domain())) {
+            dm_new = ColumnDistributionMapping(ba, cost, column_grids_sfc);
+        } else if (load_balance_knapsack) {
+            dm_new = DistributionMapping::makeKnapSack(cost);
+        } else {
+            dm_new = DistributionMapping::makeSFC(cost, ba);
+        }
+        Real efficiency_new = box_cost_efficiency(cost, dm_new);
+
+        if (efficiency_new > load_balance_threshold*efficiency_old)
+        {
+            Print() << "Level " << lev << " load balance efficiency " << efficiency_old
+                    << " -> " << efficiency_new << std::endl;
+
+            RemakeLevel(lev, t_new[lev], ba, dm_new);
+            SetDistributionMap(lev, dm_new);
+
+            // The coarse side of the next level's fillpatcher and flux register
+            if (lev < finest_level) {
+                if (cf_width >= 0) {
+                    Define_ERFFillPatchers(lev+1);
+                }
+                if (solverChoice.coupling_type == CouplingType::TwoWay) {
+                    int ncomp_reflux = vars_new[0][Vars::cons].nComp();
+                    delete advflux_reg[lev+1];
+                    advflux_reg[lev+1] = new YAFluxRegister(grids[lev+1], grids[lev],
+                                                            dmap[lev+1] ,  dmap[lev],
+                                                            geom[lev+1] ,  geom[lev],
+                                                            ref_ratio[lev], lev+1, ncomp_reflux);
+                }
+            }
+        } else {
+            Print() << "Level " << lev << " load balance efficiency " << efficiency_old
+                    << " (best found " << efficiency_new << ", not rebalanced)" << std::endl;
+        }
+
+        // RemakeLevel has made new, zeroed costs if the level was rebalanced
+        box_costs[lev]->setVal(0.0);
+    }
+
+#ifdef ERF_USE_PARTICLES
+    // Move the particles of the rebalanced levels to their new ranks
+    particleData.RedistributeIfNeeded();
+#endif
+}
+
+// Share the time spent in the microphysics over the boxes of a level; cells holding
+// condensate count double
+void
+ERF::add_microphysics_costs (int lev, Real elapsed)
+{
+    const MultiFab& cons = vars_new[lev][Vars::cons];
+    Vector<Real> weight(cons.size(), 0.0);
+
+    bool has_condensate = (cons.nComp() > RhoQ3_comp);
+    for (MFIter mfi(cons, false); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        Real ncloudy = 0.0;
+        if (has_condensate) {
+            auto const& cons_arr = cons.const_array(mfi);
+            ReduceOps<ReduceOpSum> reduce_op;
+            ReduceData<Real> reduce_data(reduce_op);
+            reduce_op.eval(bx, reduce_data, [=] AMREX_GPU_DEVICE (int i, int j, int k) -> GpuTuple<Real>
+            {
+                return { (cons_arr(i,j,k,RhoQ2_comp) + cons_arr(i,j,k,RhoQ3_comp) > 0.0) ? 1.0 : 0.0 };
+            });
+            ncloudy = amrex::get<0>(reduce_data.value(reduce_op));
+        }
+        weight[mfi.index()] = static_cast<Real>(bx.numPts()) + ncloudy;
+    }
+    add_box_costs(*box_costs[lev], elapsed, weight);
+}
+
+// Share the time spent in the windfarm model over the boxes of a level according to
+// the number of cells of the sparse forcing layout they hold
+void
+ERF::add_windfarm_costs (int lev, Real elapsed)
+{
+    Vector<Real> weight(grids[lev].size(), 0.0);
+#ifdef ERF_USE_WINDFARM
+    const BoxArray& ba_wf = vars_windfarm[lev].boxArray();
+    for (int i = 0; i < ba_wf.size(); i++) {
+        weight[TurbineBins::parent_grid(grids[lev], ba_wf[i])] += static_cast<Real>(ba_wf[i].numPts());
+    }
+#endif
+    add_box_costs(*box_costs[lev], elapsed, weight);
+}
+
+// Share the time spent moving the particles over the boxes of a level according to
+// the number of particles they hold
+void
+ERF::add_particle_costs (int lev, Real elapsed)
+{
+    Vector<Real> weight(grids[lev].size(), 0.0);
+#ifdef ERF_USE_PARTICLES
+    Vector<Long> np = particleData.NumberOfParticlesInGrid(lev);
+    for (int i = 0; i < np.size(); i++) {
+        weight[i] = static_cast<Real>(np[i]);
+    }
+#endif
+    add_box_costs(*box_costs[lev], elapsed, weight);
+}
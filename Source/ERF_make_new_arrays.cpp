@@ -136,6 +136,7 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
 #ifdef ERF_USE_POISSON_SOLVE
     pp_inc[lev].define(ba, dm, 1, 1);
     pp_inc[lev].setVal(0.0);
+    terrain_poisson[lev].reset();
 #endif
 
     // ********************************************************************************************
@@ -155,6 +156,21 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
     rV_new[lev].setVal(3.4e22);
     rW_new[lev].setVal(5.6e23);
 
+    // ********************************************************************************************
+    // Source terms for the conserved variables and momenta, and the copy of the old state, used
+    //     in Advance; the sources are also zeroed in make_sources / make_mom_sources
+    // ********************************************************************************************
+    cc_source[lev].define(ba, dm, ncomp, 1);
+    xmom_source[lev].define(convert(ba, IntVect(1,0,0)), dm, 1, 1);
+    ymom_source[lev].define(convert(ba, IntVect(0,1,0)), dm, 1, 1);
+    zmom_source[lev].define(convert(ba, IntVect(0,0,1)), dm, 1, 1);
+    cons_scratch[lev].define(ba, dm, ncomp, ngrow_state);
+
+    cc_source[lev].setVal(0.0);
+    xmom_source[lev].setVal(0.0);
+    ymom_source[lev].setVal(0.0);
+    zmom_source[lev].setVal(0.0);
+
     // ********************************************************************************************
     // These are just time averaged fields for diagnostics
     // ********************************************************************************************
@@ -170,6 +186,14 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
         t_avg_cnt[lev] = 0.0;
     }
 
+    // ********************************************************************************************
+    // Measured costs of the boxes, zeroed whenever we create/re-create a level
+    // ********************************************************************************************
+    if (load_balance_int > 0 || load_balance_on_regrid) {
+        box_costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
+        box_costs[lev]->setVal(0.0);
+    }
+
     // ********************************************************************************************
     // Initialize flux registers whenever we create/re-create a level
     // ********************************************************************************************
@@ -230,17 +254,9 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
     //*********************************************************
     // Variables for Ftich model for windfarm parametrization
     //*********************************************************
-    if (solverChoice.windfarm_type == WindFarmType::Fitch){
-        vars_windfarm[lev].define(ba, dm, 5, ngrow_state); // V, dVabsdt, dudt, dvdt, dTKEdt
-        Nturb[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
-    }
-    if (solverChoice.windfarm_type == WindFarmType::EWP){
-        vars_windfarm[lev].define(ba, dm, 3, ngrow_state); // dudt, dvdt, dTKEdt
-        Nturb[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
-    }
+    // vars_windfarm and Nturb only cover the cells around the turbines and are
+    // defined in init_windfarm once the turbine locations are known
     if (solverChoice.windfarm_type == WindFarmType::SimpleAD) {
-        vars_windfarm[lev].define(ba, dm, 2, ngrow_state);// dudt, dvdt
-        Nturb[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
         SMark[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
     }
 #endif
@@ -345,7 +361,7 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
     // write out the vtk files for wind turbine location and/or
     // actuator disks
     #ifdef ERF_USE_WINDFARM
-        init_windfarm(lev);
+        init_windfarm(lev, ba, dm);
     #endif
 }
 
@@ -426,10 +442,10 @@ ERF::update_diffusive_arrays (int lev, const BoxArray& ba, const DistributionMap
     }
 
     if (l_use_kturb) {
-        eddyDiffs_lev[lev] = std::make_unique<MultiFab>(ba, dm, EddyDiff::NumDiffs, 2);
+        eddyDiffs_lev[lev] = std::make_unique<AuxMultiFab>(ba, dm, EddyDiff::NumDiffs, 2);
         eddyDiffs_lev[lev]->setVal(0.0);
         if(l_use_ddorf) {
-            SmnSmn_lev[lev] = std::make_unique<MultiFab>( ba, dm, 1, 0 );
+            SmnSmn_lev[lev] = std::make_unique<AuxMultiFab>( ba, dm, 1, 0 );
         } else {
             SmnSmn_lev[lev] = nullptr;
         }
@@ -490,10 +506,19 @@ ERF::init_zphys (int lev, Real time)
     }
 }
 
+// Fill z_phys_nd on the grids of zphys_nd (new grids at level lev) from the current grids
+// at this level and from the coarser level; at level 0 the grids are the same and only
+// their distribution has changed
 void
-ERF::remake_zphys (int lev, Real time, std::unique_ptr<MultiFab>& temp_zphys_nd)
+ERF::remake_zphys (int lev, Real time, MultiFab& zphys_nd)
 {
-    if (solverChoice.use_terrain && lev > 0) {
+    if (solverChoice.use_terrain && lev == 0) {
+
+        AMREX_ALWAYS_ASSERT(zphys_nd.boxArray() == z_phys_nd[lev]->boxArray());
+        zphys_nd.ParallelCopy(*z_phys_nd[lev], 0, 0, 1,
+                              z_phys_nd[lev]->nGrowVect(), zphys_nd.nGrowVect());
+
+    } else if (solverChoice.use_terrain && lev > 0) {
 
         Vector<MultiFab*> fmf = {z_phys_nd[lev].get(), z_phys_nd[lev].get()};
         Vector<MultiFab*> cmf = {z_phys_nd[lev-1].get(), z_phys_nd[lev-1].get()};
@@ -503,14 +528,12 @@ ERF::remake_zphys (int lev, Real time, std::unique_ptr<MultiFab>& temp_zphys_nd)
         PhysBCFunctNoOp null_bc;
         Interpolater* mapper = &node_bilinear_interp;
 
-        FillPatchTwoLevels(*temp_zphys_nd, time,
+        FillPatchTwoLevels(zphys_nd, time,
                            cmf, ctime, fmf, ftime,
                            0, 0, 1, geom[lev-1], geom[lev],
                            null_bc, 0, null_bc, 0, refRatio(lev-1),
                            mapper, domain_bcs_type, 0);
 
-        std::swap(temp_zphys_nd, z_phys_nd[lev]);
-
     } // use_terrain && lev > 0
 }
 
@@ -519,8 +542,34 @@ ERF::update_terrain_arrays (int lev)
 {
     if (solverChoice.use_terrain) {
         make_J(geom[lev],*z_phys_nd[lev],*detJ_cc[lev]);
-        make_areas(geom[lev],*z_phys_nd[lev],*ax[lev],*ay[lev],*az[lev]);
         make_zcc(geom[lev],*z_phys_nd[lev],*z_phys_cc[lev]);
+
+        // The face areas of the base level can be recomputed in the kernels from the
+        //    surface height and the level table rather than stored
+        compact_terrain[lev].reset();
+        if (lev == 0 && solverChoice.compact_terrain_metrics) {
+            compact_terrain[lev] = std::make_unique<CompactTerrain>();
+            if (compact_terrain[lev]->define(geom[lev],*z_phys_nd[lev],zlevels_stag)) {
+                ax[lev].reset();
+                ay[lev].reset();
+                az[lev].reset();
+                Print() << "Using compact terrain metrics on level " << lev << std::endl;
+                return;
+            }
+            Warning("Terrain is not a blend of the surface and the level table; storing the face areas");
+            compact_terrain[lev].reset();
+        }
+        if (!ax[lev]) {
+            const BoxArray& ba = detJ_cc[lev]->boxArray();
+            const DistributionMapping& dm = detJ_cc[lev]->DistributionMap();
+            ax[lev] = std::make_unique<MultiFab>(convert(ba,IntVect(1,0,0)),dm,1,1);
+            ay[lev] = std::make_unique<MultiFab>(convert(ba,IntVect(0,1,0)),dm,1,1);
+            az[lev] = std::make_unique<MultiFab>(convert(ba,IntVect(0,0,1)),dm,1,1);
+            ax[lev]->setVal(1.0);
+            ay[lev]->setVal(1.0);
+            az[lev]->setVal(1.0);
+        }
+        make_areas(geom[lev],*z_phys_nd[lev],*ax[lev],*ay[lev],*az[lev]);
     }
 }
 
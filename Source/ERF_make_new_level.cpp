@@ -27,6 +27,13 @@ using namespace amrex;
 void ERF::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& ba,
                                    const DistributionMapping& dm)
 {
+    // The column physics (terrain, base state, surface layer) relies on this so that it
+    //    never has to copy to a temporary column decomposition
+    if (column_grids && lev == 0) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(AllBoxesAreColumns(ba, geom[lev].Domain()),
+                                         "erf.column_grids requires level 0 grids that span the full height");
+    }
+
     // Set BoxArray grids and DistributionMapping dmap in AMReX_AmrMesh.H class
     SetBoxArray(lev, ba);
     SetDistributionMap(lev, dm);
@@ -228,6 +235,9 @@ void ERF::MakeNewLevelFromScratch (int lev, Real time, const BoxArray& ba,
         micro->Init(lev, vars_new[lev][Vars::cons],
                     grids[lev], Geom(lev), 0.0,
                     z_phys_nd[lev], detJ_cc[lev]); // dummy dt value
+        if (solverChoice.anelastic) {
+            micro->Set_Reference_State(lev, &base_state[lev]);
+        }
     }
     for (int mvar(0); mvar<qmoist[lev].size(); ++mvar) {
         qmoist[lev][mvar] = micro->Get_Qmoist_Ptr(lev,mvar);
@@ -288,6 +298,10 @@ ERF::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
     // Make sure that detJ and z_phys_cc are the average of the data on a finer level if there is one
     //
     if (solverChoice.use_terrain != 0) {
+        if (lev < finest_level) {
+            average_down(  *detJ_cc[lev+1],   *detJ_cc[lev], 0, 1, refRatio(lev));
+            average_down(*z_phys_cc[lev+1], *z_phys_cc[lev], 0, 1, refRatio(lev));
+        }
         for (int crse_lev = lev-1; crse_lev >= 0; crse_lev--) {
             average_down(  *detJ_cc[crse_lev+1],   *detJ_cc[crse_lev], 0, 1, refRatio(crse_lev));
             average_down(*z_phys_cc[crse_lev+1], *z_phys_cc[crse_lev], 0, 1, refRatio(crse_lev));
@@ -305,6 +319,9 @@ ERF::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
         micro->Init(lev, vars_new[lev][Vars::cons],
                     grids[lev], Geom(lev), 0.0,
                     z_phys_nd[lev], detJ_cc[lev]); // dummy dt value
+        if (solverChoice.anelastic) {
+            micro->Set_Reference_State(lev, &base_state[lev]);
+        }
     }
     for (int mvar(0); mvar<qmoist[lev].size(); ++mvar) {
         qmoist[lev][mvar] = micro->Get_Qmoist_Ptr(lev,mvar);
@@ -368,16 +385,52 @@ ERF::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
 #endif
 }
 
+// Copy whole FABs, ghost cells included, from src into dst: index[i] is the grid of src that
+// is copied into grid i of dst (or -1 for none), and must live on the same rank
+static void
+copy_fabs (MultiFab& dst, const MultiFab& src, const Vector<int>& index)
+{
+    const IntVect ng = min(dst.nGrowVect(), src.nGrowVect());
+    const int ncomp = dst.nComp();
+    for (MFIter mfi(dst); mfi.isValid(); ++mfi)
+    {
+        int isrc = index[mfi.index()];
+        if (isrc < 0) { continue; }
+        AMREX_ASSERT(src.boxArray()[isrc] == dst.boxArray()[mfi.index()]);
+
+        const Box bx = grow(mfi.validbox(), ng);
+        auto const& src_arr = src.const_array(isrc);
+        auto const& dst_arr = dst.array(mfi);
+        ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            dst_arr(i,j,k,n) = src_arr(i,j,k,n);
+        });
+    }
+}
+
+// Move a field, ghost cells included, onto the distribution dm of the same grids
+template <class MF>
+static void
+redistribute_on (std::unique_ptr<MF>& mf, const DistributionMapping& dm)
+{
+    if (!mf) { return; }
+    auto mf_new = std::make_unique<MF>(mf->boxArray(), dm, mf->nComp(), mf->nGrowVect());
+    mf_new->ParallelCopy(*mf, 0, 0, mf->nComp(), mf->nGrowVect(), mf->nGrowVect());
+    mf = std::move(mf_new);
+}
+
 // Remake an existing level using provided BoxArray and DistributionMapping and
 // fill with existing fine and coarse data (overrides the pure virtual function in AmrCore)
 // regrid  --> RemakeLevel            (if level already existed)
 // regrid  --> MakeNewLevelFromCoarse (if adding new level)
+// load_balance --> RemakeLevel       (same grids, new distribution; also at level 0)
 void
 ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapping& dm)
 {
     amrex::Print() <<" REMAKING WITH NEW BA AT LEVEL " << lev << " " << ba << std::endl;
 
-    AMREX_ALWAYS_ASSERT(lev > 0);
+    // Level 0 has no coarser level to fill from, so only its distribution can change
+    AMREX_ALWAYS_ASSERT(lev > 0 || ba == grids[lev]);
     AMREX_ALWAYS_ASSERT(solverChoice.terrain_type != TerrainType::Moving);
 
     BoxArray            ba_old(vars_new[lev][Vars::cons].boxArray());
@@ -391,28 +444,165 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
     // int ngrow_state = ComputeGhostCells(solverChoice.advChoice, solverChoice.use_NumDiff) + 1;
     int ngrow_vels  = ComputeGhostCells(solverChoice.advChoice, solverChoice.use_NumDiff);
 
+    // ********************************************************************************************
+    // With incremental regridding, the grids that are unchanged and still on the same rank keep
+    //    their data: keep_index holds their index in the old grids. Only the other grids, which
+    //    make up ba_fill (fill_index holds their index there), are filled from the old fine data
+    //    and by interpolation from the coarser level.
+    // ********************************************************************************************
+    Vector<int> keep_index(ba.size(), -1);
+    Vector<int> fill_index(ba.size(), -1);
+    BoxArray            ba_fill;
+    DistributionMapping dm_fill;
+    bool incremental = false;
+
+    if (regrid_incremental && lev > 0) {
+        Vector<int> old_index = MatchingBoxes(ba, ba_old);
+        BoxList bl_fill;
+        Vector<int> pmap_fill;
+        for (int i = 0; i < ba.size(); ++i) {
+            if (old_index[i] >= 0 && dm_old[old_index[i]] == dm[i]) {
+                keep_index[i] = old_index[i];
+            } else {
+                fill_index[i] = static_cast<int>(pmap_fill.size());
+                bl_fill.push_back(ba[i]);
+                pmap_fill.push_back(dm[i]);
+            }
+        }
+        int nkeep = static_cast<int>(ba.size() - pmap_fill.size());
+        incremental = (nkeep > 0);
+        if (incremental) {
+            amrex::Print() << "Regridding level " << lev << " incrementally: keeping " << nkeep
+                           << " of " << ba.size() << " grids" << std::endl;
+            if (!pmap_fill.empty()) {
+                ba_fill = BoxArray(std::move(bl_fill));
+                dm_fill = DistributionMapping(std::move(pmap_fill));
+            }
+        }
+    }
+    bool have_fill = incremental && !ba_fill.empty();
+
     Vector<MultiFab> temp_lev_new(Vars::NumTypes);
     Vector<MultiFab> temp_lev_old(Vars::NumTypes);
     MultiFab temp_base_state;
 
     std::unique_ptr<MultiFab> temp_zphys_nd;
 
+    // init_stuff replaces the metric terms, which the kept grids copy from
+    std::unique_ptr<MultiFab> detJ_cc_old, z_phys_cc_old, ax_old, ay_old, az_old;
+    if (incremental && solverChoice.use_terrain) {
+        detJ_cc_old   = std::move(detJ_cc[lev]);
+        z_phys_cc_old = std::move(z_phys_cc[lev]);
+        ax_old        = std::move(ax[lev]);
+        ay_old        = std::move(ay[lev]);
+        az_old        = std::move(az[lev]);
+    }
+
+    // At level 0 the map factors, land mask and pressure increment come from the initial data
+    //    (or a checkpoint) and cannot be rebuilt, so they are moved to the new distribution
+    std::unique_ptr<MultiFab> mapfac_m_old, mapfac_u_old, mapfac_v_old;
+    Vector<std::unique_ptr<iMultiFab>> lmask_old;
+#ifdef ERF_USE_POISSON_SOLVE
+    MultiFab pp_inc_old;
+#endif
+    if (lev == 0) {
+        mapfac_m_old = std::move(mapfac_m[lev]);
+        mapfac_u_old = std::move(mapfac_u[lev]);
+        mapfac_v_old = std::move(mapfac_v[lev]);
+        lmask_old    = std::move(lmask_lev[lev]);
+#ifdef ERF_USE_POISSON_SOLVE
+        std::swap(pp_inc_old, pp_inc[lev]);
+#endif
+    }
+
     //********************************************************************************************
     // This allocates all kinds of things, including but not limited to: solution arrays,
     //      terrain arrays and metrics, and base state.
     // *******************************************************************************************
     init_stuff(lev, ba, dm, temp_lev_new, temp_lev_old, temp_base_state, temp_zphys_nd);
 
+    if (lev == 0) {
+        mapfac_m[lev] = std::move(mapfac_m_old);
+        mapfac_u[lev] = std::move(mapfac_u_old);
+        mapfac_v[lev] = std::move(mapfac_v_old);
+        redistribute_on(mapfac_m[lev], dm);
+        redistribute_on(mapfac_u[lev], dm);
+        redistribute_on(mapfac_v[lev], dm);
+
+        lmask_lev[lev] = std::move(lmask_old);
+        for (auto& lmask : lmask_lev[lev]) {
+            redistribute_on(lmask, dm);
+        }
+        for (auto& sst : sst_lev[lev]) {
+            redistribute_on(sst, dm);
+        }
+
+        redistribute_on(lat_m[lev], dm);
+        redistribute_on(lon_m[lev], dm);
+
+        redistribute_on(thin_xforce[lev], dm);
+        redistribute_on(thin_yforce[lev], dm);
+        redistribute_on(thin_zforce[lev], dm);
+        redistribute_on(xflux_imask[lev], dm);
+        redistribute_on(yflux_imask[lev], dm);
+        redistribute_on(zflux_imask[lev], dm);
+
+#ifdef ERF_USE_POISSON_SOLVE
+        pp_inc[lev].ParallelCopy(pp_inc_old, 0, 0, 1, pp_inc_old.nGrowVect(), pp_inc[lev].nGrowVect());
+#endif
+    }
+
     // ********************************************************************************************
     // Build the data structures for terrain-related quantities
     // ********************************************************************************************
-    remake_zphys(lev, time, temp_zphys_nd);
-    update_terrain_arrays(lev);
+    if (solverChoice.use_terrain) {
+        if (incremental) {
+            copy_fabs(*temp_zphys_nd, *z_phys_nd[lev], keep_index);
+
+            MultiFab zphys_fill;
+            if (have_fill) {
+                zphys_fill.define(convert(ba_fill,IntVect(1,1,1)), dm_fill, 1, temp_zphys_nd->nGrowVect());
+                remake_zphys(lev, time, zphys_fill);
+                copy_fabs(*temp_zphys_nd, zphys_fill, fill_index);
+            }
+            std::swap(temp_zphys_nd, z_phys_nd[lev]);
+
+            copy_fabs(  *detJ_cc[lev],   *detJ_cc_old, keep_index);
+            copy_fabs(*z_phys_cc[lev], *z_phys_cc_old, keep_index);
+            copy_fabs(       *ax[lev],        *ax_old, keep_index);
+            copy_fabs(       *ay[lev],        *ay_old, keep_index);
+            copy_fabs(       *az[lev],        *az_old, keep_index);
+
+            if (have_fill) {
+                MultiFab detJ_fill(ba_fill, dm_fill, 1, 1);
+                MultiFab  zcc_fill(ba_fill, dm_fill, 1, 1);
+                MultiFab   ax_fill(convert(ba_fill,IntVect(1,0,0)), dm_fill, 1, 1);
+                MultiFab   ay_fill(convert(ba_fill,IntVect(0,1,0)), dm_fill, 1, 1);
+                MultiFab   az_fill(convert(ba_fill,IntVect(0,0,1)), dm_fill, 1, 1);
+                make_J    (geom[lev], zphys_fill, detJ_fill);
+                make_zcc  (geom[lev], zphys_fill, zcc_fill);
+                make_areas(geom[lev], zphys_fill, ax_fill, ay_fill, az_fill);
+                copy_fabs(  *detJ_cc[lev], detJ_fill, fill_index);
+                copy_fabs(*z_phys_cc[lev],  zcc_fill, fill_index);
+                copy_fabs(       *ax[lev],   ax_fill, fill_index);
+                copy_fabs(       *ay[lev],   ay_fill, fill_index);
+                copy_fabs(       *az[lev],   az_fill, fill_index);
+            }
+        } else {
+            remake_zphys(lev, time, *temp_zphys_nd);
+            std::swap(temp_zphys_nd, z_phys_nd[lev]);
+            update_terrain_arrays(lev);
+        }
+    }
 
     //
     // Make sure that detJ and z_phys_cc are the average of the data on a finer level if there is one
     //
     if (solverChoice.use_terrain != 0) {
+        if (lev < finest_level) {
+            average_down(  *detJ_cc[lev+1],   *detJ_cc[lev], 0, 1, refRatio(lev));
+            average_down(*z_phys_cc[lev+1], *z_phys_cc[lev], 0, 1, refRatio(lev));
+        }
         for (int crse_lev = lev-1; crse_lev >= 0; crse_lev--) {
             average_down(  *detJ_cc[crse_lev+1],   *detJ_cc[crse_lev], 0, 1, refRatio(crse_lev));
             average_down(*z_phys_cc[crse_lev+1], *z_phys_cc[crse_lev], 0, 1, refRatio(crse_lev));
@@ -427,10 +617,34 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
     // ********************************************************************************************
     // This will fill the temporary MultiFabs with data from vars_new
     // ********************************************************************************************
-    FillPatch(lev, time, {&temp_lev_new[Vars::cons],&temp_lev_new[Vars::xvel],
-                          &temp_lev_new[Vars::yvel],&temp_lev_new[Vars::zvel]},
-                         {&temp_lev_new[Vars::cons],&rU_new[lev],&rV_new[lev],&rW_new[lev]},
-                          false);
+    if (incremental) {
+        // The kept grids keep their ghost cells too; all ghost cells are filled again by the
+        //    FillPatch at the start of the next advance
+        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+            copy_fabs(temp_lev_new[var_idx], vars_new[lev][var_idx], keep_index);
+        }
+        if (have_fill) {
+            Vector<MultiFab> fill_lev_new(Vars::NumTypes);
+            fill_lev_new[Vars::cons].define(ba_fill, dm_fill, ncomp_cons, ngrow_state);
+            fill_lev_new[Vars::xvel].define(convert(ba_fill, IntVect(1,0,0)), dm_fill, 1, ngrow_vels);
+            fill_lev_new[Vars::yvel].define(convert(ba_fill, IntVect(0,1,0)), dm_fill, 1, ngrow_vels);
+            fill_lev_new[Vars::zvel].define(convert(ba_fill, IntVect(0,0,1)), dm_fill, 1, ngrow_vels);
+
+            FillPatch(lev, time, {&fill_lev_new[Vars::cons],&fill_lev_new[Vars::xvel],
+                                  &fill_lev_new[Vars::yvel],&fill_lev_new[Vars::zvel]},
+                                 {&fill_lev_new[Vars::cons],&rU_new[lev],&rV_new[lev],&rW_new[lev]},
+                                  false);
+
+            for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx) {
+                copy_fabs(temp_lev_new[var_idx], fill_lev_new[var_idx], fill_index);
+            }
+        }
+    } else {
+        FillPatch(lev, time, {&temp_lev_new[Vars::cons],&temp_lev_new[Vars::xvel],
+                              &temp_lev_new[Vars::yvel],&temp_lev_new[Vars::zvel]},
+                             {&temp_lev_new[Vars::cons],&rU_new[lev],&rV_new[lev],&rW_new[lev]},
+                              false);
+    }
 
     // ********************************************************************************************
     // Update the base state at this level by interpolation from coarser level AND copy
@@ -447,11 +661,29 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
         Vector<MultiFab*> cmf = {&base_state[lev-1], &base_state[lev-1]};
         Vector<Real> ftime    = {time, time};
         Vector<Real> ctime    = {time, time};
-        FillPatchTwoLevels(temp_base_state, time,
-                           cmf, ctime, fmf, ftime,
-                           icomp, icomp, ncomp, geom[lev-1], geom[lev],
-                           null_bc, 0, null_bc, 0, refRatio(lev-1),
-                           mapper, domain_bcs_type, bccomp);
+        if (incremental) {
+            copy_fabs(temp_base_state, base_state[lev], keep_index);
+            if (have_fill) {
+                MultiFab base_state_fill(ba_fill, dm_fill, ncomp, temp_base_state.nGrowVect());
+                FillPatchTwoLevels(base_state_fill, time,
+                                   cmf, ctime, fmf, ftime,
+                                   icomp, icomp, ncomp, geom[lev-1], geom[lev],
+                                   null_bc, 0, null_bc, 0, refRatio(lev-1),
+                                   mapper, domain_bcs_type, bccomp);
+                copy_fabs(temp_base_state, base_state_fill, fill_index);
+            }
+        } else {
+            FillPatchTwoLevels(temp_base_state, time,
+                               cmf, ctime, fmf, ftime,
+                               icomp, icomp, ncomp, geom[lev-1], geom[lev],
+                               null_bc, 0, null_bc, 0, refRatio(lev-1),
+                               mapper, domain_bcs_type, bccomp);
+        }
+        std::swap(temp_base_state, base_state[lev]);
+    } else {
+        // The base state at level 0 only moves to the new distribution
+        temp_base_state.ParallelCopy(base_state[lev], 0, 0, base_state[lev].nComp(),
+                                     base_state[lev].nGrowVect(), temp_base_state.nGrowVect());
         std::swap(temp_base_state, base_state[lev]);
     }
 
@@ -490,6 +722,9 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
         micro->Init(lev, vars_new[lev][Vars::cons],
                     grids[lev], Geom(lev), 0.0,
                     z_phys_nd[lev], detJ_cc[lev]); // dummy dt value
+        if (solverChoice.anelastic) {
+            micro->Set_Reference_State(lev, &base_state[lev]);
+        }
     }
     for (int mvar(0); mvar<qmoist[lev].size(); ++mvar) {
         qmoist[lev][mvar] = micro->Get_Qmoist_Ptr(lev,mvar);
@@ -509,9 +744,8 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
         }
     }
 
-#ifdef ERF_USE_PARTICLES
-    particleData.Redistribute();
-#endif
+    // The particles are redistributed by the caller once the new grids and distribution
+    // have been set (AmrCore sets them only after RemakeLevel returns)
 }
 
 //
@@ -534,8 +768,15 @@ ERF::ClearLevel (int lev)
     rW_new[lev].clear();
     rW_old[lev].clear();
 
+    cc_source[lev].clear();
+    xmom_source[lev].clear();
+    ymom_source[lev].clear();
+    zmom_source[lev].clear();
+    cons_scratch[lev].clear();
+
 #ifdef ERF_USE_POISSON_SOLVE
     pp_inc[lev].clear();
+    terrain_poisson[lev].reset();
 #endif
 
     // Clears the integrator memory
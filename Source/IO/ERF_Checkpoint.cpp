@@ -144,7 +144,8 @@ ERF::WriteCheckpointFile () const
 
          // We must read and write qmoist with ghost cells because we don't directly impose BCs on these vars
          // Write the precipitation accumulation component only
-        if (solverChoice.moisture_type == MoistureType::Kessler) {
+        if (solverChoice.moisture_type == MoistureType::Kessler ||
+            (solverChoice.moisture_type == MoistureType::SuperDroplets && lev == 0)) {
             ng = qmoist[lev][4]->nGrowVect();
             int nvar = 1;
             MultiFab moist_vars(grids[lev],dmap[lev],nvar,ng);
@@ -174,10 +175,13 @@ ERF::WriteCheckpointFile () const
 #if defined(ERF_USE_WINDFARM)
         if(solverChoice.windfarm_type == WindFarmType::Fitch or
            solverChoice.windfarm_type == WindFarmType::EWP or
-           solverChoice.windfarm_type == WindFarmType::SimpleAD){
+           solverChoice.windfarm_type == WindFarmType::SimpleAD or
+           solverChoice.windfarm_type == WindFarmType::GeneralAD){
+            // Nturb only covers the cells around the turbines; write it on the full grids
             ng = Nturb[lev].nGrowVect();
             MultiFab mf_Nturb(grids[lev],dmap[lev],1,ng);
-            MultiFab::Copy(mf_Nturb,Nturb[lev],0,0,1,ng);
+            mf_Nturb.setVal(0.0);
+            mf_Nturb.ParallelCopy(Nturb[lev],0,0,1);
             VisMF::Write(mf_Nturb, amrex::MultiFabFileFullPrefix(lev, checkpointname, "Level_", "NumTurb"));
         }
 #endif
@@ -229,6 +233,15 @@ ERF::WriteCheckpointFile () const
         }
     }
 
+#if defined(ERF_USE_WINDFARM)
+   // Yaw and azimuth of the resolved rotors
+   if (solverChoice.windfarm_type == WindFarmType::GeneralAD && ParallelDescriptor::IOProcessor()) {
+       std::ofstream rotor_file(checkpointname + "/RotorState");
+       rotor_file.precision(17);
+       windfarm->write_rotor_state(rotor_file);
+   }
+#endif
+
 #ifdef ERF_USE_PARTICLES
    particleData.Checkpoint(checkpointname);
 #endif
@@ -359,7 +372,7 @@ ERF::ReadCheckpointFile ()
         GotoNextLine(is);
 
         // create a distribution mapping
-        DistributionMapping dm { ba, ParallelDescriptor::NProcs() };
+        DistributionMapping dm = MakeDistributionMap(lev, ba);
 
         MakeNewLevelFromScratch (lev, t_new[lev], ba, dm);
     }
@@ -409,7 +422,8 @@ ERF::ReadCheckpointFile ()
         }
 
         // Read in the precipitation accumulation component
-        if (solverChoice.moisture_type == MoistureType::Kessler) {
+        if (solverChoice.moisture_type == MoistureType::Kessler ||
+            (solverChoice.moisture_type == MoistureType::SuperDroplets && lev == 0)) {
             ng = qmoist[lev][4]->nGrowVect();
             int nvar = 1;
             MultiFab moist_vars(grids[lev],dmap[lev],nvar,ng);
@@ -439,11 +453,13 @@ ERF::ReadCheckpointFile ()
 #if defined(ERF_USE_WINDFARM)
         if(solverChoice.windfarm_type == WindFarmType::Fitch or
            solverChoice.windfarm_type == WindFarmType::EWP or
-           solverChoice.windfarm_type == WindFarmType::SimpleAD){
+           solverChoice.windfarm_type == WindFarmType::SimpleAD or
+           solverChoice.windfarm_type == WindFarmType::GeneralAD){
             ng = Nturb[lev].nGrowVect();
             MultiFab mf_Nturb(grids[lev],dmap[lev],1,ng);
             VisMF::Read(mf_Nturb, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, "Level_", "NumTurb"));
-            MultiFab::Copy(Nturb[lev],mf_Nturb,0,0,1,ng);
+            Nturb[lev].ParallelCopy(mf_Nturb,0,0,1);
+            Nturb[lev].FillBoundary(geom[lev].periodicity());
         }
 #endif
 
@@ -482,7 +498,23 @@ ERF::ReadCheckpointFile ()
         MultiFab::Copy(*mapfac_v[lev],mf_v,0,0,1,ng);
     }
 
+#if defined(ERF_USE_WINDFARM)
+    if (solverChoice.windfarm_type == WindFarmType::GeneralAD) {
+        Vector<char> rotorCharPtr;
+        ParallelDescriptor::ReadAndBcastFile(restart_chkfile + "/RotorState", rotorCharPtr);
+        std::istringstream rotor_is(std::string(rotorCharPtr.dataPtr()), std::istringstream::in);
+        windfarm->read_rotor_state(rotor_is);
+    }
+#endif
+
 #ifdef ERF_USE_PARTICLES
+   // The particles of a Lagrangian moisture model carry extra components, so the model
+   // reads them itself rather than through a generic container
+   if (Microphysics::modelType(solverChoice.moisture_type) == MoistureModelType::Lagrangian) {
+       auto& lagr_micro( dynamic_cast<LagrangianMicrophysics&>(*micro) );
+       lagr_micro.Restart(restart_chkfile);
+       particleData.getNamesUnalloc().remove(lagr_micro.getName());
+   }
    particleData.Restart((ParGDBBase*)GetParGDB(),restart_chkfile);
 #endif
 
@@ -187,7 +187,7 @@ ERF::ReadNCCheckpointFile ()
 //        GotoNextLine(is);
 
         // create a distribution mapping
-        DistributionMapping dm { ba, ParallelDescriptor::NProcs() };
+        DistributionMapping dm = MakeDistributionMap(lev, ba);
 
         // set BoxArray grids and DistributionMapping dmap in AMReX_AmrMesh.H class
         SetBoxArray(lev, ba);
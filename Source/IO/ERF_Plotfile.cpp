@@ -191,6 +191,12 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
         }
     }
 
+#ifdef ERF_USE_PARTICLES
+    // Particles may have been left outside their tiles by up to the redistribution
+    // slack; the particle counts and mesh deposits below need them on their own grids
+    particleData.Redistribute();
+#endif
+
     // Vector of MultiFabs for cell-centered data
     Vector<MultiFab> mf(finest_level+1);
     for (int lev = 0; lev <= finest_level; ++lev) {
@@ -432,6 +438,10 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
 #ifdef ERF_USE_WINDFARM
         if (containerHasElement(plot_var_names, "num_turb"))
         {
+            // Nturb only covers the cells around the turbines
+            MultiFab Nturb_full(grids[lev], dmap[lev], 1, 0);
+            Nturb_full.setVal(0.0);
+            Nturb_full.ParallelCopy(Nturb[lev], 0, 0, 1);
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -439,7 +449,7 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
             {
                 const Box& bx = mfi.tilebox();
                 const Array4<Real>& derdat  = mf[lev].array(mfi);
-                const Array4<Real const>& Nturb_array = Nturb[lev].const_array(mfi);
+                const Array4<Real const>& Nturb_array = Nturb_full.const_array(mfi);
                 ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
                     derdat(i, j, k, mf_comp) = Nturb_array(i,j,k,0);
                 });
@@ -892,23 +902,23 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
         }
 
         if (containerHasElement(plot_var_names, "Kmv")) {
-            MultiFab::Copy(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Mom_v,mf_comp,1,0);
+            CopyAuxToMultiFab(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Mom_v,mf_comp,1,0);
             mf_comp ++;
         }
         if (containerHasElement(plot_var_names, "Kmh")) {
-            MultiFab::Copy(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Mom_h,mf_comp,1,0);
+            CopyAuxToMultiFab(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Mom_h,mf_comp,1,0);
             mf_comp ++;
         }
         if (containerHasElement(plot_var_names, "Khv")) {
-            MultiFab::Copy(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Theta_v,mf_comp,1,0);
+            CopyAuxToMultiFab(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Theta_v,mf_comp,1,0);
             mf_comp ++;
         }
         if (containerHasElement(plot_var_names, "Khh")) {
-            MultiFab::Copy(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Theta_h,mf_comp,1,0);
+            CopyAuxToMultiFab(mf[lev],*eddyDiffs_lev[lev],EddyDiff::Theta_h,mf_comp,1,0);
             mf_comp ++;
         }
         if (containerHasElement(plot_var_names, "Lpbl")) {
-            MultiFab::Copy(mf[lev],*eddyDiffs_lev[lev],EddyDiff::PBL_lengthscale,mf_comp,1,0);
+            CopyAuxToMultiFab(mf[lev],*eddyDiffs_lev[lev],EddyDiff::PBL_lengthscale,mf_comp,1,0);
             mf_comp ++;
         }
 
@@ -1023,6 +1033,19 @@ ERF::WritePlotFile (int which, Vector<std::string> plot_var_names)
                 mf_comp += 1;
             }
         }
+        else if(solverChoice.moisture_type == MoistureType::SuperDroplets)
+        {
+            // Only the base level carries the Lagrangian moisture model
+            if (containerHasElement(plot_var_names, "rain_accum"))
+            {
+                if (lev == 0) {
+                    MultiFab::Copy(mf[lev],*(qmoist[lev][4]),0,mf_comp,1,0);
+                } else {
+                    mf[lev].setVal(0.0,mf_comp,1,0);
+                }
+                mf_comp += 1;
+            }
+        }
         else if(solverChoice.moisture_type == MoistureType::SAM)
         {
             if (containerHasElement(plot_var_names, "rain_accum"))
@@ -240,6 +240,8 @@ ERF::initHSE (int lev)
 
     } else {
 
+        // The grids do not hold whole columns (see erf.column_grids), so integrate
+        // on a temporary column decomposition
         BoxArray ba_new(domain);
 
         ChopGrids2D(ba_new, domain, ParallelDescriptor::NProcs());
@@ -15,7 +15,7 @@ using namespace amrex;
 // Explicit instantiation
 
 void
-ERF::init_windfarm (int lev)
+ERF::init_windfarm (int lev, const BoxArray& ba, const DistributionMapping& dm)
 {
     if(solverChoice.windfarm_loc_type == WindFarmLocType::lat_lon) {
         windfarm->read_tables(solverChoice.windfarm_loc_table,
@@ -28,6 +28,26 @@ ERF::init_windfarm (int lev)
                              true, false);
     }
 
+    // The forcing fields live on the pieces of the grids near the actuator disks
+    // (SimpleAD, GeneralAD) or the turbine columns (Fitch, EWP)
+    BoxArray ba_wf;
+    DistributionMapping dm_wf;
+    bool all_k = (solverChoice.windfarm_type == WindFarmType::Fitch ||
+                  solverChoice.windfarm_type == WindFarmType::EWP);
+    windfarm->build_turb_bins(geom[lev]).sparse_layout(ba, dm, windfarm->forcing_halo(geom[lev]),
+                                                       all_k, ba_wf, dm_wf);
+
+    int ncomp_wf = 2; // SimpleAD: dudt, dvdt
+    if (solverChoice.windfarm_type == WindFarmType::Fitch) {
+        ncomp_wf = 5;  // V, dVabsdt, dudt, dvdt, dTKEdt
+    } else if (solverChoice.windfarm_type == WindFarmType::EWP) {
+        ncomp_wf = 3;  // dudt, dvdt, dTKEdt
+    } else if (solverChoice.windfarm_type == WindFarmType::GeneralAD) {
+        ncomp_wf = 3;  // dudt, dvdt, dwdt
+    }
+    vars_windfarm[lev].define(ba_wf, dm_wf, ncomp_wf, 1);
+    Nturb[lev].define(ba_wf, dm_wf, 1, 1); // Number of turbines in a cell
+
     windfarm->fill_Nturb_multifab(geom[lev], Nturb[lev]);
 
     windfarm->write_turbine_locations_vtk();
@@ -80,6 +80,9 @@ void Kessler::Copy_State_to_Micro (const MultiFab& cons_in)
         auto tabs_array  = mic_fab_vars[MicVar_Kess::tabs]->array(mfi);
         auto pres_array  = mic_fab_vars[MicVar_Kess::pres]->array(mfi);
 
+        // Anelastic: temperature and pressure follow the reference state (p_0, pi_0)
+        const auto p0_array = (m_base_state) ? m_base_state->const_array(mfi) : Array4<const Real>{};
+
         // Get pressure, theta, temperature, density, and qt, qp
         ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
@@ -90,10 +93,15 @@ void Kessler::Copy_State_to_Micro (const MultiFab& cons_in)
             qp_array(i,j,k)    = states_array(i,j,k,RhoQ3_comp)/states_array(i,j,k,Rho_comp);
             qt_array(i,j,k)    = qv_array(i,j,k) + qc_array(i,j,k);
 
-            tabs_array(i,j,k)  = getTgivenRandRTh(states_array(i,j,k,Rho_comp),
-                                                  states_array(i,j,k,RhoTheta_comp),
-                                                  qv_array(i,j,k));
-            pres_array(i,j,k)  = getPgivenRTh(states_array(i,j,k,RhoTheta_comp), qv_array(i,j,k))/100.;
+            if (p0_array) {
+                tabs_array(i,j,k)  = theta_array(i,j,k) * p0_array(i,j,k,2);
+                pres_array(i,j,k)  = p0_array(i,j,k,1)/100.;
+            } else {
+                tabs_array(i,j,k)  = getTgivenRandRTh(states_array(i,j,k,Rho_comp),
+                                                      states_array(i,j,k,RhoTheta_comp),
+                                                      qv_array(i,j,k));
+                pres_array(i,j,k)  = getPgivenRTh(states_array(i,j,k,RhoTheta_comp), qv_array(i,j,k))/100.;
+            }
         });
     }
 }
@@ -1,5 +1,6 @@
 #include <ERF_EOS.H>
 #include <ERF_TileNoZ.H>
+#include <ERF_Utils.H>
 #include "ERF_Kessler.H"
 #include "ERF_DataStruct.H"
 
@@ -24,7 +25,11 @@ void Kessler::AdvanceKessler (const SolverChoice &solverChoice)
 
         Real dtn = dt;
 
-        for ( MFIter mfi(fz, TilingIfNotGPU()); mfi.isValid(); ++mfi ){
+        // With implicit sedimentation the fall is done in a separate column sweep below
+        bool implicit_sed = solverChoice.use_implicit_sedimentation;
+        if (implicit_sed) fz.setVal(0.);
+
+        for ( MFIter mfi(fz, TilingIfNotGPU()); mfi.isValid() && !implicit_sed; ++mfi ){
             auto rho_array = mic_fab_vars[MicVar_Kess::rho]->array(mfi);
             auto qp_array  = mic_fab_vars[MicVar_Kess::qp]->array(mfi);
             auto rain_accum_array = mic_fab_vars[MicVar_Kess::rain_accum]->array(mfi);
@@ -179,6 +184,77 @@ void Kessler::AdvanceKessler (const SolverChoice &solverChoice)
                 qt_array(i,j,k) = qv_array(i,j,k) + qc_array(i,j,k);
             });
         }
+
+        if (implicit_sed) {
+            // NOTE: Backward-Euler upwind update with the terminal velocity of each
+            //       cell lagged at the old time. The flux through the bottom face of
+            //       a cell only depends on that cell, so a column is solved exactly
+            //       by a single downward sweep from the model top, through which
+            //       nothing falls in. The update is unconditionally stable, positive
+            //       and mass conservative.
+            //
+            //       The sweep needs whole columns. When the grids are split in the
+            //       vertical, rho, qp, detJ and the accumulation are gathered on
+            //       full-height grids first, so the inflow through every internal
+            //       grid face is the new-time flux out of the cell above.
+            const bool columns = AllBoxesAreColumns(ba, domain);
+            BoxArray            col_ba = (columns) ? ba : ColumnBoxArray(ba, domain);
+            DistributionMapping col_dm = (columns) ? dm : DistributionMapping(col_ba);
+
+            MultiFab col(col_ba, col_dm, 4, 0);
+            col.setVal(0.0);
+            col.ParallelCopy(*mic_fab_vars[MicVar_Kess::rho], 0, 0, 1);
+            col.ParallelCopy(*mic_fab_vars[MicVar_Kess::qp ], 0, 1, 1);
+            if (m_detJ_cc) {
+                col.ParallelCopy(*m_detJ_cc, 0, 2, 1);
+            } else {
+                col.setVal(1.0, 2, 1);
+            }
+            col.ParallelCopy(*mic_fab_vars[MicVar_Kess::rain_accum], 0, 3, 1);
+
+            for ( MFIter mfi(col,TileNoZ()); mfi.isValid(); ++mfi) {
+                const Array4<Real>& c = col.array(mfi);
+
+                const auto& tbx = mfi.tilebox();
+                const int klo = tbx.smallEnd(2);
+                const int khi = tbx.bigEnd(2);
+
+                ParallelFor(makeSlab(tbx,2,klo), [=] AMREX_GPU_DEVICE(int i, int j, int) noexcept
+                {
+                    // Zero flux through the model top
+                    Real fz_hi = 0.0;
+
+                    for (int k(khi); k>=klo; --k) {
+                        Real rho = c(i,j,k,0);
+
+                        // Cells outside the grids of this level (fine levels only) are
+                        // left alone; what falls into them leaves the level, as it does
+                        // through the bottom of a fine region with the explicit flux
+                        if (rho <= 0.0) {
+                            fz_hi = 0.0;
+                            continue;
+                        }
+
+                        Real qp = std::max(0.0, c(i,j,k,1));
+
+                        Real V_terminal = 36.34*std::pow(rho*0.001*qp, 0.1346)*std::pow(rho/1.16, -0.5); // in m/s
+
+                        Real cdt = dtn / (c(i,j,k,2) * rho * dz);
+                        c(i,j,k,1) = (qp + cdt*fz_hi) / (1.0 + cdt*rho*V_terminal);
+
+                        // Flux leaving through the bottom face of this cell
+                        fz_hi = rho*V_terminal*c(i,j,k,1);
+
+                        if (k == k_lo) {
+                            c(i,j,k,3) += fz_hi*dtn/1000.0*1000.0; // Divide by rho_water and convert to mm
+                        }
+                    }
+                });
+            }
+
+            mic_fab_vars[MicVar_Kess::qp        ]->ParallelCopy(col, 1, 0, 1);
+            mic_fab_vars[MicVar_Kess::rain_accum]->ParallelCopy(col, 3, 0, 1);
+        }
     }
 
     if (solverChoice.moisture_type == MoistureType::Kessler_NoRain){
@@ -0,0 +1,760 @@
+#include "ERF_Constants.H"
+#include "ERF_SAM.H"
+#include "ERF_SAMCloud.H"
+#include "ERF_IndexDefines.H"
+#include "ERF_TileNoZ.H"
+#include "ERF_EOS.H"
+#include "ERF_Utils.H"
+
+using namespace amrex;
+
+/**
+ * Coefficient tables used by autoconversion, accretion and evaporation (A24-A31)
+ */
+struct SAMPrecipCoefs {
+    Table1D<Real> accrrc, accrsc, accrsi, accrgc, accrgi, coefice;
+    Table1D<Real> evapr1, evapr2, evaps1, evaps2, evapg1, evapg2;
+};
+
+/**
+ * Sedimentation flux of cloud ice (A32) on the z-face k
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+SAMIceFallFlux (int i, int j, int k,
+                const int& k_lo, const int& k_hi,
+                const Array4<const Real>& mic)
+{
+    Real rho_avg, qci_avg;
+    if (k==k_lo) {
+        rho_avg = mic(i,j,k,MicVar::rho);
+        qci_avg = mic(i,j,k,MicVar::qci);
+    } else if (k==k_hi+1) {
+        rho_avg = mic(i,j,k-1,MicVar::rho);
+        qci_avg = mic(i,j,k-1,MicVar::qci);
+    } else {
+        rho_avg = 0.5*(mic(i,j,k-1,MicVar::rho) + mic(i,j,k,MicVar::rho));
+        qci_avg = 0.5*(mic(i,j,k-1,MicVar::qci) + mic(i,j,k,MicVar::qci));
+    }
+    Real vt_ice = min( 0.4 , 8.66 * pow( (max(0.,qci_avg)+1.e-10) , 0.24) );
+
+    // NOTE: Fz is the sedimentation flux from the advective operator.
+    //       In the terrain-following coordinate system, the z-deriv in
+    //       the divergence uses the normal velocity (Omega). However,
+    //       there are no u/v components to the sedimentation velocity.
+    //       Therefore, we simply end up with a division by detJ when
+    //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
+    return rho_avg*vt_ice*qci_avg;
+}
+
+/**
+ * Autoconversion (A30), Accretion (A28), Evaporation (A24)
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+void
+SAMPrecip (int i, int j, int k,
+           const Array4<Real>& mic,
+           const SAMPrecipCoefs& cf,
+           const int& SAM_moisture_type,
+           const Real& fac_cond,
+           const Real& fac_fus,
+           const Real& fac_sub,
+           const Real& rdOcp,
+           const Real& dtn,
+           const SatTableView& sat_tab)
+{
+    amrex::ignore_unused(fac_sub);
+
+    constexpr Real powr1 = (3.0 + b_rain) / 4.0;
+    constexpr Real powr2 = (5.0 + b_rain) / 8.0;
+    constexpr Real pows1 = (3.0 + b_snow) / 4.0;
+    constexpr Real pows2 = (5.0 + b_snow) / 8.0;
+    constexpr Real powg1 = (3.0 + b_grau) / 4.0;
+    constexpr Real powg2 = (5.0 + b_grau) / 8.0;
+
+    constexpr Real eps = std::numeric_limits<Real>::epsilon();
+
+    Array4<Real> theta_array(mic, MicVar::theta);
+    Array4<Real> tabs_array (mic, MicVar::tabs);
+    Array4<Real> pres_array (mic, MicVar::pres);
+
+    // Non-precipitating
+    Array4<Real> qv_array   (mic, MicVar::qv);
+    Array4<Real> qcl_array  (mic, MicVar::qcl);
+    Array4<Real> qci_array  (mic, MicVar::qci);
+    Array4<Real> qn_array   (mic, MicVar::qn);
+    Array4<Real> qt_array   (mic, MicVar::qt);
+
+    // Precipitating
+    Array4<Real> qpr_array  (mic, MicVar::qpr);
+    Array4<Real> qps_array  (mic, MicVar::qps);
+    Array4<Real> qpg_array  (mic, MicVar::qpg);
+    Array4<Real> qp_array   (mic, MicVar::qp);
+
+    //------- Autoconversion/accretion
+    Real omn, omp, omg;
+    Real qsat, qsatw, qsati;
+
+    Real qcc, qii, qpr, qps, qpg;
+    Real dprc, dpsc, dpgc;
+    Real dpsi, dpgi;
+
+    Real dqc, dqca, dqi, dqia, dqp;
+    Real dqpr, dqps, dqpg;
+
+    Real auto_r, autos;
+    Real accrcr, accrcs, accris, accrcg, accrig;
+
+    // Work to be done for autoc/accr or evap
+    if (qn_array(i,j,k)+qp_array(i,j,k) > 0.0) {
+        if (SAM_moisture_type == 2) {
+            omn = 1.0;
+            omp = 1.0;
+            omg = 0.0;
+        } else {
+            omn = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tbgmin)*a_bg));
+            omp = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tprmin)*a_pr));
+            omg = std::max(0.0,std::min(1.0,(tabs_array(i,j,k)-tgrmin)*a_gr));
+        }
+
+        qcc = qcl_array(i,j,k);
+        qii = qci_array(i,j,k);
+
+        qpr = qpr_array(i,j,k);
+        qps = qps_array(i,j,k);
+        qpg = qpg_array(i,j,k);
+
+        //==================================================
+        // Autoconversion (A30/A31) and accretion (A27)
+        //==================================================
+        if (qn_array(i,j,k) > 0.0) {
+            accrcr = 0.0;
+            accrcs = 0.0;
+            accris = 0.0;
+            accrcg = 0.0;
+            accrig = 0.0;
+
+            if (qcc > qcw0) {
+                auto_r = alphaelq;
+            } else {
+                auto_r = 0.0;
+            }
+
+            if (qii > qci0) {
+                autos = betaelq*cf.coefice(k);
+            } else {
+                autos = 0.0;
+            }
+
+            if (omp > 0.001) {
+                accrcr = cf.accrrc(k);
+            }
+
+            if (omp < 0.999 && omg < 0.999) {
+                accrcs = cf.accrsc(k);
+                accris = cf.accrsi(k);
+            }
+
+            if (omp < 0.999 && omg > 0.001) {
+                accrcg = cf.accrgc(k);
+                accrig = cf.accrgi(k);
+            }
+
+            // Autoconversion & accretion (sink for cloud comps)
+            dqca = dtn * auto_r  * (qcc-qcw0);
+            dprc = dtn * accrcr * qcc * std::pow(qpr, powr1);
+            dpsc = dtn * accrcs * qcc * std::pow(qps, pows1);
+            dpgc = dtn * accrcg * qcc * std::pow(qpg, powg1);
+
+            dqia = dtn * autos  * (qii-qci0);
+            dpsi = dtn * accris * qii * std::pow(qps, pows1);
+            dpgi = dtn * accrig * qii * std::pow(qpg, powg1);
+
+            // Rescale sinks to avoid negative cloud fractions
+            dqc  = dqca + dprc + dpsc + dpgc;
+            dqi  = dqia + dpsi + dpgi;
+            Real scalec = std::min(qcl_array(i,j,k),dqc) / (dqc + eps);
+            Real scalei = std::min(qci_array(i,j,k),dqi) / (dqi + eps);
+            dqca *= scalec; dprc *= scalec; dpsc *= scalec; dpgc *= scalec;
+            dqia *= scalei; dpsi *= scalei; dpgi *= scalei;
+            dqc   = dqca + dprc + dpsc + dpgc;
+            dqi   = dqia + dpsi + dpgi;
+
+            // NOTE: Autoconversion of cloud water and ice are sources
+            //       to qp, while accretion is a source to an individual
+            //       precipitating component (e.g., qpr/qps/qpg). So we
+            //       only split autoconversion with omega. The omega
+            //       splitting does imply a latent heat source.
+
+            // Partition formed precip componentss
+            dqpr = (dqca + dqia) * omp + dprc;
+            dqps = (dqca + dqia) * (1.0 - omp) * (1.0 - omg) + dpsc + dpsi;
+            dqpg = (dqca + dqia) * (1.0 - omp) * omg         + dpgc + dpgi;
+
+            // Update the primitive state variables
+            qcl_array(i,j,k) -= dqc;
+            qci_array(i,j,k) -= dqi;
+            qpr_array(i,j,k) += dqpr;
+            qps_array(i,j,k) += dqps;
+            qpg_array(i,j,k) += dqpg;
+
+            // Update the primitive derived vars
+            qn_array(i,j,k) = qcl_array(i,j,k) + qci_array(i,j,k);
+            qt_array(i,j,k) =  qv_array(i,j,k) +  qn_array(i,j,k);
+            qp_array(i,j,k) = qpr_array(i,j,k) + qps_array(i,j,k) + qpg_array(i,j,k);
+
+            // Update temperature
+            tabs_array(i,j,k) += fac_fus * ( dqca * (1.0 - omp) - dqia * omp );
+
+            // Update theta
+            theta_array(i,j,k) = getThgivenPandT(tabs_array(i,j,k), 100.0*pres_array(i,j,k), rdOcp);
+        }
+
+        //==================================================
+        // Evaporation (A24)
+        //==================================================
+        erf_qsatw(sat_tab, tabs_array(i,j,k),pres_array(i,j,k),qsatw);
+        erf_qsati(sat_tab, tabs_array(i,j,k),pres_array(i,j,k),qsati);
+        qsat = qsatw * omn + qsati * (1.0-omn);
+        if((qp_array(i,j,k) > 0.0) && (qv_array(i,j,k) < qsat)) {
+
+            dqpr = cf.evapr1(k)*sqrt(qpr) + cf.evapr2(k)*pow(qpr,powr2);
+            dqps = cf.evaps1(k)*sqrt(qps) + cf.evaps2(k)*pow(qps,pows2);
+            dqpg = cf.evapg1(k)*sqrt(qpg) + cf.evapg2(k)*pow(qpg,powg2);
+
+            // NOTE: This is always a sink for precipitating comps
+            //       since qv<qsat and thus (1 - qv/qsat)>0. If we are
+            //       in a super-saturated state (qv>qsat) the Newton
+            //       iterations in SAMCloud() will have handled condensation.
+            dqpr *= dtn * (1.0 - qv_array(i,j,k)/qsat);
+            dqps *= dtn * (1.0 - qv_array(i,j,k)/qsat);
+            dqpg *= dtn * (1.0 - qv_array(i,j,k)/qsat);
+
+            // Limit to avoid negative moisture fractions
+            dqpr = std::min(qpr_array(i,j,k),dqpr);
+            dqps = std::min(qps_array(i,j,k),dqps);
+            dqpg = std::min(qpg_array(i,j,k),dqpg);
+            dqp  = dqpr + dqps + dqpg;
+
+            // Update the primitive state variables
+             qv_array(i,j,k) += dqp;
+            qpr_array(i,j,k) -= dqpr;
+            qps_array(i,j,k) -= dqps;
+            qpg_array(i,j,k) -= dqpg;
+
+            // Update the primitive derived vars
+            qt_array(i,j,k) =  qv_array(i,j,k) +  qn_array(i,j,k);
+            qp_array(i,j,k) = qpr_array(i,j,k) + qps_array(i,j,k) + qpg_array(i,j,k);
+
+            // Update temperature
+            tabs_array(i,j,k) -= fac_cond * dqpr + fac_sub * (dqps + dqpg);
+
+            // Update theta
+            theta_array(i,j,k) = getThgivenPandT(tabs_array(i,j,k), 100.0*pres_array(i,j,k), rdOcp);
+        }
+    }
+}
+
+/**
+ * Precipitation flux P_{r/s/g} (A19) for given density, temperature and precipitating water
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+SAMPrecipFlux (const Real& rho, const Real& tab, const Real& qp,
+               const int& SAM_moisture_type,
+               const Real& vrain, const Real& vsnow, const Real& vgrau)
+{
+    constexpr Real rho_0 = 1.29;
+
+    Real Pprecip = 0.0;
+    if(qp > qp_threshold) {
+        Real omp, omg;
+        if (SAM_moisture_type == 2) {
+            omp = 1.0;
+            omg = 0.0;
+        } else {
+            omp = std::max(0.0,std::min(1.0,(tab-tprmin)*a_pr));
+            omg = std::max(0.0,std::min(1.0,(tab-tgrmin)*a_gr));
+        }
+        Real qrr = omp*qp;
+        Real qss = (1.0-omp)*(1.0-omg)*qp;
+        Real qgg = (1.0-omp)*(omg)*qp;
+        Pprecip = omp*vrain*std::pow(rho*qrr,1.0+crain)
+                + (1.0-omp)*( (1.0-omg)*vsnow*std::pow(rho*qss,1.0+csnow)
+                            +      omg *vgrau*std::pow(rho*qgg,1.0+cgrau) );
+    }
+
+    // NOTE: Fz is the sedimentation flux from the advective operator.
+    //       In the terrain-following coordinate system, the z-deriv in
+    //       the divergence uses the normal velocity (Omega). However,
+    //       there are no u/v components to the sedimentation velocity.
+    //       Therefore, we simply end up with a division by detJ when
+    //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
+    return Pprecip * std::sqrt(rho_0/rho);
+}
+
+/**
+ * Precipitation flux P_{r/s/g} (A19) on the z-face k; also returns the face averaged
+ * density, temperature and precipitating water used for the surface accumulation.
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+SAMPrecipFallFlux (int i, int j, int k,
+                   const int& k_lo, const int& k_hi,
+                   const Array4<const Real>& mic,
+                   const int& SAM_moisture_type,
+                   const Real& vrain, const Real& vsnow, const Real& vgrau,
+                   Real& rho_avg, Real& tab_avg, Real& qp_avg)
+{
+    if (k==k_lo) {
+        rho_avg = mic(i,j,k,MicVar::rho);
+        tab_avg = mic(i,j,k,MicVar::tabs);
+         qp_avg = mic(i,j,k,MicVar::qp);
+    } else if (k==k_hi+1) {
+        rho_avg = mic(i,j,k-1,MicVar::rho);
+        tab_avg = mic(i,j,k-1,MicVar::tabs);
+         qp_avg = mic(i,j,k-1,MicVar::qp);
+    } else {
+        rho_avg = 0.5*(mic(i,j,k-1,MicVar::rho ) + mic(i,j,k,MicVar::rho ));
+        tab_avg = 0.5*(mic(i,j,k-1,MicVar::tabs) + mic(i,j,k,MicVar::tabs));
+         qp_avg = 0.5*(mic(i,j,k-1,MicVar::qp  ) + mic(i,j,k,MicVar::qp  ));
+    }
+
+    return SAMPrecipFlux(rho_avg, tab_avg, qp_avg, SAM_moisture_type, vrain, vsnow, vgrau);
+}
+
+/**
+ * Fused column update of the SAM microphysics: saturation adjustment (Cloud),
+ * cloud ice sedimentation (IceFall), autoconversion/accretion/evaporation (Precip)
+ * and precipitation sedimentation (PrecipFall).
+ *
+ * Each column of the conserved state is read once into tile-local scratch storage,
+ * all processes are applied in sequence, and the result is written back once to the
+ * conserved state and the moisture variables exposed through Qmoist_Ptr.
+ *
+ * @param[in] sc Solver choice object
+ */
+void
+SAM::AdvanceColumns (const SolverChoice& sc)
+{
+    AMREX_ALWAYS_ASSERT(m_cons_in);
+    MultiFab& cons = *m_cons_in;
+
+    Real fac_cond = m_fac_cond;
+    Real fac_sub  = m_fac_sub;
+    Real fac_fus  = m_fac_fus;
+    Real rdOcp    = m_rdOcp;
+
+    Real dtn  = dt;
+    Real dz   = m_geom.CellSize(2);
+    Real coef = dtn/dz;
+
+    auto domain = m_geom.Domain();
+    int k_lo = domain.smallEnd(2);
+    int k_hi = domain.bigEnd(2);
+
+    // Moisture type for saturation adjustment (no cloud ice at all without ice)
+    int cloud_moisture_type = 1;
+    if (sc.moisture_type == MoistureType::SAM_NoIce ||
+        sc.moisture_type == MoistureType::SAM_NoPrecip_NoIce) {
+        cloud_moisture_type = 2;
+    }
+
+    // Moisture type for the precipitating processes
+    int precip_moisture_type = 1;
+    if (sc.moisture_type == MoistureType::SAM_NoIce) {
+        precip_moisture_type = 2;
+    }
+
+    bool do_icefall = !(sc.moisture_type == MoistureType::SAM_NoIce ||
+                        sc.moisture_type == MoistureType::SAM_NoPrecip_NoIce);
+    bool do_precip  = (sc.moisture_type != MoistureType::SAM_NoPrecip_NoIce);
+
+    bool implicit_sed = sc.use_implicit_sedimentation;
+
+    // The anelastic reference pressure is not changed by the phase changes
+    bool fixed_pres = (m_base_state != nullptr);
+
+    // Saturation vapor pressures from the lookup table if requested
+    SatTableView sat_tab = (m_use_sat_table) ? SatTableView{m_sat_table.data()} : SatTableView{};
+
+    SAMPrecipCoefs cf;
+    cf.accrrc  = accrrc.table();
+    cf.accrsc  = accrsc.table();
+    cf.accrsi  = accrsi.table();
+    cf.accrgc  = accrgc.table();
+    cf.accrgi  = accrgi.table();
+    cf.coefice = coefice.table();
+    cf.evapr1  = evapr1.table();
+    cf.evapr2  = evapr2.table();
+    cf.evaps1  = evaps1.table();
+    cf.evaps2  = evaps2.table();
+    cf.evapg1  = evapg1.table();
+    cf.evapg2  = evapg2.table();
+
+    Real gamr3 = erf_gammafff(4.0+b_rain);
+    Real gams3 = erf_gammafff(4.0+b_snow);
+    Real gamg3 = erf_gammafff(4.0+b_grau);
+
+    Real vrain = (a_rain*gamr3/6.0)*pow((PI*rhor*nzeror),-crain);
+    Real vsnow = (a_snow*gams3/6.0)*pow((PI*rhos*nzeros),-csnow);
+    Real vgrau = (a_grau*gamg3/6.0)*pow((PI*rhog*nzerog),-cgrau);
+
+    // Number of column variables held in scratch storage (rho ... qpg)
+    constexpr int ncomp_col = MicVar::rain_accum;
+
+    for (MFIter mfi(cons, TileNoZ()); mfi.isValid(); ++mfi) {
+        const Box& tbx = mfi.tilebox();
+
+        // Saturation adjustment is also done in the ghost cell above and below
+        // the tile so the sedimentation fluxes on the tile faces see adjusted values
+        Box gbx = tbx; gbx.grow(2,1);
+
+        const int klo  = tbx.smallEnd(2);
+        const int khi  = tbx.bigEnd(2);
+        const int kglo = gbx.smallEnd(2);
+        const int kghi = gbx.bigEnd(2);
+
+        FArrayBox col_fab(gbx, ncomp_col, The_Async_Arena());
+        const Array4<Real>       mic  = col_fab.array();
+
+        const Array4<Real>& states_array = cons.array(mfi);
+
+        const auto dJ_array = (m_detJ_cc) ? m_detJ_cc->const_array(mfi) : Array4<const Real>{};
+
+        // Anelastic: temperature and pressure follow the reference state (p_0, pi_0)
+        const auto p0_array = (m_base_state) ? m_base_state->const_array(mfi) : Array4<const Real>{};
+
+        // Moisture variables exposed to the rest of the code
+        const Array4<Real>& qt_out  = mic_fab_vars[MicVar::qt ]->array(mfi);
+        const Array4<Real>& qv_out  = mic_fab_vars[MicVar::qv ]->array(mfi);
+        const Array4<Real>& qcl_out = mic_fab_vars[MicVar::qcl]->array(mfi);
+        const Array4<Real>& qci_out = mic_fab_vars[MicVar::qci]->array(mfi);
+        const Array4<Real>& qp_out  = mic_fab_vars[MicVar::qp ]->array(mfi);
+        const Array4<Real>& qpr_out = mic_fab_vars[MicVar::qpr]->array(mfi);
+        const Array4<Real>& qps_out = mic_fab_vars[MicVar::qps]->array(mfi);
+        const Array4<Real>& qpg_out = mic_fab_vars[MicVar::qpg]->array(mfi);
+
+        const Array4<Real>& rain_accum_array  = mic_fab_vars[MicVar::rain_accum ]->array(mfi);
+        const Array4<Real>& snow_accum_array  = mic_fab_vars[MicVar::snow_accum ]->array(mfi);
+        const Array4<Real>& graup_accum_array = mic_fab_vars[MicVar::graup_accum]->array(mfi);
+
+        Box xybx = makeSlab(tbx,2,klo);
+
+        ParallelFor(xybx, [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+        {
+            //==================================================
+            // Load the column from the conserved state
+            //==================================================
+            for (int k(kglo); k<=kghi; ++k) {
+                Real rho = states_array(i,j,k,Rho_comp);
+                mic(i,j,k,MicVar::rho)   = rho;
+                mic(i,j,k,MicVar::theta) = states_array(i,j,k,RhoTheta_comp)/rho;
+
+                mic(i,j,k,MicVar::qv)    = std::max(0.0,states_array(i,j,k,RhoQ1_comp)/rho);
+                mic(i,j,k,MicVar::qcl)   = std::max(0.0,states_array(i,j,k,RhoQ2_comp)/rho);
+                mic(i,j,k,MicVar::qci)   = std::max(0.0,states_array(i,j,k,RhoQ3_comp)/rho);
+                mic(i,j,k,MicVar::qn)    = mic(i,j,k,MicVar::qcl) + mic(i,j,k,MicVar::qci);
+                mic(i,j,k,MicVar::qt)    = mic(i,j,k,MicVar::qv)  + mic(i,j,k,MicVar::qn);
+
+                mic(i,j,k,MicVar::qpr)   = std::max(0.0,states_array(i,j,k,RhoQ4_comp)/rho);
+                mic(i,j,k,MicVar::qps)   = std::max(0.0,states_array(i,j,k,RhoQ5_comp)/rho);
+                mic(i,j,k,MicVar::qpg)   = std::max(0.0,states_array(i,j,k,RhoQ6_comp)/rho);
+                mic(i,j,k,MicVar::qp)    = mic(i,j,k,MicVar::qpr) + mic(i,j,k,MicVar::qps) + mic(i,j,k,MicVar::qpg);
+
+                if (fixed_pres) {
+                    mic(i,j,k,MicVar::tabs)  = mic(i,j,k,MicVar::theta) * p0_array(i,j,k,2);
+                    mic(i,j,k,MicVar::pres)  = p0_array(i,j,k,1) * 0.01;
+                } else {
+                    mic(i,j,k,MicVar::tabs)  = getTgivenRandRTh(rho, states_array(i,j,k,RhoTheta_comp),
+                                                                mic(i,j,k,MicVar::qv));
+                    mic(i,j,k,MicVar::pres)  = getPgivenRTh(states_array(i,j,k,RhoTheta_comp),
+                                                            mic(i,j,k,MicVar::qv)) * 0.01;
+                }
+            }
+
+            //==================================================
+            // Saturation adjustment
+            //==================================================
+            for (int k(kglo); k<=kghi; ++k) {
+                SAMCloud(i, j, k, mic, cloud_moisture_type,
+                         fac_cond, fac_fus, fac_sub, rdOcp, fixed_pres, sat_tab);
+            }
+
+            //==================================================
+            // Cloud ice sedimentation (A32)
+            //==================================================
+            // NOTE: The flux on the upper face of cell k only depends on cells
+            //       k and k+1, so it is evaluated before cell k is updated and
+            //       carried to the next cell as its lower face flux.
+            if (do_icefall) {
+                Real fz_lo = SAMIceFallFlux(i, j, klo, k_lo, k_hi, mic);
+                for (int k(klo); k<=khi; ++k) {
+                    Real fz_hi = SAMIceFallFlux(i, j, k+1, k_lo, k_hi, mic);
+
+                    // Jacobian determinant
+                    Real dJinv = (dJ_array) ? 1.0/dJ_array(i,j,k) : 1.0;
+
+                    Real dqi = dJinv * (1.0/mic(i,j,k,MicVar::rho)) * ( fz_hi - fz_lo ) * coef;
+                    dqi = std::max(-mic(i,j,k,MicVar::qci), dqi);
+
+                    // Add this increment to both non-precipitating and total water.
+                    mic(i,j,k,MicVar::qci) += dqi;
+                    mic(i,j,k,MicVar::qn)  += dqi;
+                    mic(i,j,k,MicVar::qt)  += dqi;
+
+                    // NOTE: Sedimentation does not affect the potential temperature,
+                    //       but it does affect the liquid/ice static energy.
+                    //       No source to Theta occurs here.
+                    fz_lo = fz_hi;
+                }
+            }
+
+            if (do_precip) {
+                //==================================================
+                // Autoconversion, accretion and evaporation
+                //==================================================
+                for (int k(klo); k<=khi; ++k) {
+                    SAMPrecip(i, j, k, mic, cf, precip_moisture_type,
+                              fac_cond, fac_fus, fac_sub, rdOcp, dtn, sat_tab);
+                }
+
+                //==================================================
+                // Precipitating sedimentation (A19)
+                //==================================================
+                // NOTE: The implicit fall needs whole columns; it is done in
+                //       SAM::ImplicitPrecipFall after the column loop.
+                if (!implicit_sed) {
+                    Real rho_avg, tab_avg, qp_avg;
+                    Real fz_lo = SAMPrecipFallFlux(i, j, klo, k_lo, k_hi, mic, precip_moisture_type,
+                                                   vrain, vsnow, vgrau, rho_avg, tab_avg, qp_avg);
+
+                    if (klo == k_lo) {
+                        Real omp, omg;
+                        if (precip_moisture_type == 2) {
+                            omp = 1.0;
+                            omg = 0.0;
+                        } else {
+                            omp = std::max(0.0,std::min(1.0,(tab_avg-tprmin)*a_pr));
+                            omg = std::max(0.0,std::min(1.0,(tab_avg-tgrmin)*a_gr));
+                        }
+                        rain_accum_array(i,j,klo)  = rain_accum_array(i,j,klo) +  rho_avg*(omp*qp_avg)*vrain*dtn/rhor*1000.0; // Divide by rho_water and convert to mm
+                        snow_accum_array(i,j,klo)  = snow_accum_array(i,j,klo) +  rho_avg*(1.0-omp)*(1.0-omg)*qp_avg*vrain*dtn/rhos*1000.0; // Divide by rho_snow and convert to mm
+                        graup_accum_array(i,j,klo) = graup_accum_array(i,j,klo) + rho_avg*(1.0-omp)*(omg)*qp_avg*vrain*dtn/rhog*1000.0; // Divide by rho_graupel and convert to mm
+                    }
+
+                    for (int k(klo); k<=khi; ++k) {
+                        Real fz_hi = SAMPrecipFallFlux(i, j, k+1, k_lo, k_hi, mic, precip_moisture_type,
+                                                       vrain, vsnow, vgrau, rho_avg, tab_avg, qp_avg);
+
+                        // Jacobian determinant
+                        Real dJinv = (dJ_array) ? 1.0/dJ_array(i,j,k) : 1.0;
+
+                        Real dqp = dJinv * (1.0/mic(i,j,k,MicVar::rho)) * ( fz_hi - fz_lo ) * coef;
+                        Real omp, omg;
+                        if (precip_moisture_type == 2) {
+                            omp = 1.0;
+                            omg = 0.0;
+                        } else {
+                            omp = std::max(0.0,std::min(1.0,(mic(i,j,k,MicVar::tabs)-tprmin)*a_pr));
+                            omg = std::max(0.0,std::min(1.0,(mic(i,j,k,MicVar::tabs)-tgrmin)*a_gr));
+                        }
+
+                        mic(i,j,k,MicVar::qpr) = std::max(0.0, mic(i,j,k,MicVar::qpr) + dqp*omp);
+                        mic(i,j,k,MicVar::qps) = std::max(0.0, mic(i,j,k,MicVar::qps) + dqp*(1.0-omp)*(1.0-omg));
+                        mic(i,j,k,MicVar::qpg) = std::max(0.0, mic(i,j,k,MicVar::qpg) + dqp*(1.0-omp)*omg);
+                        mic(i,j,k,MicVar::qp)  = mic(i,j,k,MicVar::qpr) + mic(i,j,k,MicVar::qps) + mic(i,j,k,MicVar::qpg);
+
+                        // NOTE: Sedimentation does not affect the potential temperature,
+                        //       but it does affect the liquid/ice static energy.
+                        //       No source to Theta occurs here.
+                        fz_lo = fz_hi;
+                    }
+                }
+            }
+
+            //==================================================
+            // Write the column back to the conserved state
+            //==================================================
+            for (int k(klo); k<=khi; ++k) {
+                Real rho = mic(i,j,k,MicVar::rho);
+                states_array(i,j,k,RhoTheta_comp) = rho*mic(i,j,k,MicVar::theta);
+
+                states_array(i,j,k,RhoQ1_comp)    = rho*std::max(0.0,mic(i,j,k,MicVar::qv ));
+                states_array(i,j,k,RhoQ2_comp)    = rho*std::max(0.0,mic(i,j,k,MicVar::qcl));
+                states_array(i,j,k,RhoQ3_comp)    = rho*std::max(0.0,mic(i,j,k,MicVar::qci));
+
+                states_array(i,j,k,RhoQ4_comp)    = rho*std::max(0.0,mic(i,j,k,MicVar::qpr));
+                states_array(i,j,k,RhoQ5_comp)    = rho*std::max(0.0,mic(i,j,k,MicVar::qps));
+                states_array(i,j,k,RhoQ6_comp)    = rho*std::max(0.0,mic(i,j,k,MicVar::qpg));
+
+                qt_out (i,j,k) = mic(i,j,k,MicVar::qt );
+                qv_out (i,j,k) = mic(i,j,k,MicVar::qv );
+                qcl_out(i,j,k) = mic(i,j,k,MicVar::qcl);
+                qci_out(i,j,k) = mic(i,j,k,MicVar::qci);
+                qp_out (i,j,k) = mic(i,j,k,MicVar::qp );
+                qpr_out(i,j,k) = mic(i,j,k,MicVar::qpr);
+                qps_out(i,j,k) = mic(i,j,k,MicVar::qps);
+                qpg_out(i,j,k) = mic(i,j,k,MicVar::qpg);
+            }
+        });
+    }
+
+    if (do_precip && implicit_sed) {
+        this->ImplicitPrecipFall(precip_moisture_type, vrain, vsnow, vgrau);
+    }
+}
+
+/**
+ * Implicit precipitating sedimentation (A19).
+ *
+ * Backward-Euler upwind update with the fall speed of each cell lagged at the old
+ * time. The flux through the bottom face of a cell only depends on that cell, so a
+ * column is solved exactly by a single downward sweep from the model top, through
+ * which nothing falls in. The update is unconditionally stable, positive and
+ * conserves the column mass up to what reaches the surface.
+ *
+ * The sweep needs whole columns. When the grids are split in the vertical, the state
+ * is gathered on full-height grids first, so the inflow through every internal grid
+ * face is the new-time flux out of the cell above rather than an old-time ghost cell.
+ *
+ * @param[in] precip_moisture_type moisture type for the precipitating processes
+ * @param[in] vrain rain fall speed coefficient
+ * @param[in] vsnow snow fall speed coefficient
+ * @param[in] vgrau graupel fall speed coefficient
+ */
+void
+SAM::ImplicitPrecipFall (const int& precip_moisture_type,
+                         const Real& vrain, const Real& vsnow, const Real& vgrau)
+{
+    MultiFab& cons = *m_cons_in;
+
+    Real dtn  = dt;
+    Real coef = dtn/m_geom.CellSize(2);
+
+    const Box& domain = m_geom.Domain();
+    const int k_lo = domain.smallEnd(2);
+
+    // Column storage: the conserved state up to RhoQ6, the Jacobian and the accumulations
+    const int ncomp_st = RhoQ6_comp + 1;
+    const int icomp_dJ = ncomp_st;
+    const int icomp_ra = ncomp_st + 1;
+    const int icomp_sa = ncomp_st + 2;
+    const int icomp_ga = ncomp_st + 3;
+
+    const BoxArray& ba = cons.boxArray();
+    const bool columns = AllBoxesAreColumns(ba, domain);
+    BoxArray            col_ba = (columns) ? ba : ColumnBoxArray(ba, domain);
+    DistributionMapping col_dm = (columns) ? cons.DistributionMap() : DistributionMapping(col_ba);
+
+    MultiFab col(col_ba, col_dm, ncomp_st+4, 0);
+    col.setVal(0.0);
+    col.ParallelCopy(cons, 0, 0, ncomp_st);
+    if (m_detJ_cc) {
+        col.ParallelCopy(*m_detJ_cc, 0, icomp_dJ, 1);
+    } else {
+        col.setVal(1.0, icomp_dJ, 1);
+    }
+    col.ParallelCopy(*mic_fab_vars[MicVar::rain_accum ], 0, icomp_ra, 1);
+    col.ParallelCopy(*mic_fab_vars[MicVar::snow_accum ], 0, icomp_sa, 1);
+    col.ParallelCopy(*mic_fab_vars[MicVar::graup_accum], 0, icomp_ga, 1);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(col, TileNoZ()); mfi.isValid(); ++mfi) {
+        const Box& tbx = mfi.tilebox();
+        const int klo  = tbx.smallEnd(2);
+        const int khi  = tbx.bigEnd(2);
+
+        const Array4<Real>& c = col.array(mfi);
+
+        ParallelFor(makeSlab(tbx,2,klo), [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+        {
+            // Zero flux through the model top
+            Real fz_hi = 0.0;
+
+            for (int k(khi); k>=klo; --k) {
+                Real rho = c(i,j,k,Rho_comp);
+
+                // Cells outside the grids of this level (fine levels only) are left
+                // alone; what falls into them leaves the level, as it does through
+                // the bottom of a fine region with the explicit flux
+                if (rho <= 0.0) {
+                    fz_hi = 0.0;
+                    continue;
+                }
+
+                Real qpr = std::max(0.0, c(i,j,k,RhoQ4_comp)/rho);
+                Real qps = std::max(0.0, c(i,j,k,RhoQ5_comp)/rho);
+                Real qpg = std::max(0.0, c(i,j,k,RhoQ6_comp)/rho);
+                Real qp  = qpr + qps + qpg;
+                Real qv  = std::max(0.0, c(i,j,k,RhoQ1_comp)/rho);
+                Real tab = getTgivenRandRTh(rho, c(i,j,k,RhoTheta_comp), qv);
+
+                // Effective fall speed times density (P = rho * w * qp)
+                Real rhow = (qp > qp_threshold) ?
+                    SAMPrecipFlux(rho, tab, qp, precip_moisture_type, vrain, vsnow, vgrau) / qp : 0.0;
+
+                Real cdt    = coef / (c(i,j,k,icomp_dJ) * rho);
+                Real qp_new = (qp + cdt*fz_hi) / (1.0 + cdt*rhow);
+                Real dqp    = qp_new - qp;
+
+                Real omp, omg;
+                if (precip_moisture_type == 2) {
+                    omp = 1.0;
+                    omg = 0.0;
+                } else {
+                    omp = std::max(0.0,std::min(1.0,(tab-tprmin)*a_pr));
+                    omg = std::max(0.0,std::min(1.0,(tab-tgrmin)*a_gr));
+                }
+
+                c(i,j,k,RhoQ4_comp) = rho*std::max(0.0, qpr + dqp*omp);
+                c(i,j,k,RhoQ5_comp) = rho*std::max(0.0, qps + dqp*(1.0-omp)*(1.0-omg));
+                c(i,j,k,RhoQ6_comp) = rho*std::max(0.0, qpg + dqp*(1.0-omp)*omg);
+
+                // Flux leaving through the bottom face of this cell
+                fz_hi = rhow * qp_new;
+
+                if (k == k_lo) {
+                    c(i,j,k,icomp_ra) += fz_hi*omp*dtn/rhor*1000.0;                 // Divide by rho_water and convert to mm
+                    c(i,j,k,icomp_sa) += fz_hi*(1.0-omp)*(1.0-omg)*dtn/rhos*1000.0; // Divide by rho_snow and convert to mm
+                    c(i,j,k,icomp_ga) += fz_hi*(1.0-omp)*omg*dtn/rhog*1000.0;       // Divide by rho_graupel and convert to mm
+                }
+            }
+        });
+    }
+
+    cons.ParallelCopy(col, RhoQ4_comp, RhoQ4_comp, 3);
+    mic_fab_vars[MicVar::rain_accum ]->ParallelCopy(col, icomp_ra, 0, 1);
+    mic_fab_vars[MicVar::snow_accum ]->ParallelCopy(col, icomp_sa, 0, 1);
+    mic_fab_vars[MicVar::graup_accum]->ParallelCopy(col, icomp_ga, 0, 1);
+
+    // Refresh the precipitating moisture variables exposed through Qmoist_Ptr
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cons, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& tbx = mfi.tilebox();
+
+        const Array4<const Real>& states_array = cons.const_array(mfi);
+
+        const Array4<Real>& qp_out  = mic_fab_vars[MicVar::qp ]->array(mfi);
+        const Array4<Real>& qpr_out = mic_fab_vars[MicVar::qpr]->array(mfi);
+        const Array4<Real>& qps_out = mic_fab_vars[MicVar::qps]->array(mfi);
+        const Array4<Real>& qpg_out = mic_fab_vars[MicVar::qpg]->array(mfi);
+
+        ParallelFor(tbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real rho = states_array(i,j,k,Rho_comp);
+            qpr_out(i,j,k) = states_array(i,j,k,RhoQ4_comp)/rho;
+            qps_out(i,j,k) = states_array(i,j,k,RhoQ5_comp)/rho;
+            qpg_out(i,j,k) = states_array(i,j,k,RhoQ6_comp)/rho;
+            qp_out (i,j,k) = qpr_out(i,j,k) + qps_out(i,j,k) + qpg_out(i,j,k);
+        });
+    }
+}
@@ -0,0 +1,471 @@
+#ifdef ERF_USE_PARTICLES
+
+#include <AMReX_DenseBins.H>
+#include "ERF_SuperDroplets.H"
+#include "ERF_Microphysics_Utils.H"
+
+using namespace amrex;
+
+namespace {
+
+/*! Radius (m) of a droplet of mass m (kg) */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real sd_radius (Real m)
+{
+    return std::cbrt(3.0*m/(4.0*PI*rhor));
+}
+
+/*! Terminal fall speed (m/s) of a droplet of radius r (m) in air of density rho,
+ *  from the Stokes, linear and square-root regimes of Rogers and Yau (1989) */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real sd_terminal_velocity (Real r, Real rho)
+{
+    if (r < 40.0e-6) {
+        return 1.19e8*r*r;
+    } else if (r < 0.6e-3) {
+        return 8.0e3*r*std::sqrt(1.2/rho);
+    } else {
+        return 2.01e2*std::sqrt(r)*std::sqrt(1.2/rho);
+    }
+}
+
+/*! Cell holding particle p, clamped to the box bx */
+template <typename P>
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+IntVect sd_cell (P const& p,
+                 GpuArray<Real,AMREX_SPACEDIM> const& plo,
+                 GpuArray<Real,AMREX_SPACEDIM> const& dxi,
+                 const Box& domain, const Box& bx)
+{
+    IntVect iv = ERFParticlesAssignor{}(p, plo, dxi, domain);
+    for (int d = 0; d < AMREX_SPACEDIM; d++) {
+        iv[d] = amrex::min(amrex::max(iv[d], bx.smallEnd(d)), bx.bigEnd(d));
+    }
+    return iv;
+}
+
+}
+
+/**
+ * Advance the superdroplets and the coupled micro vars by one time step.
+ *
+ * @param[in] dt_advance Time step
+ * @param[in] a_vars Dycore state variables (the velocities advect the droplets)
+ * @param[in] a_z Nodal heights with terrain
+ */
+void SuperDroplets::Advance (const Real& dt_advance,
+                             const int& /*iter*/,
+                             const Real& /*time*/,
+                             Vector<Vector<MultiFab>>& a_vars,
+                             const Vector<std::unique_ptr<MultiFab>>& a_z)
+{
+    BL_PROFILE("SuperDroplets::Advance()");
+
+    dt = dt_advance;
+
+    AdvectAndSediment(a_vars, a_z);
+
+    // Bring every droplet back into its own tile before the per-cell kernels
+    m_pc->RedistributeIfNeeded();
+
+    // Condensation and coalescence only move water between the vapor and the droplets
+    Real water_old = (m_check_water) ? TotalWater() : 0.0;
+
+    if (m_do_condensation) { Condense(); }
+
+    if (m_do_coalescence) { Coalesce(); }
+
+    if (m_check_water) {
+        Real water_new = TotalWater();
+        Real rel_err = std::abs(water_new - water_old) / amrex::max(water_old, Real(1.e-300));
+        Print() << "Superdroplets: total water " << water_new << " kg, relative change "
+                << rel_err << " in condensation and coalescence\n";
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(rel_err < m_water_tol,
+                                         "Superdroplets: condensation and coalescence do not conserve water");
+    }
+
+    ComputeMoments();
+}
+
+void SuperDroplets::AdvectAndSediment (Vector<Vector<MultiFab>>& a_vars,
+                                       const Vector<std::unique_ptr<MultiFab>>& a_z)
+{
+    BL_PROFILE("SuperDroplets::AdvectAndSediment()");
+
+    MultiFab* flow_vel( &a_vars[0][Vars::xvel] );
+    m_pc->AdvectWithFlow( flow_vel, 0, dt, a_z[0] );
+
+    const auto plo = m_geom.ProbLoArray();
+    const auto dxi = m_geom.InvCellSizeArray();
+    const auto dx  = m_geom.CellSizeArray();
+    const Box& domain = m_geom.Domain();
+    const int klo = domain.smallEnd(2);
+
+    Real dtn = dt;
+    bool do_sed = m_do_sedimentation;
+    Real rain_fac = 1000.0/(rhor*dx[0]*dx[1]); // droplet mass to mm of rain over a column
+
+    for (ERFPC::ParIterType pti(*m_pc, 0); pti.isValid(); ++pti) {
+        const Box& gbx = pti.validbox();
+        auto& aos = pti.GetArrayOfStructs();
+        auto* p_pbox = aos().data();
+        const int np = aos.numParticles();
+
+        auto& soa = pti.GetStructOfArrays();
+        auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        auto* mult_ptr = soa.GetRealData(SDRealIdx::multiplicity).data();
+
+        auto rho_arr  = mic_fab_vars[MicVar_SD::rho]->const_array(pti);
+        auto rain_arr = mic_fab_vars[MicVar_SD::rain_accum]->array(pti);
+
+        bool use_terrain = (a_z[0] != nullptr);
+        auto zheight = use_terrain ? a_z[0]->const_array(pti) : Array4<Real const>{};
+
+        ParallelFor(np, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            auto& p = p_pbox[n];
+            if (p.id() <= 0) { return; }
+
+            if (do_sed) {
+                IntVect iv = sd_cell(p, plo, dxi, domain, gbx);
+                Real r = sd_radius(mass_ptr[n]);
+                p.pos(2) -= static_cast<ParticleReal>(sd_terminal_velocity(r, rho_arr(iv))*dtn);
+            }
+
+            // The flow advection only tracks the vertical index with terrain
+            if (use_terrain) {
+                update_location_idata(p, plo, dxi, zheight);
+            } else {
+                p.idata(ERFParticlesIntIdxAoS::k) = int(amrex::Math::floor((p.pos(2)-plo[2])*dxi[2]));
+            }
+
+            if (p.idata(ERFParticlesIntIdxAoS::k) < klo) {
+                IntVect iv = sd_cell(p, plo, dxi, domain, gbx);
+                Gpu::Atomic::AddNoRet(&rain_arr(iv[0],iv[1],klo), mult_ptr[n]*mass_ptr[n]*rain_fac);
+                p.id() = -1;
+            }
+        });
+    }
+}
+
+void SuperDroplets::Condense ()
+{
+    BL_PROFILE("SuperDroplets::Condense()");
+
+    const auto plo = m_geom.ProbLoArray();
+    const auto dxi = m_geom.InvCellSizeArray();
+    const auto dx  = m_geom.CellSizeArray();
+    const Box& domain = m_geom.Domain();
+    Real cell_vol = dx[0]*dx[1]*dx[2];
+
+    Real dtn = dt;
+    Real r2_min = m_min_radius*m_min_radius;
+    Real d_fac_cond = m_fac_cond;
+
+    // Thermal conductivity of air (J/(m s K)) and diffusivity of water vapor (m^2/s)
+    constexpr Real K_a = 2.4e-2;
+    constexpr Real D_v = 2.21e-5;
+
+    // Per unit mass of air in each cell: the condensation the growing droplets ask for,
+    // the water the evaporating droplets give back, and the net condensed water
+    MultiFab dq(mic_fab_vars[MicVar_SD::qv]->boxArray(),
+                mic_fab_vars[MicVar_SD::qv]->DistributionMap(), 3, 0);
+    dq.setVal(0.);
+
+    for (ERFPC::ParIterType pti(*m_pc, 0); pti.isValid(); ++pti) {
+        const Box& gbx = pti.validbox();
+        auto& aos = pti.GetArrayOfStructs();
+        const auto* p_pbox = aos().data();
+        const int np = aos.numParticles();
+
+        auto& soa = pti.GetStructOfArrays();
+        auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        auto* mult_ptr = soa.GetRealData(SDRealIdx::multiplicity).data();
+
+        auto rho_arr  = mic_fab_vars[MicVar_SD::rho]->const_array(pti);
+        auto tabs_arr = mic_fab_vars[MicVar_SD::tabs]->const_array(pti);
+        auto pres_arr = mic_fab_vars[MicVar_SD::pres]->const_array(pti);
+        auto qv_arr   = mic_fab_vars[MicVar_SD::qv]->const_array(pti);
+        auto dq_arr   = dq.array(pti);
+
+        const auto dJ_arr = (m_detJ_cc) ? m_detJ_cc->const_array(pti) : Array4<const Real>{};
+
+        Gpu::DeviceVector<Real> dm(np);
+        auto* dm_ptr = dm.data();
+
+        // Mass change each droplet would have with unlimited vapor
+        ParallelFor(np, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            const auto& p = p_pbox[n];
+            dm_ptr[n] = 0.0;
+            if (p.id() <= 0) { return; }
+
+            IntVect iv = sd_cell(p, plo, dxi, domain, gbx);
+            Real tabs = tabs_arr(iv);
+            Real pres = pres_arr(iv);
+
+            Real qsat;
+            erf_qsatw(tabs, pres, qsat);
+            Real esat = erf_esatw(tabs)*100.0;
+
+            // Growth by vapor diffusion, r dr/dt = (S-1)/(F_k+F_d), neglecting the curvature
+            // and solute terms (Rogers and Yau eq 7.17)
+            Real F_k = (L_v/(R_v*tabs) - 1.0)*L_v*rhor/(K_a*tabs);
+            Real F_d = rhor*R_v*tabs/(D_v*esat);
+            Real supersat = qv_arr(iv)/amrex::max(qsat, Real(1.e-20)) - 1.0;
+
+            // Evaporation stops at the minimum radius but never grows a smaller droplet
+            Real r  = sd_radius(mass_ptr[n]);
+            Real r2 = amrex::max(r*r + 2.0*supersat/(F_k + F_d)*dtn, amrex::min(r*r, r2_min));
+            dm_ptr[n] = 4.0/3.0*PI*rhor*r2*std::sqrt(r2) - mass_ptr[n];
+
+            Real vol = (dJ_arr) ? cell_vol*dJ_arr(iv) : cell_vol;
+            Real dq_n = mult_ptr[n]*dm_ptr[n]/(rho_arr(iv)*vol);
+            if (dq_n > 0.0) {
+                Gpu::Atomic::AddNoRet(&dq_arr(iv,0),  dq_n);
+            } else {
+                Gpu::Atomic::AddNoRet(&dq_arr(iv,1), -dq_n);
+            }
+        });
+
+        // The growth in a cell is limited to the vapor there plus what evaporates,
+        // so the droplets never take more water than the cell has
+        ParallelFor(np, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            const auto& p = p_pbox[n];
+            if (p.id() <= 0) { return; }
+
+            IntVect iv = sd_cell(p, plo, dxi, domain, gbx);
+            Real dm_n = dm_ptr[n];
+            if (dm_n > 0.0 && dq_arr(iv,0) > qv_arr(iv) + dq_arr(iv,1)) {
+                dm_n *= (qv_arr(iv) + dq_arr(iv,1)) / dq_arr(iv,0);
+            }
+            mass_ptr[n] += dm_n;
+
+            Real vol = (dJ_arr) ? cell_vol*dJ_arr(iv) : cell_vol;
+            Gpu::Atomic::AddNoRet(&dq_arr(iv,2), mult_ptr[n]*dm_n/(rho_arr(iv)*vol));
+        });
+    }
+
+    // Take the condensed water from the vapor and release its latent heat
+    for (MFIter mfi(dq, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        auto dq_arr    = dq.const_array(mfi);
+        auto qv_arr    = mic_fab_vars[MicVar_SD::qv]->array(mfi);
+        auto theta_arr = mic_fab_vars[MicVar_SD::theta]->array(mfi);
+        auto tabs_arr  = mic_fab_vars[MicVar_SD::tabs]->array(mfi);
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real theta_over_T = theta_arr(i,j,k)/tabs_arr(i,j,k);
+            qv_arr(i,j,k)    -= dq_arr(i,j,k,2);
+            theta_arr(i,j,k) += theta_over_T * d_fac_cond * dq_arr(i,j,k,2);
+            tabs_arr(i,j,k)  += d_fac_cond * dq_arr(i,j,k,2);
+        });
+    }
+}
+
+/**
+ * Total water (kg) held by the vapor and the droplets on level 0
+ */
+Real SuperDroplets::TotalWater () const
+{
+    const auto dx = m_geom.CellSizeArray();
+    Real cell_vol = dx[0]*dx[1]*dx[2];
+
+    ReduceOps<ReduceOpSum> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    for (MFIter mfi(*mic_fab_vars[MicVar_SD::qv]); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        auto rho_arr = mic_fab_vars[MicVar_SD::rho]->const_array(mfi);
+        auto qv_arr  = mic_fab_vars[MicVar_SD::qv]->const_array(mfi);
+        const auto dJ_arr = (m_detJ_cc) ? m_detJ_cc->const_array(mfi) : Array4<const Real>{};
+        reduce_op.eval(bx, reduce_data, [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            Real vol = (dJ_arr) ? cell_vol*dJ_arr(i,j,k) : cell_vol;
+            return { rho_arr(i,j,k)*qv_arr(i,j,k)*vol };
+        });
+    }
+
+    for (ERFPC::ParConstIterType pti(*m_pc, 0); pti.isValid(); ++pti) {
+        const auto* p_pbox = pti.GetArrayOfStructs()().data();
+        const auto& soa = pti.GetStructOfArrays();
+        const auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        const auto* mult_ptr = soa.GetRealData(SDRealIdx::multiplicity).data();
+        reduce_op.eval(pti.numParticles(), reduce_data, [=] AMREX_GPU_DEVICE (int n) -> ReduceTuple
+        {
+            return { (p_pbox[n].id() > 0) ? mult_ptr[n]*mass_ptr[n] : Real(0.0) };
+        });
+    }
+
+    Real water = amrex::get<0>(reduce_data.value(reduce_op));
+    ParallelDescriptor::ReduceRealSum(water);
+    return water;
+}
+
+/**
+ * Linear-sampling collision-coalescence (Shima et al. 2009): the n droplets of a cell are
+ * randomly permuted and split into n/2 disjoint pairs. Each pair coalesces with a
+ * probability scaled by n(n-1)/2 / (n/2) so that the pairs stand for all the possible
+ * combinations, and a pair may coalesce several times within a step.
+ */
+void SuperDroplets::Coalesce ()
+{
+    BL_PROFILE("SuperDroplets::Coalesce()");
+
+    using ParticleType = ERFPC::ParticleType;
+
+    const auto plo = m_geom.ProbLoArray();
+    const auto dxi = m_geom.InvCellSizeArray();
+    const auto dx  = m_geom.CellSizeArray();
+    const Box& domain = m_geom.Domain();
+    Real cell_vol = dx[0]*dx[1]*dx[2];
+
+    Real dtn = dt;
+    bool golovin = m_golovin_kernel;
+    Real golovin_b = m_golovin_b;
+
+    for (ERFPC::ParIterType pti(*m_pc, 0); pti.isValid(); ++pti) {
+        const Box& tbx = pti.tilebox();
+        auto& aos = pti.GetArrayOfStructs();
+        auto* p_pbox = aos().data();
+        const int np = aos.numParticles();
+        if (np < 2) { continue; }
+
+        auto& soa = pti.GetStructOfArrays();
+        auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        auto* mult_ptr = soa.GetRealData(SDRealIdx::multiplicity).data();
+
+        auto rho_arr = mic_fab_vars[MicVar_SD::rho]->const_array(pti);
+        const auto dJ_arr = (m_detJ_cc) ? m_detJ_cc->const_array(pti) : Array4<const Real>{};
+
+        // Bin the droplets of the tile by cell
+        DenseBins<ParticleType> bins;
+        bins.build(np, p_pbox, tbx,
+            [=] AMREX_GPU_DEVICE (const ParticleType& p) noexcept -> IntVect
+            {
+                return sd_cell(p, plo, dxi, domain, tbx);
+            });
+        const auto* offsets = bins.offsetsPtr();
+        const int nbins = bins.numBins();
+
+        Gpu::DeviceVector<unsigned int> order(np);
+        Gpu::copy(Gpu::deviceToDevice, bins.permutationPtr(), bins.permutationPtr()+np, order.begin());
+        auto* order_ptr = order.data();
+
+        ParallelForRNG(nbins, [=] AMREX_GPU_DEVICE (int b, const RandomEngine& engine) noexcept
+        {
+            const int start = offsets[b];
+            const int n     = offsets[b+1] - start;
+            if (n < 2) { return; }
+
+            // random permutation of the droplets in the cell
+            for (int a = n-1; a > 0; --a) {
+                int c = Random_int(a+1, engine);
+                unsigned int tmp = order_ptr[start+a];
+                order_ptr[start+a] = order_ptr[start+c];
+                order_ptr[start+c] = tmp;
+            }
+
+            IntVect iv = tbx.atOffset(b);
+            Real rho = rho_arr(iv);
+            Real vol = (dJ_arr) ? cell_vol*dJ_arr(iv) : cell_vol;
+
+            const int npair = n/2;
+            Real scale = Real(n)*Real(n-1)/(2.0*npair);
+
+            for (int q = 0; q < npair; ++q) {
+                int ij = order_ptr[start+q];
+                int ik = order_ptr[start+npair+q];
+                if (mult_ptr[ij] < mult_ptr[ik]) {
+                    int tmp = ij; ij = ik; ik = tmp;
+                }
+
+                Real rj = sd_radius(mass_ptr[ij]);
+                Real rk = sd_radius(mass_ptr[ik]);
+                Real kernel;
+                if (golovin) {
+                    kernel = golovin_b*(mass_ptr[ij] + mass_ptr[ik])/rhor;
+                } else {
+                    kernel = PI*(rj+rk)*(rj+rk)*
+                             std::abs(sd_terminal_velocity(rj,rho) - sd_terminal_velocity(rk,rho));
+                }
+
+                Real prob  = scale*mult_ptr[ij]*kernel*dtn/vol;
+                Real gamma = std::floor(prob);
+                if (Random(engine) < prob - gamma) { gamma += 1.0; }
+                if (gamma <= 0.0) { continue; }
+
+                // droplet j has the larger multiplicity; each of the mult_k droplets of k
+                // collects gamma droplets of j
+                gamma = amrex::min(gamma, std::floor(mult_ptr[ij]/mult_ptr[ik]));
+                if (mult_ptr[ij] - gamma*mult_ptr[ik] > 0.0) {
+                    mult_ptr[ij] -= gamma*mult_ptr[ik];
+                    mass_ptr[ik] += gamma*mass_ptr[ij];
+                } else {
+                    // all droplets of j are used up: split the merged droplets evenly
+                    Real m_new = mass_ptr[ik] + gamma*mass_ptr[ij];
+                    Real half  = std::floor(mult_ptr[ik]/2.0);
+                    mult_ptr[ij]  = half;
+                    mult_ptr[ik] -= half;
+                    mass_ptr[ij]  = m_new;
+                    mass_ptr[ik]  = m_new;
+                    if (half == 0.0) { p_pbox[ij].id() = -1; }
+                }
+            }
+        });
+    }
+}
+
+void SuperDroplets::ComputeMoments ()
+{
+    BL_PROFILE("SuperDroplets::ComputeMoments()");
+
+    const auto plo = m_geom.ProbLoArray();
+    const auto dxi = m_geom.InvCellSizeArray();
+    const auto dx  = m_geom.CellSizeArray();
+    const Box& domain = m_geom.Domain();
+    Real cell_vol = dx[0]*dx[1]*dx[2];
+    Real rain_mass = 4.0/3.0*PI*rhor*m_rain_radius*m_rain_radius*m_rain_radius;
+
+    mic_fab_vars[MicVar_SD::qcl]->setVal(0.);
+    mic_fab_vars[MicVar_SD::qp]->setVal(0.);
+
+    for (ERFPC::ParIterType pti(*m_pc, 0); pti.isValid(); ++pti) {
+        const Box& gbx = pti.validbox();
+        auto& aos = pti.GetArrayOfStructs();
+        const auto* p_pbox = aos().data();
+        const int np = aos.numParticles();
+
+        auto& soa = pti.GetStructOfArrays();
+        const auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        const auto* mult_ptr = soa.GetRealData(SDRealIdx::multiplicity).data();
+
+        auto rho_arr = mic_fab_vars[MicVar_SD::rho]->const_array(pti);
+        auto qc_arr  = mic_fab_vars[MicVar_SD::qcl]->array(pti);
+        auto qp_arr  = mic_fab_vars[MicVar_SD::qp]->array(pti);
+        const auto dJ_arr = (m_detJ_cc) ? m_detJ_cc->const_array(pti) : Array4<const Real>{};
+
+        ParallelFor(np, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            const auto& p = p_pbox[n];
+            if (p.id() <= 0) { return; }
+
+            IntVect iv = sd_cell(p, plo, dxi, domain, gbx);
+            Real vol = (dJ_arr) ? cell_vol*dJ_arr(iv) : cell_vol;
+            Real q = mult_ptr[n]*mass_ptr[n]/(rho_arr(iv)*vol);
+            if (mass_ptr[n] < rain_mass) {
+                Gpu::Atomic::AddNoRet(&qc_arr(iv), q);
+            } else {
+                Gpu::Atomic::AddNoRet(&qp_arr(iv), q);
+            }
+        });
+    }
+
+    MultiFab::Copy(*mic_fab_vars[MicVar_SD::qt], *mic_fab_vars[MicVar_SD::qv], 0, 0, 1, 0);
+    MultiFab::Add (*mic_fab_vars[MicVar_SD::qt], *mic_fab_vars[MicVar_SD::qcl], 0, 0, 1, 0);
+}
+
+#endif
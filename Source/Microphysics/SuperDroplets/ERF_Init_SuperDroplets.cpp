@@ -0,0 +1,181 @@
+#ifdef ERF_USE_PARTICLES
+
+#include <AMReX_ParmParse.H>
+#include "ERF_SuperDroplets.H"
+#include "ERF_EOS.H"
+
+using namespace amrex;
+
+SuperDroplets::SuperDroplets ()
+{
+    ParmParse pp(m_name);
+    pp.query("initial_number_density", m_init_number_density);
+    pp.query("initial_mean_radius", m_init_mean_radius);
+    pp.query("min_radius", m_min_radius);
+    pp.query("rain_radius", m_rain_radius);
+    pp.query("do_condensation", m_do_condensation);
+    pp.query("do_coalescence", m_do_coalescence);
+    pp.query("do_sedimentation", m_do_sedimentation);
+    pp.query("check_water", m_check_water);
+    pp.query("water_tol", m_water_tol);
+
+    std::string kernel = "hydrodynamic";
+    pp.query("collision_kernel", kernel);
+    if (kernel == "golovin") {
+        m_golovin_kernel = true;
+        pp.query("golovin_b", m_golovin_b);
+    } else if (kernel != "hydrodynamic") {
+        Abort("superdroplets.collision_kernel must be hydrodynamic or golovin");
+    }
+}
+
+/**
+ * Initializes the superdroplet module. The particle container is created and seeded
+ * on the first call; later calls (after a regrid of the base level) only rebuild
+ * the mesh variables on the new grids.
+ *
+ * @param[in] cons_in Conserved variables input
+ * @param[in] grids The boxes on which we will evolve the solution
+ * @param[in] geom Geometry associated with these MultiFabs and grids
+ * @param[in] dt_advance Timestep for the advance
+ * @param[in] z_phys_nd Nodal heights with terrain
+ * @param[in] detJ_cc Cell-centered Jacobian determinant with terrain
+ */
+void SuperDroplets::Init (const MultiFab& cons_in,
+                          const BoxArray& /*grids*/,
+                          const Geometry& geom,
+                          const Real& dt_advance,
+                          std::unique_ptr<MultiFab>& z_phys_nd,
+                          std::unique_ptr<MultiFab>& detJ_cc)
+{
+    dt = dt_advance;
+    m_geom = geom;
+
+    m_z_phys_nd = z_phys_nd.get();
+    m_detJ_cc   = detJ_cc.get();
+
+    MicVarMap.resize(m_qmoist_size);
+    MicVarMap = {MicVar_SD::qt, MicVar_SD::qv, MicVar_SD::qcl, MicVar_SD::qp, MicVar_SD::rain_accum};
+
+    // keep the accumulated rain over a regrid
+    FabPtr old_rain_accum = mic_fab_vars[MicVar_SD::rain_accum];
+
+    // initialize microphysics variables
+    for (auto ivar = 0; ivar < MicVar_SD::NumVars; ++ivar) {
+        mic_fab_vars[ivar] = std::make_shared<MultiFab>(cons_in.boxArray(), cons_in.DistributionMap(),
+                                                        1, cons_in.nGrowVect());
+        mic_fab_vars[ivar]->setVal(0.);
+    }
+    if (old_rain_accum) {
+        mic_fab_vars[MicVar_SD::rain_accum]->ParallelCopy(*old_rain_accum);
+    }
+
+    if (!m_pc) {
+        m_pc = new SuperDropletPC(geom, cons_in.DistributionMap(), cons_in.boxArray(), m_name);
+        InitializeDroplets();
+        Print() << "Initialized " << m_pc->TotalNumberOfParticles() << " superdroplets.\n";
+    } else {
+        // the base level has been regridded
+        m_pc->SetParticleBoxArray(0, cons_in.boxArray());
+        m_pc->SetParticleDistributionMap(0, cons_in.DistributionMap());
+        m_pc->Redistribute();
+    }
+}
+
+/**
+ * Replace the superdroplets seeded by Init with those of a checkpoint.
+ *
+ * @param[in] a_fname Checkpoint directory
+ */
+void SuperDroplets::Restart (const std::string& a_fname)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_pc, "SuperDroplets::Restart must follow Init");
+    auto ba = m_pc->ParticleBoxArray(0);
+    auto dm = m_pc->ParticleDistributionMap(0);
+    delete m_pc;
+    m_pc = new SuperDropletPC(m_geom, dm, ba, m_name);
+    m_pc->Restart(a_fname, m_name);
+    Print() << "Read " << m_pc->TotalNumberOfParticles() << " superdroplets from the checkpoint.\n";
+}
+
+/**
+ * Positions the droplets with the particle box initialization of ERFPC and samples
+ * their sizes from a distribution that is exponential in droplet volume. All droplets
+ * start with the same multiplicity, set by the initial number density.
+ */
+void SuperDroplets::InitializeDroplets ()
+{
+    std::unique_ptr<MultiFab> z_phys_nd;
+    if (m_z_phys_nd) {
+        z_phys_nd = std::make_unique<MultiFab>(*m_z_phys_nd, amrex::make_alias, 0, 1);
+    }
+    m_pc->InitializeParticles(z_phys_nd);
+
+    const auto dx = m_geom.CellSizeArray();
+    Real mult = m_init_number_density*dx[0]*dx[1]*dx[2] / m_pc->initialParticlesPerCell();
+    Real mean_vol = 4.0/3.0*PI*m_init_mean_radius*m_init_mean_radius*m_init_mean_radius;
+    Real min_vol  = 4.0/3.0*PI*m_min_radius*m_min_radius*m_min_radius;
+
+    for (ERFPC::ParIterType pti(*m_pc, 0); pti.isValid(); ++pti) {
+        auto& soa = pti.GetStructOfArrays();
+        const int np = pti.numParticles();
+        auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        auto* mult_ptr = soa.GetRealData(SDRealIdx::multiplicity).data();
+
+        ParallelForRNG(np, [=] AMREX_GPU_DEVICE (int n, const RandomEngine& engine) noexcept
+        {
+            Real vol = -mean_vol*std::log(amrex::max(Random(engine), Real(1.e-300)));
+            mass_ptr[n] = rhor*amrex::max(vol, min_vol);
+            mult_ptr[n] = mult;
+        });
+    }
+}
+
+/**
+ * Copies the state into the microphysics variables.
+ *
+ * @param[in] cons_in Conserved variables input
+ */
+void SuperDroplets::Copy_State_to_Micro (const MultiFab& cons_in)
+{
+    for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const auto& box3d = mfi.tilebox();
+
+        auto states_array = cons_in.const_array(mfi);
+
+        auto qt_array    = mic_fab_vars[MicVar_SD::qt]->array(mfi);
+        auto qv_array    = mic_fab_vars[MicVar_SD::qv]->array(mfi);
+        auto qc_array    = mic_fab_vars[MicVar_SD::qcl]->array(mfi);
+        auto qp_array    = mic_fab_vars[MicVar_SD::qp]->array(mfi);
+
+        auto rho_array   = mic_fab_vars[MicVar_SD::rho]->array(mfi);
+        auto theta_array = mic_fab_vars[MicVar_SD::theta]->array(mfi);
+        auto tabs_array  = mic_fab_vars[MicVar_SD::tabs]->array(mfi);
+        auto pres_array  = mic_fab_vars[MicVar_SD::pres]->array(mfi);
+
+        // Anelastic: temperature and pressure follow the reference state (p_0, pi_0)
+        const auto p0_array = (m_base_state) ? m_base_state->const_array(mfi) : Array4<const Real>{};
+
+        ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            rho_array(i,j,k)   = states_array(i,j,k,Rho_comp);
+            theta_array(i,j,k) = states_array(i,j,k,RhoTheta_comp)/states_array(i,j,k,Rho_comp);
+            qv_array(i,j,k)    = states_array(i,j,k,RhoQ1_comp)/states_array(i,j,k,Rho_comp);
+            qc_array(i,j,k)    = states_array(i,j,k,RhoQ2_comp)/states_array(i,j,k,Rho_comp);
+            qp_array(i,j,k)    = states_array(i,j,k,RhoQ3_comp)/states_array(i,j,k,Rho_comp);
+            qt_array(i,j,k)    = qv_array(i,j,k) + qc_array(i,j,k);
+
+            if (p0_array) {
+                tabs_array(i,j,k)  = theta_array(i,j,k) * p0_array(i,j,k,2);
+                pres_array(i,j,k)  = p0_array(i,j,k,1)/100.;
+            } else {
+                tabs_array(i,j,k)  = getTgivenRandRTh(states_array(i,j,k,Rho_comp),
+                                                      states_array(i,j,k,RhoTheta_comp),
+                                                      qv_array(i,j,k));
+                pres_array(i,j,k)  = getPgivenRTh(states_array(i,j,k,RhoTheta_comp), qv_array(i,j,k))/100.;
+            }
+        });
+    }
+}
+
+#endif
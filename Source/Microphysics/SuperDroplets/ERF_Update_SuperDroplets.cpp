@@ -0,0 +1,39 @@
+#ifdef ERF_USE_PARTICLES
+
+#include "ERF_SuperDroplets.H"
+#include "ERF_IndexDefines.H"
+
+using namespace amrex;
+
+/**
+ * Updates conserved variables from the internal MultiFabs of the superdroplet module.
+ *
+ * @param[out] cons Conserved variables
+ */
+void SuperDroplets::Copy_Micro_to_State (MultiFab& cons)
+{
+    for ( MFIter mfi(cons,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const auto& box3d = mfi.tilebox();
+
+        auto states_arr = cons.array(mfi);
+
+        auto rho_arr    = mic_fab_vars[MicVar_SD::rho]->array(mfi);
+        auto theta_arr  = mic_fab_vars[MicVar_SD::theta]->array(mfi);
+        auto qv_arr     = mic_fab_vars[MicVar_SD::qv]->array(mfi);
+        auto qc_arr     = mic_fab_vars[MicVar_SD::qcl]->array(mfi);
+        auto qp_arr     = mic_fab_vars[MicVar_SD::qp]->array(mfi);
+
+        ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            states_arr(i,j,k,RhoTheta_comp) = rho_arr(i,j,k)*theta_arr(i,j,k);
+            states_arr(i,j,k,RhoQ1_comp)    = rho_arr(i,j,k)*qv_arr(i,j,k);
+            states_arr(i,j,k,RhoQ2_comp)    = rho_arr(i,j,k)*qc_arr(i,j,k);
+            states_arr(i,j,k,RhoQ3_comp)    = rho_arr(i,j,k)*qp_arr(i,j,k);
+        });
+    }
+
+    // Fill interior ghost cells and periodic boundaries
+    cons.FillBoundary(m_geom.periodicity());
+}
+
+#endif
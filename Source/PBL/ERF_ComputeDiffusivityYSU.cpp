@@ -11,7 +11,7 @@ void
 ComputeDiffusivityYSU (const MultiFab& xvel,
                        const MultiFab& yvel,
                        const MultiFab& cons_in,
-                       MultiFab& eddyViscosity,
+                       AuxMultiFab& eddyViscosity,
                        const Geometry& geom,
                        const TurbChoice& turbChoice,
                        std::unique_ptr<ABLMost>& most,
@@ -159,7 +159,7 @@ ComputeDiffusivityYSU (const MultiFab& xvel,
 
             const auto& u_star_arr = most->get_u_star(level)->const_array(mfi);
             const auto& l_obuk_arr = most->get_olen(level)->const_array(mfi);
-            const Array4<Real      > &K_turb = eddyViscosity.array(mfi);
+            const Array4<AuxReal   > &K_turb = eddyViscosity.array(mfi);
 
             // Dirichlet flags to switch derivative stencil
             bool c_ext_dir_on_zlo = ( (bc_ptr[BCVars::cons_bc].lo(2) == ERFBCType::ext_dir) );
@@ -235,8 +235,8 @@ ComputeDiffusivityYSU (const MultiFab& xvel,
                 constexpr Real Kmax = 1000.0;
                 const Real rhoKmin = ckz * dz_terrain * rho;
                 const Real rhoKmax = rho * Kmax;
-                K_turb(i,j,k,EddyDiff::Mom_v) = std::max(std::min(K_turb(i,j,k,EddyDiff::Mom_v) ,rhoKmax), rhoKmin);
-                K_turb(i,j,k,EddyDiff::Theta_v) = std::max(std::min(K_turb(i,j,k,EddyDiff::Theta_v) ,rhoKmax), rhoKmin);
+                K_turb(i,j,k,EddyDiff::Mom_v) = std::max(std::min(Real(K_turb(i,j,k,EddyDiff::Mom_v)) ,rhoKmax), rhoKmin);
+                K_turb(i,j,k,EddyDiff::Theta_v) = std::max(std::min(Real(K_turb(i,j,k,EddyDiff::Theta_v)) ,rhoKmax), rhoKmin);
                 K_turb(i,j,k,EddyDiff::PBL_lengthscale) = pblh_arr(i,j,0);
             });
 
@@ -6,6 +6,8 @@
 #include <ERF_Constants.H>
 #include <AMReX_TracerParticle_mod_K.H>
 
+#include <limits>
+
 using namespace amrex;
 
 /*! Evolve particles for one time step */
@@ -25,10 +27,98 @@ void ERFPC::EvolveParticles ( int                                        a_lev,
         AdvectWithGravity( a_lev, a_dt_lev, a_z_phys_nd[a_lev] );
     }
 
-    Redistribute();
+    // The interpolation stencils of the midpoint update reach one cell beyond the cell
+    // holding the particle, and the midpoint itself may lie in the next cell, so the
+    // slack is limited by the ghost cells of the velocity and height fields
+    m_slack_allowed = std::numeric_limits<int>::max();
+    if (m_advect_w_flow) {
+        for (int i = 0; i < AMREX_SPACEDIM; i++) {
+            m_slack_allowed = std::min(m_slack_allowed,
+                                       a_flow_vars[a_lev][Vars::xvel+i].nGrowVect().min() - 2);
+        }
+    }
+    if (a_z_phys_nd[a_lev]) {
+        m_slack_allowed = std::min(m_slack_allowed, a_z_phys_nd[a_lev]->nGrowVect().min() - 2);
+    }
+    m_slack_allowed = std::max(m_slack_allowed, 0);
+
+    RedistributeIfNeeded();
+
+    if (a_lev == 0 && m_sort_int > 0 && (++m_nsteps % m_sort_int == 0)) {
+        SortParticlesByCell();
+    }
     return;
 }
 
+/*! Redistribute only when the grids have changed or a particle has left its tile by
+ *  more than the allowed slack */
+void ERFPC::RedistributeIfNeeded ()
+{
+    BL_PROFILE("ERFPC::RedistributeIfNeeded()");
+
+    // After a regrid or a rebalance the particles are still binned by the old grids,
+    // so the tile check below cannot be trusted; the layout is the same on every rank
+    bool needs_redistribute = (m_redistribute_slack < 0) || LayoutChanged();
+
+    if (!needs_redistribute) {
+        int slack = redistributeSlack();
+        for (int lev = 0; lev <= finestLevel() && !needs_redistribute; lev++) {
+            needs_redistribute = NeedsRedistribute(lev, slack);
+        }
+        ParallelDescriptor::ReduceBoolOr(needs_redistribute);
+    }
+
+    if (needs_redistribute) {
+        Redistribute();
+
+        m_redist_ba.resize(finestLevel()+1);
+        m_redist_dm.resize(finestLevel()+1);
+        for (int lev = 0; lev <= finestLevel(); lev++) {
+            m_redist_ba[lev] = ParticleBoxArray(lev);
+            m_redist_dm[lev] = ParticleDistributionMap(lev);
+        }
+    }
+}
+
+/*! Compare the current grids and distribution with those of the last redistribution */
+bool ERFPC::LayoutChanged () const
+{
+    if (m_redist_ba.size() != finestLevel()+1) { return true; }
+    for (int lev = 0; lev <= finestLevel(); lev++) {
+        if (ParticleBoxArray(lev) != m_redist_ba[lev] ||
+            ParticleDistributionMap(lev) != m_redist_dm[lev]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*! Local check for particles outside of their tile grown by a_slack, or outside the domain */
+bool ERFPC::NeedsRedistribute (int a_lev, int a_slack) const
+{
+    const Geometry& geom = Geom(a_lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const Box& domain = geom.Domain();
+
+    bool found = false;
+    for (ParConstIterType pti(*this, a_lev); pti.isValid() && !found; ++pti)
+    {
+        const Box bx = amrex::grow(pti.tilebox(), a_slack) & domain;
+        const auto& aos = pti.GetArrayOfStructs();
+        const ParticleType* p_pbox = aos().data();
+
+        found = Reduce::AnyOf(aos.numParticles(), p_pbox,
+            [=] AMREX_GPU_DEVICE (ParticleType const& p) noexcept -> bool
+            {
+                if (p.id() <= 0) { return true; }
+                IntVect iv = ERFParticlesAssignor{}(p, plo, dxi, domain);
+                return !bx.contains(iv);
+            });
+    }
+    return found;
+}
+
 /*! Uses midpoint method to advance particles using flow velocity. */
 void ERFPC::AdvectWithFlow ( MultiFab*                           a_umac,
                              int                                 a_lev,
@@ -141,6 +231,7 @@ void ERFPC::AdvectWithFlow ( MultiFab*                           a_umac,
     if (m_verbose > 1)
     {
         auto stoptime = amrex::second() - strttime;
+        Long npart = NumberOfParticlesAtLevel(a_lev);
 
 #ifdef AMREX_LAZY
         Lazy::QueueReduction( [=] () mutable {
@@ -148,7 +239,8 @@ void ERFPC::AdvectWithFlow ( MultiFab*                           a_umac,
                 ParallelReduce::Max(stoptime, ParallelContext::IOProcessorNumberSub(),
                                     ParallelContext::CommunicatorSub());
 
-                Print() << "ERFPC::AdvectWithFlow() time: " << stoptime << '\n';
+                Print() << "ERFPC::AdvectWithFlow() time: " << stoptime
+                        << " (" << Real(npart)/stoptime << " particles/s)\n";
 #ifdef AMREX_LAZY
         });
 #endif
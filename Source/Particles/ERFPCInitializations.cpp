@@ -49,6 +49,18 @@ void ERFPC::readInputs ()
     m_advect_w_gravity = (m_name == ERFParticleNames::hydro ? true : false);
     pp.query("advect_with_gravity", m_advect_w_gravity);
 
+    // Particles are only redistributed once one of them has moved more than this many
+    // cells outside of its tile; a negative value redistributes after every step
+    m_redistribute_slack = 0;
+    pp.query("redistribute_slack", m_redistribute_slack);
+
+    // Sort the particles by cell every sort_int level 0 steps; never if sort_int <= 0
+    m_sort_int = -1;
+    pp.query("sort_int", m_sort_int);
+
+    int verbose = 0;
+    if (pp.query("verbose", verbose)) { SetVerbose(verbose); }
+
     return;
 }
 
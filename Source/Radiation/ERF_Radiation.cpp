@@ -49,6 +49,20 @@ namespace internal {
         fluxes.bnd_flux_dn_dir = real3d("flux_dn_dir", nz, nlay+1, nbands);
     }
 
+    // Zero all broadband and band-by-band fluxes
+    void reset_fluxes (FluxesByband& fluxes)
+    {
+        yakl::memset(fluxes.flux_up    , 0.);
+        yakl::memset(fluxes.flux_dn    , 0.);
+        yakl::memset(fluxes.flux_net   , 0.);
+        yakl::memset(fluxes.flux_dn_dir, 0.);
+
+        yakl::memset(fluxes.bnd_flux_up    , 0.);
+        yakl::memset(fluxes.bnd_flux_dn    , 0.);
+        yakl::memset(fluxes.bnd_flux_net   , 0.);
+        yakl::memset(fluxes.bnd_flux_dn_dir, 0.);
+    }
+
     void expand_day_fluxes (const FluxesByband& daytime_fluxes,
                             FluxesByband& expanded_fluxes,
                             const int1d& day_indices)
@@ -120,9 +134,6 @@ void Radiation::initialize (const MultiFab& cons_in,
 
     qrad_src = qheating_rates;
 
-    auto dz   = m_geom.CellSize(2);
-    auto lowz = m_geom.ProbLo(2);
-
     dt = dt_advance;
 
     do_short_wave_rad = do_sw_rad;
@@ -137,69 +148,120 @@ void Radiation::initialize (const MultiFab& cons_in,
     m_lsm_fluxes = lsm_fluxes;
     m_lsm_zenith = lsm_zenith;
 
-    rrtmgp_data_path = getRadiationDataDir() + "/";
-    rrtmgp_coefficients_file_sw = rrtmgp_data_path + rrtmgp_coefficients_file_name_sw;
-    rrtmgp_coefficients_file_lw = rrtmgp_data_path + rrtmgp_coefficients_file_name_lw;
-
     ParmParse pp("erf");
     pp.query("fixed_total_solar_irradiance", fixed_total_solar_irradiance);
     pp.query("radiation_uniform_angle"     , uniform_angle);
     pp.query("moisture_model", moisture_type); // TODO: get from SolverChoice?
     has_qmoist = (moisture_type != "None");
 
-    nlev = geom.Domain().length(2);
-    ncol = geom.Domain().length(0) * geom.Domain().length(1);
+    m_cons_in = &cons_in;
+    m_qmoist  = qmoist;
+
+    // Split the level into chunks of whole rows; the work arrays hold one chunk
+    const Box& domain = geom.Domain();
+    const int nx_dom = domain.length(0);
+    const int ny_dom = domain.length(1);
+    m_chunk_rows = (rad_chunk_size > 0) ? std::min(ny_dom, std::max(1, rad_chunk_size/nx_dom)) : ny_dom;
+    m_nchunks    = (ny_dom + m_chunk_rows - 1) / m_chunk_rows;
+
+    nlev = domain.length(2);
+    ncol = nx_dom * m_chunk_rows;
     ngas = active_gases.size();
 
-    // initialize cloud, aerosol, and radiation
-    radiation.initialize(ngas, active_gases,
-                         rrtmgp_coefficients_file_sw.c_str(),
-                         rrtmgp_coefficients_file_lw.c_str());
+    // The k-distribution coefficients only need to be read once
+    if (!m_rrtmgp_initialized) {
+        rrtmgp_data_path = getRadiationDataDir() + "/";
+        rrtmgp_coefficients_file_sw = rrtmgp_data_path + rrtmgp_coefficients_file_name_sw;
+        rrtmgp_coefficients_file_lw = rrtmgp_data_path + rrtmgp_coefficients_file_name_lw;
+
+        // initialize cloud, aerosol, and radiation
+        radiation.initialize(ngas, active_gases,
+                             rrtmgp_coefficients_file_sw.c_str(),
+                             rrtmgp_coefficients_file_lw.c_str());
+
+        // initialize the radiation data
+        nswbands = radiation.get_nband_sw();
+        nswgpts  = radiation.get_ngpt_sw();
+        nlwbands = radiation.get_nband_lw();
+        nlwgpts  = radiation.get_ngpt_lw();
+
+        rrtmg_to_rrtmgp = int1d("rrtmg_to_rrtmgp",14);
+        parallel_for(14, YAKL_LAMBDA (int i)
+        {
+            if (i == 1) {
+                rrtmg_to_rrtmgp(i) = 13;
+            } else {
+                rrtmg_to_rrtmgp(i) = i - 1;
+            }
+        });
 
-    // initialize the radiation data
-    nswbands = radiation.get_nband_sw();
-    nswgpts  = radiation.get_ngpt_sw();
-    nlwbands = radiation.get_nband_lw();
-    nlwgpts  = radiation.get_ngpt_lw();
+        amrex::Print() << "LW coefficients file: " << rrtmgp_coefficients_file_lw
+                       << "\nSW coefficients file: " << rrtmgp_coefficients_file_sw
+                       << "\nFrequency (timesteps) of Radiation calc: " << rad_int
+                       << "\nFrequency (seconds) of Radiation calc:   " << rad_per
+                       << "\nDo aerosol radiative calculations: " << do_aerosol_rad << std::endl;
 
-    rrtmg_to_rrtmgp = int1d("rrtmg_to_rrtmgp",14);
-    parallel_for(14, YAKL_LAMBDA (int i)
-    {
-        if (i == 1) {
-            rrtmg_to_rrtmgp(i) = 13;
-        } else {
-            rrtmg_to_rrtmgp(i) = i - 1;
+        m_rrtmgp_initialized = true;
+    }
+
+    // The work arrays persist between calls; only reallocate if the level size changed
+    if (ncol != m_buf_ncol || nlev != m_buf_nlev) {
+        alloc_buffers();
+    }
+}
+
+
+// run radiation model
+void Radiation::run ()
+{
+    const Box& domain = m_geom.Domain();
+    const int ny_dom = domain.length(1);
+
+    // The same work arrays are reused for every chunk of rows
+    for (int ichunk = 0; ichunk < m_nchunks; ++ichunk) {
+        int jlo = domain.smallEnd(1) + ichunk*m_chunk_rows;
+        int jhi = std::min(jlo + m_chunk_rows, domain.smallEnd(1) + ny_dom) - 1;
+        m_chunk_box = domain;
+        m_chunk_box.setRange(1, jlo, jhi-jlo+1);
+        m_chunk_nvalid = m_chunk_box.length(0) * m_chunk_box.length(1);
+
+        // Skip chunks with no cells on this rank
+        bool has_cells = false;
+        for (MFIter mfi(*qrad_src); mfi.isValid(); ++mfi) {
+            if (mfi.validbox().intersects(m_chunk_box)) { has_cells = true; break; }
         }
-    });
+        if (!has_cells) continue;
 
-    tmid = real2d("tmid", ncol, nlev);
-    pmid = real2d("pmid", ncol, nlev);
-    pdel = real2d("pdel", ncol, nlev);
+        fill_chunk_state();
+        run_chunk();
+    }
+}
 
-    pint = real2d("pint", ncol, nlev+1);
-    tint = real2d("tint", ncol, nlev+1);
+// copy the state in the current chunk of rows into the column arrays
+void Radiation::fill_chunk_state ()
+{
+    auto dz   = m_geom.CellSize(2);
+    auto lowz = m_geom.ProbLo(2);
 
-    qt   = real2d("qt", ncol, nlev);
-    qc   = real2d("qc", ncol, nlev);
-    qi   = real2d("qi", ncol, nlev);
-    qn   = real2d("qn", ncol, nlev);
-    zi   = real2d("zi", ncol, nlev);
+    const int ilo = m_chunk_box.smallEnd(0);
+    const int jlo = m_chunk_box.smallEnd(1);
+    const int nx  = m_chunk_box.length(0);
 
     // Get the temperature, density, theta, qt and qp from input
-    for (MFIter mfi(cons_in, TileNoZ()); mfi.isValid(); ++mfi) {
-        const auto& box3d = mfi.tilebox();
-        auto nx = box3d.length(0);
+    for (MFIter mfi(*m_cons_in, TileNoZ()); mfi.isValid(); ++mfi) {
+        const auto& box3d = mfi.tilebox() & m_chunk_box;
+        if (!box3d.ok()) continue;
 
-        auto states_array = cons_in.array(mfi);
-        auto qt_array = (has_qmoist) ? qmoist[0]->array(mfi) : Array4<Real> {};
-        auto qv_array = (has_qmoist) ? qmoist[1]->array(mfi) : Array4<Real> {};
-        auto qc_array = (has_qmoist) ? qmoist[2]->array(mfi) : Array4<Real> {};
-        auto qi_array = (has_qmoist && qmoist.size()>=8) ? qmoist[3]->array(mfi) : Array4<Real> {};
+        auto states_array = m_cons_in->const_array(mfi);
+        auto qt_array = (has_qmoist) ? m_qmoist[0]->array(mfi) : Array4<Real> {};
+        auto qv_array = (has_qmoist) ? m_qmoist[1]->array(mfi) : Array4<Real> {};
+        auto qc_array = (has_qmoist) ? m_qmoist[2]->array(mfi) : Array4<Real> {};
+        auto qi_array = (has_qmoist && m_qmoist.size()>=8) ? m_qmoist[3]->array(mfi) : Array4<Real> {};
 
         // Get pressure, theta, temperature, density, and qt, qp
         ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            auto icol = j*nx+i+1;
+            auto icol = (j-jlo)*nx + (i-ilo) + 1;
             auto ilev = k+1;
             Real qv         = (qv_array) ? qv_array(i,j,k): 0.0;
             qt(icol,ilev)   = (qt_array) ? qt_array(i,j,k): 0.0;
@@ -212,6 +274,14 @@ void Radiation::initialize (const MultiFab& cons_in,
         });
     }
 
+    // The last chunk may be short; give its padding columns valid data
+    pad_chunk_columns(qt);
+    pad_chunk_columns(qc);
+    pad_chunk_columns(qi);
+    pad_chunk_columns(qn);
+    pad_chunk_columns(tmid);
+    pad_chunk_columns(pmid);
+
     parallel_for(SimpleBounds<2>(ncol, nlev+1), YAKL_LAMBDA (int icol, int ilev)
     {
         if (ilev == 1) {
@@ -231,87 +301,32 @@ void Radiation::initialize (const MultiFab& cons_in,
         zi(icol, ilev)  = lowz + (ilev+0.5)*dz;
         pdel(icol,ilev) = pint(icol,ilev+1) - pint(icol,ilev);
     });
-
-    albedo_dir = real2d("albedo_dir", nswbands, ncol);
-    albedo_dif = real2d("albedo_dif", nswbands, ncol);
-
-    qrs = real2d("qrs", ncol, nlev);   // shortwave radiative heating rate
-    qrl = real2d("qrl", ncol, nlev);   // longwave  radiative heating rate
-
-    // Clear-sky heating rates are not on the physics buffer, and we have no
-    // reason to put them there, so declare these are regular arrays here
-    qrsc = real2d("qrsc", ncol, nlev);
-    qrlc = real2d("qrlc", ncol, nlev);
-
-    int nmodes = 3;
-    int nrh = 1;
-    int top_lev = 1;
-    naer = 4;
-    std::vector<std::string> aero_names {"H2O", "N2", "O2", "O3"};
-    auto geom_radius = real2d("geom_radius", ncol, nlev);
-    yakl::memset(geom_radius, 0.1);
-
-    optics.initialize(ngas, nmodes, naer, nswbands, nlwbands,
-                      ncol, nlev, nrh, top_lev, aero_names, zi,
-                      pmid, pdel, tmid, qt, geom_radius);
-
-    amrex::Print() << "LW coefficients file: " << rrtmgp_coefficients_file_lw
-                   << "\nSW coefficients file: " << rrtmgp_coefficients_file_sw
-                   << "\nFrequency (timesteps) of Shortwave Radiation calc: " << dt
-                   << "\nFrequency (timesteps) of Longwave Radiation calc:  " << dt
-                   << "\nDo aerosol radiative calculations: " << do_aerosol_rad << std::endl;
-
 }
 
-
-// run radiation model
-void Radiation::run ()
+// columns past the end of a short last chunk hold copies of the valid columns
+void Radiation::pad_chunk_columns (const real2d& data)
 {
-    // Cosine solar zenith angle for all columns in chunk
-    coszrs = real1d("coszrs", ncol);
-
-    // Pointers to fields on the physics buffer
-    cld = real2d("cld", ncol, nlev);
-    cldfsnow = real2d("cldfsnow", ncol, nlev);
-    iclwp = real2d("iclwp", ncol, nlev);
-    iciwp = real2d("iciwp", ncol, nlev);
-    icswp = real2d("icswp", ncol, nlev);
-    dei = real2d("dei", ncol, nlev);
-    des = real2d("des", ncol, nlev);
-    lambdac = real2d("lambdac", ncol, nlev);
-    mu = real2d("mu", ncol, nlev);
-    rei = real2d("rei", ncol, nlev);
-    rel = real2d("rel", ncol, nlev);
-
-    // Cloud, snow, and aerosol optical properties
-    cld_tau_gpt_sw = real3d("cld_tau_gpt_sw", ncol, nlev, nswgpts);
-    cld_ssa_gpt_sw = real3d("cld_ssa_gpt_sw", ncol, nlev, nswgpts);
-    cld_asm_gpt_sw = real3d("cld_asm_gpt_sw", ncol, nlev, nswgpts);
-
-    cld_tau_bnd_sw = real3d("cld_tau_bnd_sw", ncol, nlev, nswbands);
-    cld_ssa_bnd_sw = real3d("cld_ssa_bnd_sw", ncol, nlev, nswbands);
-    cld_asm_bnd_sw = real3d("cld_asm_bnd_sw", ncol, nlev, nswbands);
-
-    aer_tau_bnd_sw = real3d("aer_tau_bnd_sw", ncol, nlev, nswbands);
-    aer_ssa_bnd_sw = real3d("aer_ssa_bnd_sw", ncol, nlev, nswbands);
-    aer_asm_bnd_sw = real3d("aer_asm_bnd_sw", ncol, nlev, nswbands);
-
-    cld_tau_bnd_lw = real3d("cld_tau_bnd_lw", ncol, nlev, nlwbands);
-    aer_tau_bnd_lw = real3d("aer_tau_bnd_lw", ncol, nlev, nlwbands);
-
-    cld_tau_gpt_lw = real3d("cld_tau_gpt_lw", ncol, nlev, nlwgpts);
-
-    // NOTE: these are diagnostic only
-    liq_tau_bnd_sw = real3d("liq_tau_bnd_sw", ncol, nlev, nswbands);
-    ice_tau_bnd_sw = real3d("ice_tau_bnd_sw", ncol, nlev, nswbands);
-    snw_tau_bnd_sw = real3d("snw_tau_bnd_sw", ncol, nlev, nswbands);
-    liq_tau_bnd_lw = real3d("liq_tau_bnd_lw", ncol, nlev, nlwbands);
-    ice_tau_bnd_lw = real3d("ice_tau_bnd_lw", ncol, nlev, nlwbands);
-    snw_tau_bnd_lw = real3d("snw_tau_bnd_lw", ncol, nlev, nlwbands);
+    const int nvalid = m_chunk_nvalid;
+    if (nvalid >= ncol) return;
+    parallel_for(SimpleBounds<2>(ncol-nvalid, size(data,2)), YAKL_LAMBDA (int ipad, int ilev)
+    {
+        data(nvalid+ipad,ilev) = data((nvalid+ipad-1)%nvalid+1,ilev);
+    });
+}
 
-    // Gas volume mixing ratios
-    gas_vmr = real3d("gas_vmr", ngas, ncol, nlev);
+void Radiation::pad_chunk_columns (const real1d& data)
+{
+    const int nvalid = m_chunk_nvalid;
+    if (nvalid >= ncol) return;
+    parallel_for(SimpleBounds<1>(ncol-nvalid), YAKL_LAMBDA (int ipad)
+    {
+        data(nvalid+ipad) = data((nvalid+ipad-1)%nvalid+1);
+    });
+}
 
+// radiation for the columns of the current chunk
+void Radiation::run_chunk ()
+{
     // Needed for shortwave aerosol;
     //int nday, nnight;     // Number of daylight columns
     int1d day_indices("day_indices", ncol), night_indices("night_indices", ncol);   // Indices of daylight coumns
@@ -326,23 +341,17 @@ void Radiation::run ()
     // Zero-array for cloud properties if not diagnosed by microphysics
     real2d zeros("zeros", ncol, nlev);
 
-    gpoint_bands_sw = int1d("gpoint_bands_sw", nswgpts);
-    gpoint_bands_lw = int1d("gpoint_bands_lw", nlwgpts);
-
     // Do shortwave stuff...
     if (do_short_wave_rad) {
-        // Radiative fluxes
-        internal::initial_fluxes(ncol, nlev+1, nswbands, sw_fluxes_allsky);
-        internal::initial_fluxes(ncol, nlev+1, nswbands, sw_fluxes_clrsky);
-
         // TODO: Integrate calendar day computation
         int calday = 1;
         // Get cosine solar zenith angle for current time step.
         if (m_lat) {
-            zenith(calday, m_lat, m_lon, coszrs, ncol,
+            zenith(calday, m_lat, m_lon, coszrs, ncol, m_chunk_box,
                    eccen,  mvelpp, lambm0, obliqr);
+            pad_chunk_columns(coszrs);
         } else {
-            zenith(calday, m_lat, m_lon, coszrs, ncol,
+            zenith(calday, m_lat, m_lon, coszrs, ncol, m_chunk_box,
                    eccen,  mvelpp, lambm0, obliqr, uniform_angle);
         }
 
@@ -380,13 +389,6 @@ void Radiation::run ()
         // We need to fix band ordering because the old input files assume RRTMG
         // band ordering, but this has changed in RRTMGP.
         // TODO: fix the input files themselves!
-        cld_tau_bnd_sw_1d = real1d("cld_tau_bnd_sw_1d", nswbands);
-        cld_ssa_bnd_sw_1d = real1d("cld_ssa_bnd_sw_1d", nswbands);
-        cld_asm_bnd_sw_1d = real1d("cld_asm_bnd_sw_1d", nswbands);
-        cld_tau_bnd_sw_o_1d = real1d("cld_tau_bnd_sw_1d", nswbands);
-        cld_ssa_bnd_sw_o_1d = real1d("cld_ssa_bnd_sw_1d", nswbands);
-        cld_asm_bnd_sw_o_1d = real1d("cld_asm_bnd_sw_1d", nswbands);
-
         parallel_for(SimpleBounds<2>(ncol, nlev), YAKL_LAMBDA (int icol, int ilay)
         {
             for (auto ibnd = 1; ibnd <= nswbands; ++ibnd) {
@@ -503,10 +505,6 @@ void Radiation::run ()
 
     // Do longwave stuff...
     if (do_long_wave_rad) {
-        // Allocate longwave outputs; why is this not part of the fluxes_t object?
-        internal::initial_fluxes(ncol, nlev, nlwbands, lw_fluxes_allsky);
-        internal::initial_fluxes(ncol, nlev, nlwbands, lw_fluxes_clrsky);
-
         // NOTE: fluxes defined at interfaces, so initialize to have vertical dimension nlev_rad+1
         yakl::memset(cld_tau_gpt_lw, 0.);
 
@@ -548,14 +546,17 @@ void Radiation::run ()
     } // dolw
 
     // Populate source term for theta dycore variable
+    const int ilo = m_chunk_box.smallEnd(0);
+    const int jlo = m_chunk_box.smallEnd(1);
+    const int nx  = m_chunk_box.length(0);
     for (MFIter mfi(*(qrad_src)); mfi.isValid(); ++mfi) {
         auto qrad_src_array = qrad_src->array(mfi);
-        const auto& box3d = mfi.tilebox();
-        auto nx = box3d.length(0);
+        const auto& box3d = mfi.tilebox() & m_chunk_box;
+        if (!box3d.ok()) continue;
         amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
             // Map (col,lev) to (i,j,k)
-            auto icol = j*nx+i+1;
+            auto icol = (j-jlo)*nx + (i-ilo) + 1;
             auto ilev = k+1;
 
             // TODO: We do not include the cloud source term qrsc/qrlc.
@@ -568,6 +569,138 @@ void Radiation::run ()
     }
 }
 
+// allocate the work arrays that persist between radiation calls
+void Radiation::alloc_buffers ()
+{
+    tmid = real2d("tmid", ncol, nlev);
+    pmid = real2d("pmid", ncol, nlev);
+    pdel = real2d("pdel", ncol, nlev);
+
+    pint = real2d("pint", ncol, nlev+1);
+    tint = real2d("tint", ncol, nlev+1);
+
+    qt   = real2d("qt", ncol, nlev);
+    qc   = real2d("qc", ncol, nlev);
+    qi   = real2d("qi", ncol, nlev);
+    qn   = real2d("qn", ncol, nlev);
+    zi   = real2d("zi", ncol, nlev);
+
+    albedo_dir = real2d("albedo_dir", nswbands, ncol);
+    albedo_dif = real2d("albedo_dif", nswbands, ncol);
+
+    qrs = real2d("qrs", ncol, nlev);   // shortwave radiative heating rate
+    qrl = real2d("qrl", ncol, nlev);   // longwave  radiative heating rate
+
+    // Clear-sky heating rates are not on the physics buffer, and we have no
+    // reason to put them there, so declare these are regular arrays here
+    qrsc = real2d("qrsc", ncol, nlev);
+    qrlc = real2d("qrlc", ncol, nlev);
+
+    // Cosine solar zenith angle for all columns in chunk
+    coszrs = real1d("coszrs", ncol);
+
+    // Pointers to fields on the physics buffer
+    cld = real2d("cld", ncol, nlev);
+    cldfsnow = real2d("cldfsnow", ncol, nlev);
+    iclwp = real2d("iclwp", ncol, nlev);
+    iciwp = real2d("iciwp", ncol, nlev);
+    icswp = real2d("icswp", ncol, nlev);
+    dei = real2d("dei", ncol, nlev);
+    des = real2d("des", ncol, nlev);
+    lambdac = real2d("lambdac", ncol, nlev);
+    mu = real2d("mu", ncol, nlev);
+    rei = real2d("rei", ncol, nlev);
+    rel = real2d("rel", ncol, nlev);
+
+    // Cloud, snow, and aerosol optical properties
+    cld_tau_gpt_sw = real3d("cld_tau_gpt_sw", ncol, nlev, nswgpts);
+    cld_ssa_gpt_sw = real3d("cld_ssa_gpt_sw", ncol, nlev, nswgpts);
+    cld_asm_gpt_sw = real3d("cld_asm_gpt_sw", ncol, nlev, nswgpts);
+
+    cld_tau_bnd_sw = real3d("cld_tau_bnd_sw", ncol, nlev, nswbands);
+    cld_ssa_bnd_sw = real3d("cld_ssa_bnd_sw", ncol, nlev, nswbands);
+    cld_asm_bnd_sw = real3d("cld_asm_bnd_sw", ncol, nlev, nswbands);
+
+    aer_tau_bnd_sw = real3d("aer_tau_bnd_sw", ncol, nlev, nswbands);
+    aer_ssa_bnd_sw = real3d("aer_ssa_bnd_sw", ncol, nlev, nswbands);
+    aer_asm_bnd_sw = real3d("aer_asm_bnd_sw", ncol, nlev, nswbands);
+
+    cld_tau_bnd_lw = real3d("cld_tau_bnd_lw", ncol, nlev, nlwbands);
+    aer_tau_bnd_lw = real3d("aer_tau_bnd_lw", ncol, nlev, nlwbands);
+
+    cld_tau_gpt_lw = real3d("cld_tau_gpt_lw", ncol, nlev, nlwgpts);
+
+    // NOTE: these are diagnostic only
+    liq_tau_bnd_sw = real3d("liq_tau_bnd_sw", ncol, nlev, nswbands);
+    ice_tau_bnd_sw = real3d("ice_tau_bnd_sw", ncol, nlev, nswbands);
+    snw_tau_bnd_sw = real3d("snw_tau_bnd_sw", ncol, nlev, nswbands);
+    liq_tau_bnd_lw = real3d("liq_tau_bnd_lw", ncol, nlev, nlwbands);
+    ice_tau_bnd_lw = real3d("ice_tau_bnd_lw", ncol, nlev, nlwbands);
+    snw_tau_bnd_lw = real3d("snw_tau_bnd_lw", ncol, nlev, nlwbands);
+
+    // Gas volume mixing ratios
+    gas_vmr = real3d("gas_vmr", ngas, ncol, nlev);
+
+    gpoint_bands_sw = int1d("gpoint_bands_sw", nswgpts);
+    gpoint_bands_lw = int1d("gpoint_bands_lw", nlwgpts);
+
+    // Radiative fluxes
+    internal::initial_fluxes(ncol, nlev+1, nswbands, sw_fluxes_allsky);
+    internal::initial_fluxes(ncol, nlev+1, nswbands, sw_fluxes_clrsky);
+    internal::initial_fluxes(ncol, nlev, nlwbands, lw_fluxes_allsky);
+    internal::initial_fluxes(ncol, nlev, nlwbands, lw_fluxes_clrsky);
+
+    cld_tau_bnd_sw_1d = real1d("cld_tau_bnd_sw_1d", nswbands);
+    cld_ssa_bnd_sw_1d = real1d("cld_ssa_bnd_sw_1d", nswbands);
+    cld_asm_bnd_sw_1d = real1d("cld_asm_bnd_sw_1d", nswbands);
+    cld_tau_bnd_sw_o_1d = real1d("cld_tau_bnd_sw_1d", nswbands);
+    cld_ssa_bnd_sw_o_1d = real1d("cld_ssa_bnd_sw_1d", nswbands);
+    cld_asm_bnd_sw_o_1d = real1d("cld_asm_bnd_sw_1d", nswbands);
+
+    // The optics keep references to the state arrays above
+    int nmodes = 3;
+    int nrh = 1;
+    int top_lev = 1;
+    naer = 4;
+    std::vector<std::string> aero_names {"H2O", "N2", "O2", "O3"};
+    auto geom_radius = real2d("geom_radius", ncol, nlev);
+    yakl::memset(geom_radius, 0.1);
+
+    optics.initialize(ngas, nmodes, naer, nswbands, nlwbands,
+                      ncol, nlev, nrh, top_lev, aero_names, zi,
+                      pmid, pdel, tmid, qt, geom_radius);
+
+    m_buf_ncol = ncol;
+    m_buf_nlev = nlev;
+}
+
+// decide whether radiation is called on this step; between calls the heating
+// rates from the last call are reused as the theta source
+bool Radiation::call_due (int lev, int nstep, Real time, const BoxArray& ba)
+{
+    if (static_cast<int>(m_last_call_idx.size()) <= lev) {
+        m_last_call_idx.resize(lev+1, -1);
+        m_last_call_ba.resize(lev+1);
+    }
+
+    // The heating rates are reset when the level is (re)made, so always call then
+    bool due = (m_last_call_idx[lev] < 0) || (m_last_call_ba[lev] != ba);
+
+    int idx;
+    if (rad_per > 0.0) {
+        idx = static_cast<int>(std::floor(time/rad_per + 1.0e-8));
+    } else {
+        idx = nstep / rad_int;
+    }
+    if (idx != m_last_call_idx[lev]) due = true;
+
+    if (due) {
+        m_last_call_idx[lev] = idx;
+        m_last_call_ba[lev]  = ba;
+    }
+    return due;
+}
+
 void Radiation::radiation_driver_sw (int ncol, const real3d& gas_vmr,
                                      const real2d& pmid, const real2d& pint, const real2d& tmid,
                                      const real2d& albedo_dir, const real2d& albedo_dif, const real1d& coszrs,
@@ -647,10 +780,13 @@ void Radiation::radiation_driver_sw (int ncol, const real3d& gas_vmr,
     nday.deep_copy_to(num_day);
     nnight.deep_copy_to(num_night);
 
+    // The flux arrays are kept between calls, so night columns (which
+    // expand_day_fluxes does not touch) must be zeroed on every call
+    internal::reset_fluxes(fluxes_allsky);
+    internal::reset_fluxes(fluxes_clrsky);
+
     // If no daytime columns in this chunk, then we return zeros
     if (num_day(1) == 0) {
-        //    reset_fluxes(fluxes_allsky)
-        //    reset_fluxes(fluxes_clrsky)
         yakl::memset(qrs, 0.);
         yakl::memset(qrsc, 0.);
         return;
@@ -978,6 +1114,13 @@ Radiation::export_surface_fluxes(FluxesByband& fluxes,
     // No work to be done if we don't have valid pointers
     if (!m_lsm_fluxes) return;
 
+    // The LSM fluxes are 2D; map the cells of the current chunk to columns
+    const int ilo = m_chunk_box.smallEnd(0);
+    const int jlo = m_chunk_box.smallEnd(1);
+    const int nx  = m_chunk_box.length(0);
+    Box cbx2d(m_chunk_box);
+    cbx2d.setRange(2,0);
+
     if (band == "shortwave") {
         real3d flux_dn_diffuse("flux_dn_diffuse", ncol, nlev+1, nswbands);
 
@@ -992,12 +1135,12 @@ Radiation::export_surface_fluxes(FluxesByband& fluxes,
         // Populate the LSM data structure (this is a 2D MF)
         for (MFIter mfi(*(m_lsm_fluxes)); mfi.isValid(); ++mfi) {
             auto lsm_array = m_lsm_fluxes->array(mfi);
-            const auto& box3d = mfi.tilebox();
-            auto nx = box3d.length(0);
+            const auto& box3d = mfi.tilebox() & cbx2d;
+            if (!box3d.ok()) continue;
             amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
             {
                 // Map (col,lev) to (i,j,k)
-                auto icol = j*nx+i+1;
+                auto icol = (j-jlo)*nx + (i-ilo) + 1;
                 auto ilev = k+1;
 
                 // Direct fluxes
@@ -1034,12 +1177,12 @@ Radiation::export_surface_fluxes(FluxesByband& fluxes,
         // Populate the LSM data structure (this is a 2D MF)
         for (MFIter mfi(*(m_lsm_fluxes)); mfi.isValid(); ++mfi) {
             auto lsm_array = m_lsm_fluxes->array(mfi);
-            const auto& box3d = mfi.tilebox();
-            auto nx = box3d.length(0);
+            const auto& box3d = mfi.tilebox() & cbx2d;
+            if (!box3d.ok()) continue;
             amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
             {
                 // Map (col,lev) to (i,j,k)
-                auto icol = j*nx+i+1;
+                auto icol = (j-jlo)*nx + (i-ilo) + 1;
                 auto ilev = k+1;
 
                 // Net fluxes
@@ -1066,14 +1209,16 @@ void Radiation::yakl_to_mf(const real2d &data, amrex::MultiFab &mf)
         return;
     }
 
+    const int ilo = m_chunk_box.smallEnd(0);
+    const int jlo = m_chunk_box.smallEnd(1);
+    const int nx  = m_chunk_box.length(0);
     for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
         auto mf_arr = mf.array(mfi);
         const auto& box3d = mfi.tilebox();
-        const int nx = box3d.length(0);
         amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
             // map [i,j,k] 0-based to [icol, ilev] 1-based
-            const int icol = j*nx+i+1;
+            const int icol = (j-jlo)*nx + (i-ilo) + 1;
             const int ilev = k+1;
             AMREX_ASSERT(icol <= static_cast<int>(data.get_dimensions()(1)));
             AMREX_ASSERT(ilev <= static_cast<int>(data.get_dimensions()(2)));
@@ -1085,7 +1230,6 @@ void Radiation::yakl_to_mf(const real2d &data, amrex::MultiFab &mf)
 void Radiation::expand_yakl1d_to_mf(const real1d &data, amrex::MultiFab &mf)
 {
     // copies the 1D yakl data to a 3D MF
-    const int ncol = m_geom.Domain().length(0) * m_geom.Domain().length(1);
     AMREX_ASSERT(data.get_dimensions()(1) == ncol);
     mf = amrex::MultiFab(m_box, qrad_src->DistributionMap(), 1, 0);
     if (!data.initialized())
@@ -1095,14 +1239,16 @@ void Radiation::expand_yakl1d_to_mf(const real1d &data, amrex::MultiFab &mf)
         return;
     }
 
+    const int ilo = m_chunk_box.smallEnd(0);
+    const int jlo = m_chunk_box.smallEnd(1);
+    const int nx  = m_chunk_box.length(0);
     for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
         auto mf_arr = mf.array(mfi);
         const auto& box3d = mfi.tilebox();
-        const int nx = box3d.length(0);
         amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
             // map [i,j,k] 0-based to [icol, ilev] 1-based
-            const int icol = j*nx+i+1;
+            const int icol = (j-jlo)*nx + (i-ilo) + 1;
             AMREX_ASSERT(icol <= static_cast<int>(data.get_dimensions()(1)));
             mf_arr(i, j, k) = data(icol);
         });
@@ -1117,6 +1263,13 @@ void Radiation::writePlotfile(const std::string& plot_prefix, const amrex::Real
         return;
     }
 
+    // The work arrays only hold the last chunk of columns
+    if (m_nchunks > 1)
+    {
+        amrex::Print() << "Radiation plotfile skipped: erf.rad_chunk_size splits the level into chunks" << std::endl;
+        return;
+    }
+
     std::string plotfilename = amrex::Concatenate(plot_prefix + "_rad", level_step, 5);
 
     // list of real2d (3D) variables to plot
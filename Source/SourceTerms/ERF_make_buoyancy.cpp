@@ -46,7 +46,7 @@ void make_buoyancy (Vector<MultiFab>& S_data,
     const int khi = geom.Domain().bigEnd()[2] + 1;
 
     // ******************************************************************************************
-    // Dry versions of buoyancy expressions (type 1 and type 2/3 -- types 2 and 3 are equivalent)
+    // Dry versions of buoyancy expressions (type 1, type 2/3 -- types 2 and 3 are equivalent -- and type 4)
     // ******************************************************************************************
     if (solverChoice.moisture_type == MoistureType::None) {
         if (solverChoice.buoyancy_type == 1) {
@@ -71,7 +71,7 @@ void make_buoyancy (Vector<MultiFab>& S_data,
                 });
             } // mfi
 
-        } else if (solverChoice.buoyancy_type == 2 || solverChoice.buoyancy_type == 3) {
+        } else {
             PlaneAverage state_ave(&(S_data[IntVars::cons]), geom, solverChoice.ave_plane);
             PlaneAverage prim_ave(&S_prim, geom, solverChoice.ave_plane);
 
@@ -107,16 +107,22 @@ void make_buoyancy (Vector<MultiFab>& S_data,
                 const Array4<const Real> & cell_data  = S_data[IntVars::cons].array(mfi);
                 const Array4<      Real> & buoyancy_fab = buoyancy.array(mfi);
 
-                ParallelFor(tbz, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                ParallelFor(tbz, [=, buoyancy_type=solverChoice.buoyancy_type] AMREX_GPU_DEVICE (int i, int j, int k)
                 {
-                    Real tempp1d = getTgivenRandRTh(rho_d_ptr[k  ], rho_d_ptr[k  ]*theta_d_ptr[k  ]);
-                    Real tempm1d = getTgivenRandRTh(rho_d_ptr[k-1], rho_d_ptr[k-1]*theta_d_ptr[k-1]);
-
-                    Real tempp3d  = getTgivenRandRTh(cell_data(i,j,k  ,Rho_comp), cell_data(i,j,k  ,RhoTheta_comp));
-                    Real tempm3d  = getTgivenRandRTh(cell_data(i,j,k-1,Rho_comp), cell_data(i,j,k-1,RhoTheta_comp));
-
-                    Real qplus  = (tempp3d-tempp1d)/tempp1d;
-                    Real qminus = (tempm3d-tempm1d)/tempm1d;
+                    Real qplus, qminus;
+                    if (buoyancy_type == 4) {
+                        qplus  = (cell_data(i,j,k  ,RhoTheta_comp)/cell_data(i,j,k  ,Rho_comp) - theta_d_ptr[k  ])/theta_d_ptr[k  ];
+                        qminus = (cell_data(i,j,k-1,RhoTheta_comp)/cell_data(i,j,k-1,Rho_comp) - theta_d_ptr[k-1])/theta_d_ptr[k-1];
+                    } else {
+                        Real tempp1d = getTgivenRandRTh(rho_d_ptr[k  ], rho_d_ptr[k  ]*theta_d_ptr[k  ]);
+                        Real tempm1d = getTgivenRandRTh(rho_d_ptr[k-1], rho_d_ptr[k-1]*theta_d_ptr[k-1]);
+
+                        Real tempp3d  = getTgivenRandRTh(cell_data(i,j,k  ,Rho_comp), cell_data(i,j,k  ,RhoTheta_comp));
+                        Real tempm3d  = getTgivenRandRTh(cell_data(i,j,k-1,Rho_comp), cell_data(i,j,k-1,RhoTheta_comp));
+
+                        qplus  = (tempp3d-tempp1d)/tempp1d;
+                        qminus = (tempm3d-tempm1d)/tempm1d;
+                    }
 
                     Real qavg  = Real(0.5) * (qplus + qminus);
                     Real r0avg = Real(0.5) * (rho_d_ptr[k] + rho_d_ptr[k-1]);
@@ -132,12 +138,15 @@ void make_buoyancy (Vector<MultiFab>& S_data,
     // ******************************************************************************************
     if (solverChoice.moisture_type != MoistureType::None) {
 
+        // The anelastic dycore holds the density fixed and uses type 4 with all the condensates
+        const bool anelastic_buoyancy = solverChoice.anelastic && (solverChoice.buoyancy_type == 4);
+
         if (solverChoice.moisture_type == MoistureType::Kessler_NoRain) {
-            AMREX_ALWAYS_ASSERT(solverChoice.buoyancy_type == 1);
+            AMREX_ALWAYS_ASSERT(solverChoice.buoyancy_type == 1 || anelastic_buoyancy);
         }
 
         if (solverChoice.moisture_type == MoistureType::SAM or solverChoice.moisture_type == MoistureType::SAM_NoPrecip_NoIce) {
-            AMREX_ALWAYS_ASSERT(solverChoice.buoyancy_type == 1);
+            AMREX_ALWAYS_ASSERT(solverChoice.buoyancy_type == 1 || anelastic_buoyancy);
         }
 
         if (solverChoice.buoyancy_type == 1) {
@@ -202,8 +211,15 @@ void make_buoyancy (Vector<MultiFab>& S_data,
                 prim_ave.line_average(PrimQ2_comp, qc_h);
                 Gpu::copyAsync(Gpu::hostToDevice,  qc_h.begin(), qc_h.end(), qc_d.begin());
             }
+            // The anelastic buoyancy includes the loading of all the hydrometeors beyond cloud water
+            const int nq_load = (anelastic_buoyancy) ? n_qstate : std::min(n_qstate,3);
             if (n_qstate >=3) {
                 prim_ave.line_average(PrimQ3_comp, qp_h);
+                Gpu::HostVector<Real> qx_h(ncell);
+                for (int nq = 3; nq < nq_load; ++nq) {
+                    prim_ave.line_average(PrimQ1_comp+nq, qx_h);
+                    for (int k = 0; k < ncell; ++k) qp_h[k] += qx_h[k];
+                }
                 Gpu::copyAsync(Gpu::hostToDevice,  qp_h.begin(), qp_h.end(), qp_d.begin());
             }
             Real* qv_d_ptr = qv_d.data();
@@ -250,6 +266,10 @@ void make_buoyancy (Vector<MultiFab>& S_data,
 
                         Real qp_plus  = (n_qstate >= 3) ? cell_prim(i,j,k  ,PrimQ3_comp) : 0.0;
                         Real qp_minus = (n_qstate >= 3) ? cell_prim(i,j,k-1,PrimQ3_comp) : 0.0;
+                        for (int nq = 3; nq < nq_load; ++nq) {
+                            qp_plus  += cell_prim(i,j,k  ,PrimQ1_comp+nq);
+                            qp_minus += cell_prim(i,j,k-1,PrimQ1_comp+nq);
+                        }
 
                         if (buoyancy_type == 2) {
                             qplus  = 0.61 * ( qv_plus - qv_d_ptr[k] ) -
@@ -1,5 +1,6 @@
 #include <ERF.H>
 #include <ERF_Utils.H>
+#include <ERF_BoxCosts.H>
 
 #ifdef ERF_USE_WINDFARM
 #include <ERF_WindFarm.H>
@@ -87,51 +88,60 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
     }
 
     // We need to set these because otherwise in the first call to erf_advance we may
-    //    read uninitialized data on ghost values in setting the bc's on the velocities
-    U_new.setVal(1.e34,U_new.nGrowVect());
-    V_new.setVal(1.e34,V_new.nGrowVect());
-    W_new.setVal(1.e34,W_new.nGrowVect());
+    //    read uninitialized data on ghost values in setting the bc's on the velocities;
+    //    the valid regions are overwritten by the advance so only the ghost cells are set
+    U_new.setBndry(1.e34);
+    V_new.setBndry(1.e34);
+    W_new.setBndry(1.e34);
 
-    FillPatch(lev, time, {&S_old, &U_old, &V_old, &W_old},
-                         {&S_old, &rU_old[lev], &rV_old[lev], &rW_old[lev]});
+    // At level 0 this only starts the exchange of ghost cells between the grids; it is
+    //     completed in advance_dycore once the tiles that do not need it have been done
+    bool halos_in_flight = FillPatchBegin(lev, time, {&S_old, &U_old, &V_old, &W_old},
+                                                     {&S_old, &rU_old[lev], &rV_old[lev], &rW_old[lev]});
 
     if (solverChoice.moisture_type != MoistureType::None) {
         // TODO: This is only qv
         if (qmoist[lev].size() > 0) FillPatchMoistVars(lev, *(qmoist[lev][0]));
     }
 
+#if defined(ERF_USE_WINDFARM)
+    // The windfarm models use and update the ghost cells of the old velocity
+    if (solverChoice.windfarm_type != WindFarmType::None) {
+        halos_in_flight = false;
+    }
+#endif
+    if (!halos_in_flight) {
+        FillPatchEnd(lev, time, {&S_old, &U_old, &V_old, &W_old});
+    }
+
+    // The physics modules are timed as a whole and their time shared over the boxes
+    //     for the measured-cost load balancing (the dycore times each box itself)
+    LayoutData<Real>* costs = box_costs[lev].get();
 
 #if defined(ERF_USE_WINDFARM)
     if (solverChoice.windfarm_type != WindFarmType::None) {
+        Real t_start = (costs) ? cost_clock() : 0.0;
         advance_windfarm(Geom(lev), dt_lev, S_old,
                          U_old, V_old, W_old, vars_windfarm[lev], Nturb[lev]);
+        if (costs) { add_windfarm_costs(lev, cost_clock() - t_start); }
     }
 
 #endif
 
-    const BoxArray&            ba = S_old.boxArray();
-    const DistributionMapping& dm = S_old.DistributionMap();
-
     int nvars = S_old.nComp();
 
-    // Source array for conserved cell-centered quantities -- this will be filled
-    //     in the call to make_sources in ERF_TI_slow_rhs_fun.H
-    MultiFab cc_source(ba,dm,nvars,1); cc_source.setVal(0.0);
-
-    // Source arrays for momenta -- these will be filled
-    //     in the call to make_mom_sources in ERF_TI_slow_rhs_fun.H
-    BoxArray ba_x(ba); ba_x.surroundingNodes(0);
-    MultiFab xmom_source(ba_x,dm,nvars,1); xmom_source.setVal(0.0);
-
-    BoxArray ba_y(ba); ba_y.surroundingNodes(1);
-    MultiFab ymom_source(ba_y,dm,nvars,1); ymom_source.setVal(0.0);
-
-    BoxArray ba_z(ba); ba_z.surroundingNodes(2);
-    MultiFab zmom_source(ba_z,dm,nvars,1); zmom_source.setVal(0.0);
+    // Source arrays for conserved cell-centered quantities and for momenta -- these are
+    //     persistent per level and will be filled in the calls to make_sources and
+    //     make_mom_sources in ERF_TI_slow_rhs_fun.H
+    AMREX_ASSERT(cc_source[lev].boxArray() == S_old.boxArray());
+    AMREX_ASSERT(cc_source[lev].nComp() == nvars);
 
     // We don't need to call FillPatch on cons_mf because we have fillpatch'ed S_old above
-    MultiFab cons_mf(ba,dm,nvars,S_old.nGrowVect());
-    MultiFab::Copy(cons_mf,S_old,0,0,S_old.nComp(),S_old.nGrowVect());
+    //     (if the ghost cells are still in flight, advance_dycore copies them once they arrive)
+    MultiFab& cons_mf = cons_scratch[lev];
+    if (!halos_in_flight) {
+        MultiFab::Copy(cons_mf,S_old,0,0,nvars,S_old.nGrowVect());
+    }
 
     amrex::Vector<MultiFab> state_old;
     amrex::Vector<MultiFab> state_new;
@@ -159,13 +169,17 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
     advance_dycore(lev, state_old, state_new,
                    U_old, V_old, W_old,
                    U_new, V_new, W_new,
-                   cc_source, xmom_source, ymom_source, zmom_source,
-                   Geom(lev), dt_lev, time);
+                   cc_source[lev], xmom_source[lev], ymom_source[lev], zmom_source[lev],
+                   Geom(lev), dt_lev, time, halos_in_flight);
 
     // **************************************************************************************
     // Update the microphysics (moisture)
     // **************************************************************************************
-    advance_microphysics(lev, S_new, dt_lev, iteration, time);
+    {
+        Real t_start = (costs) ? cost_clock() : 0.0;
+        advance_microphysics(lev, S_new, dt_lev, iteration, time);
+        if (costs) { add_microphysics_costs(lev, cost_clock() - t_start); }
+    }
 
     // **************************************************************************************
     // Update the land surface model
@@ -183,7 +197,11 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
     // **************************************************************************************
     // Update the particle positions
     // **************************************************************************************
-   evolveTracers( lev, dt_lev, vars_new, z_phys_nd );
+    {
+        Real t_start = (costs) ? cost_clock() : 0.0;
+        evolveTracers( lev, dt_lev, vars_new, z_phys_nd );
+        if (costs) { add_particle_costs(lev, cost_clock() - t_start); }
+    }
 #endif
 
     // **************************************************************************************
@@ -35,9 +35,8 @@ ERF::timeStep (int lev, Real time, int /*iteration*/)
                 regrid(lev, time);
 
 #ifdef ERF_USE_PARTICLES
-                if (finest_level != old_finest) {
-                    particleData.Redistribute();
-                }
+                // Also catches grids that were remade or moved to other ranks
+                particleData.RedistributeIfNeeded();
 #endif
 
                 // mark that we have regridded this level already
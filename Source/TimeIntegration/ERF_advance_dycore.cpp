@@ -13,6 +13,20 @@
 
 using namespace amrex;
 
+// The box MFIter::tilebox(nodal,ngrow) returns for a tile tbx of the grid vbx: nodes on
+//    the high side belong to the next tile, and only the sides on the grid boundary grow
+static Box
+grown_tile_box (const Box& tbx, const Box& vbx, const IntVect& nodal, const IntVect& ngrow)
+{
+    Box bx = convert(tbx, nodal);
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        if (nodal[dir] && tbx.bigEnd(dir) < vbx.bigEnd(dir)) bx.growHi(dir,-1);
+        if (tbx.smallEnd(dir) == vbx.smallEnd(dir)) bx.growLo(dir,ngrow[dir]);
+        if (tbx.bigEnd(dir)   == vbx.bigEnd(dir)  ) bx.growHi(dir,ngrow[dir]);
+    }
+    return bx;
+}
+
 /**
  * Function that advances the solution at one level for a single time step --
  * this sets up the multirate time integrator and calls the integrator's advance function
@@ -33,6 +47,8 @@ using namespace amrex;
  * @param[in] fine_geom container for geometry information at current level
  * @param[in] dt_advance time step for this time advance
  * @param[in] old_time old time for this time advance
+ * @param[in] halos_in_flight true if the exchange of the ghost cells of the old state started
+ *                            by FillPatchBegin is still to be completed
  */
 
 void ERF::advance_dycore(int level,
@@ -43,7 +59,8 @@ void ERF::advance_dycore(int level,
                          MultiFab&   cc_src, MultiFab& xmom_src,
                          MultiFab& ymom_src, MultiFab& zmom_src,
                          const Geometry fine_geom,
-                         const Real dt_advance, const Real old_time)
+                         const Real dt_advance, const Real old_time,
+                         bool halos_in_flight)
 {
     BL_PROFILE_VAR("erf_advance_dycore()",erf_advance_dycore);
 
@@ -105,11 +122,46 @@ void ERF::advance_dycore(int level,
 
     int num_prim = state_old[IntVars::cons].nComp() - 1;
 
+    // **************************************************************************************
+    // Number of acoustic substeps between halo exchanges of the fast variables: the exchange
+    //    fills fast_halo ghost cells and each substep in between also updates a halo that is
+    //    one cell narrower than the last. The redundant update in the ghost cells of a grid
+    //    must match the update of the grid that owns them, so the lateral boundaries must be
+    //    periodic and every grid must hold whole columns (the vertical solve spans the grid)
+    // **************************************************************************************
+    int fast_halo = 1;
+    if (fast_halo_substeps > 1 && level == 0 && !l_use_terrain && !solverChoice.use_NumDiff &&
+        solverChoice.coupling_type != CouplingType::TwoWay &&
+        fine_geom.isPeriodic(0) && fine_geom.isPeriodic(1) &&
+        !xflux_imask[level] && !yflux_imask[level] && !zflux_imask[level] &&
+        AllBoxesAreColumns(ba, fine_geom.Domain()))
+    {
+        fast_halo = std::min({fast_halo_substeps,
+                              state_old[IntVars::xmom].nGrowVect()[0],
+                              mapfac_u[level]->nGrowVect()[0]});
+    }
+    if (verbose && level == 0 && fast_halo_substeps > 1) {
+        Print() << "Acoustic substeps per halo exchange at level 0: " << fast_halo << std::endl;
+    }
+
     MultiFab    S_prim  (ba  , dm, num_prim,          state_old[IntVars::cons].nGrowVect());
     MultiFab  pi_stage  (ba  , dm,        1,          state_old[IntVars::cons].nGrowVect());
-    MultiFab fast_coeffs(ba_z, dm,        5,          0);
-    MultiFab* eddyDiffs = eddyDiffs_lev[level].get();
-    MultiFab* SmnSmn    = SmnSmn_lev[level].get();
+    MultiFab fast_coeffs(ba_z, dm,        5,          IntVect(fast_halo-1,fast_halo-1,0));
+    AuxMultiFab* eddyDiffs = eddyDiffs_lev[level].get();
+    AuxMultiFab* SmnSmn    = SmnSmn_lev[level].get();
+
+    // **************************************************************************************
+    // Complete the filling of the ghost cells of the old state started in Advance
+    // **************************************************************************************
+    auto finish_halos = [&] ()
+    {
+        if (halos_in_flight) {
+            MultiFab& S_old = vars_old[level][Vars::cons];
+            FillPatchEnd(level, old_time, {&S_old, &xvel_old, &yvel_old, &zvel_old});
+            MultiFab::Copy(state_old[IntVars::cons], S_old, 0, 0, S_old.nComp(), S_old.nGrowVect());
+            halos_in_flight = false;
+        }
+    };
 
     // **************************************************************************************
     // Compute strain for use in slow RHS, Smagorinsky model, and MOST
@@ -121,29 +173,36 @@ void ERF::advance_dycore(int level,
         const BCRec* bc_ptr_h = domain_bcs_type.data();
         const GpuArray<Real, AMREX_SPACEDIM> dxInv = fine_geom.InvCellSizeArray();
 
+        // While the ghost cells of the old velocity are in flight we compute the strain on the
+        //    part of each tile whose stencil stays within its grid, then we finish the fill,
+        //    which also imposes the physical bcs, and do the rest
+        const bool split_tiles = halos_in_flight;
+        const int  ng_strain   = 2;
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+        if (pass == 1) finish_halos();
+
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
         for ( MFIter mfi(state_new[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
         {
-            Box bxcc  = mfi.growntilebox(IntVect(1,1,0));
-            Box tbxxy = mfi.tilebox(IntVect(1,1,0),IntVect(1,1,0));
-            Box tbxxz = mfi.tilebox(IntVect(1,0,1),IntVect(1,1,0));
-            Box tbxyz = mfi.tilebox(IntVect(0,1,1),IntVect(1,1,0));
-
-            if (bxcc.smallEnd(2) != domain.smallEnd(2)) {
-                 bxcc.growLo(2,1);
-                tbxxy.growLo(2,1);
-                tbxxz.growLo(2,1);
-                tbxyz.growLo(2,1);
-            }
+            const Box& vbx  = mfi.validbox();
+            const Box& tile = mfi.tilebox();
 
-            if (bxcc.bigEnd(2) != domain.bigEnd(2)) {
-                 bxcc.growHi(2,1);
-                tbxxy.growHi(2,1);
-                tbxxz.growHi(2,1);
-                tbxyz.growHi(2,1);
+            BoxList pieces;
+            if (!split_tiles) {
+                if (pass == 1) pieces.push_back(tile);
+            } else {
+                Box core = tile & grow(vbx, -ng_strain);
+                if (pass == 0) {
+                    if (core.ok()) pieces.push_back(core);
+                } else {
+                    pieces = (core.ok()) ? boxDiff(tile, core) : BoxList(tile);
+                }
             }
+            if (pieces.isEmpty()) continue;
 
             const Array4<const Real> & u = xvel_old.array(mfi);
             const Array4<const Real> & v = yvel_old.array(mfi);
@@ -165,27 +224,53 @@ void ERF::advance_dycore(int level,
             const Array4<const Real> mf_u = mapfac_u[level]->array(mfi);
             const Array4<const Real> mf_v = mapfac_v[level]->array(mfi);
 
-            if (l_use_terrain) {
-                ComputeStrain_T(bxcc, tbxxy, tbxxz, tbxyz, domain,
-                                u, v, w,
-                                tau11, tau22, tau33,
-                                tau12, tau13,
-                                tau21, tau23,
-                                tau31, tau32,
-                                z_nd, detJ_cc[level]->const_array(mfi), bc_ptr_h, dxInv,
-                                mf_m, mf_u, mf_v);
-            } else {
-                ComputeStrain_N(bxcc, tbxxy, tbxxz, tbxyz, domain,
-                                u, v, w,
-                                tau11, tau22, tau33,
-                                tau12, tau13, tau23,
-                                bc_ptr_h, dxInv,
-                                mf_m, mf_u, mf_v);
-            }
+            for (const Box& tbx : pieces)
+            {
+                // These are the boxes MFIter would give for a tile equal to tbx
+                Box bxcc  = grown_tile_box(tbx, vbx, IntVect(0,0,0), IntVect(1,1,0));
+                Box tbxxy = grown_tile_box(tbx, vbx, IntVect(1,1,0), IntVect(1,1,0));
+                Box tbxxz = grown_tile_box(tbx, vbx, IntVect(1,0,1), IntVect(1,1,0));
+                Box tbxyz = grown_tile_box(tbx, vbx, IntVect(0,1,1), IntVect(1,1,0));
+
+                if (tbx.smallEnd(2) == vbx.smallEnd(2) && bxcc.smallEnd(2) != domain.smallEnd(2)) {
+                     bxcc.growLo(2,1);
+                    tbxxy.growLo(2,1);
+                    tbxxz.growLo(2,1);
+                    tbxyz.growLo(2,1);
+                }
+
+                if (tbx.bigEnd(2) == vbx.bigEnd(2) && bxcc.bigEnd(2) != domain.bigEnd(2)) {
+                     bxcc.growHi(2,1);
+                    tbxxy.growHi(2,1);
+                    tbxxz.growHi(2,1);
+                    tbxyz.growHi(2,1);
+                }
+
+                if (l_use_terrain) {
+                    ComputeStrain_T(bxcc, tbxxy, tbxxz, tbxyz, domain,
+                                    u, v, w,
+                                    tau11, tau22, tau33,
+                                    tau12, tau13,
+                                    tau21, tau23,
+                                    tau31, tau32,
+                                    z_nd, detJ_cc[level]->const_array(mfi), bc_ptr_h, dxInv,
+                                    mf_m, mf_u, mf_v);
+                } else {
+                    ComputeStrain_N(bxcc, tbxxy, tbxxz, tbxyz, domain,
+                                    u, v, w,
+                                    tau11, tau22, tau33,
+                                    tau12, tau13, tau23,
+                                    bc_ptr_h, dxInv,
+                                    mf_m, mf_u, mf_v);
+                }
+            } // pieces
         } // mfi
+        } // pass
     } // l_use_diff
     } // profile
 
+    finish_halos();
+
     MultiFab Omega (state_old[IntVars::zmom].boxArray(),dm,1,1);
 
 #include "ERF_TI_utils.H"
@@ -305,5 +390,48 @@ void ERF::advance_dycore(int level,
 
     mri_integrator.advance(state_old, state_new, old_time, dt_advance);
 
+    // ***************************************************************************************
+    // Vertically implicit turbulent diffusion -- the slow RHS only carried the explicit
+    //    share of the vertical eddy diffusivity on interior faces
+    // ***************************************************************************************
+    if (l_use_kturb && (dc.vert_implicit_fac > 0.0))
+    {
+        BL_PROFILE("erf_advance_implicit_diff");
+
+        const GpuArray<Real, AMREX_SPACEDIM> dxInv = fine_geom.InvCellSizeArray();
+        const int ncomp_diff = state_new[IntVars::cons].nComp() - RhoTheta_comp;
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for ( MFIter mfi(state_new[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx  = mfi.tilebox();
+            const Box& tbx = mfi.nodaltilebox(0);
+            const Box& tby = mfi.nodaltilebox(1);
+
+            const Array4<Real>& cell_data = state_new[IntVars::cons].array(mfi);
+            const Array4<Real>& rho_u     = state_new[IntVars::xmom].array(mfi);
+            const Array4<Real>& rho_v     = state_new[IntVars::ymom].array(mfi);
+
+            const Array4<const AuxReal>& mu_turb = eddyDiffs->const_array(mfi);
+            const Array4<const Real>& z_nd    = l_use_terrain ? z_phys_nd[level]->const_array(mfi) : Array4<const Real>{};
+            const Array4<const Real>& detJ    = l_use_terrain ? detJ_cc[level]->const_array(mfi)   : Array4<const Real>{};
+
+            // Update the momenta first since the state update does not change the density
+            ImplicitDiffForMom(tbx, tby, domain, dt_advance, dc.vert_implicit_fac,
+                               rho_u, rho_v, cell_data, mu_turb, z_nd, detJ, dxInv, l_use_terrain);
+
+            ImplicitDiffForState(bx, domain, RhoTheta_comp, ncomp_diff,
+                                 dt_advance, dc.vert_implicit_fac,
+                                 cell_data, mu_turb, z_nd, dxInv, l_use_terrain);
+        }
+
+        // Refill ghost cells and recompute the velocities from the updated momenta
+        apply_bcs(state_new, old_time + dt_advance,
+                  state_new[IntVars::cons].nGrow(), state_new[IntVars::xmom].nGrow(),
+                  fast_only=false, vel_and_mom_synced=false);
+    }
+
     if (verbose) Print() << "Done with advance_dycore at level " << level << std::endl;
 }
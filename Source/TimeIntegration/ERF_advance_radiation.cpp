@@ -3,6 +3,37 @@
 using namespace amrex;
 
 #if defined(ERF_USE_RRTMGP)
+namespace {
+    // Piecewise-constant interpolation of radiation grid data back to the level
+    void
+    inject_from_rad_grid (MultiFab& fine, const MultiFab& crse, const IntVect& rr)
+    {
+        for (MFIter mfi(fine, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const Box& tbx = mfi.tilebox();
+            const auto& fine_arr = fine.array(mfi);
+            const auto& crse_arr = crse.const_array(mfi);
+            ParallelFor(tbx, fine.nComp(), [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                IntVect civ = amrex::coarsen(IntVect(i,j,k), rr);
+                fine_arr(i,j,k,n) = crse_arr(civ,n);
+            });
+        }
+    }
+
+    // (Re)allocate rad_mf on the coarsened grids of mf if it is missing or the grids changed
+    void
+    make_rad_grid_mf (std::unique_ptr<MultiFab>& rad_mf, const MultiFab& mf, const IntVect& rr)
+    {
+        BoxArray ba_rad(mf.boxArray());
+        ba_rad.coarsen(rr);
+        if (!rad_mf || rad_mf->boxArray() != ba_rad ||
+            rad_mf->DistributionMap() != mf.DistributionMap()) {
+            rad_mf = std::make_unique<MultiFab>(ba_rad, mf.DistributionMap(), mf.nComp(), 0);
+            rad_mf->setVal(0.);
+        }
+    }
+}
+
 void ERF::advance_radiation (int lev,
                              MultiFab& cons,
                              const Real& dt_advance)
@@ -13,15 +44,92 @@ void ERF::advance_radiation (int lev,
    bool do_snow_opt {true};
    bool is_cmip6_volcano {false};
 
-    rad.initialize(cons,
-                   sw_lw_fluxes[lev].get(),
-                   solar_zenith[lev].get(),
-                   qheating_rates[lev].get(),
-                   lat_m[lev].get(),
-                   lon_m[lev].get(),
-                   qmoist[lev],
-                   grids[lev],
-                   Geom(lev),
+    // Between radiation calls the stored heating rates are reused as the source
+    if (!rad.call_due(lev, istep[lev], t_old[lev], grids[lev])) return;
+
+    // Full-resolution radiation; with rad_coarsen_check this is only the reference
+    // against which the coarsened heating rates are compared. That diagnostic runs
+    // on rad_check so its work arrays are not resized by the coarse call below.
+    std::unique_ptr<MultiFab> qheating_full;
+    if (rad_coarsen == 1 || rad_coarsen_check) {
+        Radiation& rad_full = (rad_coarsen > 1) ? *rad_check : rad;
+        MultiFab* qheating = qheating_rates[lev].get();
+        MultiFab* fluxes   = sw_lw_fluxes[lev].get();
+        MultiFab* zenith   = solar_zenith[lev].get();
+        if (rad_coarsen > 1) {
+            qheating_full = std::make_unique<MultiFab>(grids[lev], dmap[lev], 2, 0);
+            qheating = qheating_full.get();
+            fluxes   = nullptr;
+            zenith   = nullptr;
+        }
+
+        rad_full.initialize(cons,
+                            fluxes,
+                            zenith,
+                            qheating,
+                            lat_m[lev].get(),
+                            lon_m[lev].get(),
+                            qmoist[lev],
+                            grids[lev],
+                            Geom(lev),
+                            dt_advance,
+                            do_sw_rad,
+                            do_lw_rad,
+                            do_aero_rad,
+                            do_snow_opt,
+                            is_cmip6_volcano);
+        rad_full.run();
+        rad_full.on_complete();
+
+        if (rad_coarsen == 1) return;
+    }
+
+    // Block-average the state onto a horizontally coarsened copy of the level
+    const IntVect rr(rad_coarsen, rad_coarsen, 1);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(grids[lev].coarsenable(rr),
+                                     "erf.rad_coarsen must evenly divide every grid on the level");
+
+    BoxArray ba_rad(grids[lev]);
+    ba_rad.coarsen(rr);
+    Geometry geom_rad(amrex::coarsen(Geom(lev).Domain(), rr), Geom(lev).ProbDomain(),
+                      Geom(lev).Coord(), Geom(lev).isPeriodic());
+
+    MultiFab cons_rad(ba_rad, dmap[lev], cons.nComp(), 0);
+    average_down(cons, cons_rad, 0, cons.nComp(), rr);
+
+    Vector<std::unique_ptr<MultiFab>> qmoist_rad(qmoist[lev].size());
+    Vector<MultiFab*> qmoist_rad_ptr(qmoist[lev].size(), nullptr);
+    for (int q = 0; q < qmoist[lev].size(); ++q) {
+        if (!qmoist[lev][q]) continue;
+        make_rad_grid_mf(qmoist_rad[q], *qmoist[lev][q], rr);
+        average_down(*qmoist[lev][q], *qmoist_rad[q], 0, qmoist[lev][q]->nComp(), rr);
+        qmoist_rad_ptr[q] = qmoist_rad[q].get();
+    }
+
+    std::unique_ptr<MultiFab> lat_rad, lon_rad;
+    if (lat_m[lev] && lon_m[lev]) {
+        make_rad_grid_mf(lat_rad, *lat_m[lev], rr);
+        make_rad_grid_mf(lon_rad, *lon_m[lev], rr);
+        average_down(*lat_m[lev], *lat_rad, 0, 1, rr);
+        average_down(*lon_m[lev], *lon_rad, 0, 1, rr);
+    }
+
+    // The outputs persist since the radiation object keeps pointers to them
+    make_rad_grid_mf(qheating_rates_rad[lev], *qheating_rates[lev], rr);
+    if (sw_lw_fluxes[lev]) {
+        make_rad_grid_mf(sw_lw_fluxes_rad[lev], *sw_lw_fluxes[lev], rr);
+        make_rad_grid_mf(solar_zenith_rad[lev], *solar_zenith[lev], rr);
+    }
+
+    rad.initialize(cons_rad,
+                   sw_lw_fluxes_rad[lev].get(),
+                   solar_zenith_rad[lev].get(),
+                   qheating_rates_rad[lev].get(),
+                   lat_rad.get(),
+                   lon_rad.get(),
+                   qmoist_rad_ptr,
+                   ba_rad,
+                   geom_rad,
                    dt_advance,
                    do_sw_rad,
                    do_lw_rad,
@@ -30,5 +138,26 @@ void ERF::advance_radiation (int lev,
                    is_cmip6_volcano);
     rad.run();
     rad.on_complete();
+
+    // Interpolate the heating rates and surface fluxes back to the level
+    inject_from_rad_grid(*qheating_rates[lev], *qheating_rates_rad[lev], rr);
+    if (sw_lw_fluxes[lev]) {
+        inject_from_rad_grid(*sw_lw_fluxes[lev], *sw_lw_fluxes_rad[lev], rr);
+        inject_from_rad_grid(*solar_zenith[lev], *solar_zenith_rad[lev], rr);
+    }
+
+    if (qheating_full) {
+        MultiFab err(grids[lev], dmap[lev], 2, 0);
+        MultiFab::Copy(err, *qheating_rates[lev], 0, 0, 2, 0);
+        MultiFab::Subtract(err, *qheating_full, 0, 0, 2, 0);
+        for (int n = 0; n < 2; ++n) {
+            Real err_max  = err.norm0(n);
+            Real full_max = qheating_full->norm0(n);
+            Print() << "Radiation coarsening error at level " << lev
+                    << ((n == 0) ? " (SW)" : " (LW)") << ": max abs " << err_max
+                    << ", relative " << err_max / std::max(full_max, Real(1.e-30))
+                    << std::endl;
+        }
+    }
 }
 #endif
@@ -29,6 +29,7 @@ using namespace amrex;
  * @param[inout] fr_as_crse YAFluxRegister at level l at level l   / l+1 interface
  * @param[inout] fr_as_fine YAFluxRegister at level l at level l-1 / l   interface
  * @param[in]    l_reflux should we add fluxes to the FluxRegisters?
+ * @param[in]    ng_halo number of ghost cells (in x and y) that are updated along with the valid region
  */
 
 void erf_fast_rhs_N (int step, int nrk,
@@ -51,7 +52,8 @@ void erf_fast_rhs_N (int step, int nrk,
                      YAFluxRegister* fr_as_crse,
                      YAFluxRegister* fr_as_fine,
                      bool l_use_moisture,
-                     bool l_reflux)
+                     bool l_reflux,
+                     int ng_halo)
 {
     BL_PROFILE_REGION("erf_fast_rhs_N()");
 
@@ -71,9 +73,13 @@ void erf_fast_rhs_N (int step, int nrk,
     const auto& ba = S_stage_data[IntVars::cons].boxArray();
     const auto& dm = S_stage_data[IntVars::cons].DistributionMap();
 
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    // With deep halos the update covers ng_halo ghost cells in x and y of the grids
+    //    (never between tiles of the same grid)
+    const IntVect ngh(ng_halo,ng_halo,0);
+
+    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1+ng_halo,1+ng_halo,0));
+    MultiFab Delta_rho  (            ba                , dm, 1, 1+ng_halo);
+    MultiFab Delta_rho_theta(        ba                , dm, 1, 1+ng_halo);
 
     MultiFab     coeff_A_mf(fast_coeffs, make_alias, 0, 1);
     MultiFab inv_coeff_B_mf(fast_coeffs, make_alias, 1, 1);
@@ -87,14 +93,14 @@ void erf_fast_rhs_N (int step, int nrk,
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
     // This will hold theta extrapolated forward in time
-    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,1);
+    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,1+ng_halo);
 
     // This will hold the update for (rho) and (rho theta)
-    MultiFab temp_rhs(S_stage_data[IntVars::zmom].boxArray(),S_stage_data[IntVars::zmom].DistributionMap(),2,0);
+    MultiFab temp_rhs(S_stage_data[IntVars::zmom].boxArray(),S_stage_data[IntVars::zmom].DistributionMap(),2,ngh);
 
     // This will hold the new x- and y-momenta temporarily (so that we don't overwrite values we need when tiling)
-    MultiFab temp_cur_xmom(S_stage_data[IntVars::xmom].boxArray(),S_stage_data[IntVars::xmom].DistributionMap(),1,0);
-    MultiFab temp_cur_ymom(S_stage_data[IntVars::ymom].boxArray(),S_stage_data[IntVars::ymom].DistributionMap(),1,0);
+    MultiFab temp_cur_xmom(S_stage_data[IntVars::xmom].boxArray(),S_stage_data[IntVars::xmom].DistributionMap(),1,ngh);
+    MultiFab temp_cur_ymom(S_stage_data[IntVars::ymom].boxArray(),S_stage_data[IntVars::ymom].DistributionMap(),1,ngh);
 
     // *************************************************************************
     // First set up some arrays we'll need
@@ -117,7 +123,7 @@ void erf_fast_rhs_N (int step, int nrk,
         const Array4<const Real>&  prev_zmom = S_prev[IntVars::zmom].const_array(mfi);
         const Array4<const Real>& stage_zmom = S_stage_data[IntVars::zmom].const_array(mfi);
 
-        Box gbx = mfi.tilebox(); gbx.grow(1);
+        Box gbx = mfi.growntilebox(ngh); gbx.grow(1);
 
         if (step == 0) {
             ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -127,7 +133,7 @@ void erf_fast_rhs_N (int step, int nrk,
             });
         } // step = 0
 
-        Box gtbz = mfi.nodaltilebox(2);
+        Box gtbz = mfi.grownnodaltilebox(2,ngh);
         gtbz.grow(IntVect(1,1,0));
         ParallelFor(gtbz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
             old_drho_w(i,j,k) = prev_zmom(i,j,k) - stage_zmom(i,j,k);
@@ -153,7 +159,7 @@ void erf_fast_rhs_N (int step, int nrk,
     for ( MFIter mfi(S_stage_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         // We define lagged_delta_rt for our next step as the current delta_rt
-        Box gbx = mfi.tilebox(); gbx.grow(1);
+        Box gbx = mfi.growntilebox(ngh); gbx.grow(1);
 
         const Array4<Real>& lagged_delta_rt = S_scratch[IntVars::cons].array(mfi);
         const Array4<Real>& old_drho_theta  = Delta_rho_theta.array(mfi);
@@ -172,8 +178,8 @@ void erf_fast_rhs_N (int step, int nrk,
 #endif
     for ( MFIter mfi(S_stage_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        Box tbx = mfi.nodaltilebox(0);
-        Box tby = mfi.nodaltilebox(1);
+        Box tbx = mfi.grownnodaltilebox(0,ngh);
+        Box tby = mfi.grownnodaltilebox(1,ngh);
 
         const Array4<const Real> & stage_xmom = S_stage_data[IntVars::xmom].const_array(mfi);
         const Array4<const Real> & stage_ymom = S_stage_data[IntVars::ymom].const_array(mfi);
@@ -262,7 +268,7 @@ void erf_fast_rhs_N (int step, int nrk,
     std::array<FArrayBox,AMREX_SPACEDIM> flux;
     for ( MFIter mfi(S_stage_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
     {
-        Box bx  = mfi.tilebox();
+        Box bx  = mfi.growntilebox(ngh);
         Box tbz = surroundingNodes(bx,2);
 
         Box vbx = mfi.validbox();
@@ -544,7 +550,7 @@ void erf_fast_rhs_N (int step, int nrk,
 #endif
     for ( MFIter mfi(S_stage_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        const Box& bx = mfi.tilebox();
+        const Box& bx = mfi.growntilebox(ngh);
 
         int cons_dycore{2};
         const Array4<Real>& cur_cons = S_data[IntVars::cons].array(mfi);
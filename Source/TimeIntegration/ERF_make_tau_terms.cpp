@@ -20,8 +20,8 @@ void erf_make_tau_terms (int level, int nrk,
                          MultiFab* Tau11, MultiFab* Tau22, MultiFab* Tau33,
                          MultiFab* Tau12, MultiFab* Tau13, MultiFab* Tau21,
                          MultiFab* Tau23, MultiFab* Tau31, MultiFab* Tau32,
-                         MultiFab* SmnSmn,
-                         MultiFab* eddyDiffs,
+                         AuxMultiFab* SmnSmn,
+                         AuxMultiFab* eddyDiffs,
                          const Geometry geom,
                          const SolverChoice& solverChoice,
                          std::unique_ptr<ABLMost>& most,
@@ -107,7 +107,7 @@ void erf_make_tau_terms (int level, int nrk,
             const Array4<const Real>& mf_v   = mapfac_v->const_array(mfi);
 
             // Eddy viscosity
-            const Array4<Real const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const Real>{};
+            const Array4<AuxReal const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const AuxReal>{};
             const Array4<Real const>& cell_data = l_use_constAlpha ? S_data[IntVars::cons].const_array(mfi) : Array4<const Real>{};
 
             // Terrain metrics
@@ -172,7 +172,7 @@ void erf_make_tau_terms (int level, int nrk,
             Array4<Real> tau12 = Tau12->array(mfi); Array4<Real> tau13 = Tau13->array(mfi); Array4<Real> tau23 = Tau23->array(mfi);
 
             // Strain magnitude
-            Array4<Real> SmnSmn_a;
+            Array4<AuxReal> SmnSmn_a;
 
             if (l_use_terrain) {
                 // Terrain non-symmetric terms
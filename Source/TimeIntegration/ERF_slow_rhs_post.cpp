@@ -44,6 +44,7 @@ using namespace amrex;
  * @param[in] mapfac_v map factor at y-faces
  * @param[inout] fr_as_crse YAFluxRegister at level l at level l   / l+1 interface
  * @param[inout] fr_as_fine YAFluxRegister at level l at level l-1 / l   interface
+ * @param[inout] costs measured cost of each box, or null if not measured
  */
 
 void erf_slow_rhs_post (int level, int finest_level,
@@ -60,8 +61,8 @@ void erf_slow_rhs_post (int level, int finest_level,
                         const MultiFab& yvel,
                         const MultiFab& /*zvel*/,
                         const MultiFab& source,
-                        const MultiFab* SmnSmn,
-                        const MultiFab* eddyDiffs,
+                        const AuxMultiFab* SmnSmn,
+                        const AuxMultiFab* eddyDiffs,
                         MultiFab* Hfx1,
                         MultiFab* Hfx2,
                         MultiFab* Hfx3,
@@ -81,6 +82,7 @@ void erf_slow_rhs_post (int level, int finest_level,
                         std::unique_ptr<MultiFab>& az,
                         std::unique_ptr<MultiFab>& detJ,
                         std::unique_ptr<MultiFab>& detJ_new,
+                        const CompactTerrain* compact_metric,
                         std::unique_ptr<MultiFab>& mapfac_m,
                         std::unique_ptr<MultiFab>& mapfac_u,
                         std::unique_ptr<MultiFab>& mapfac_v,
@@ -100,7 +102,8 @@ void erf_slow_rhs_post (int level, int finest_level,
                         Vector<Vector<FArrayBox>>& bdy_data_yhi,
 #endif
                         YAFluxRegister* fr_as_crse,
-                        YAFluxRegister* fr_as_fine)
+                        YAFluxRegister* fr_as_fine,
+                        LayoutData<Real>* costs)
 {
     BL_PROFILE_REGION("erf_slow_rhs_post()");
 
@@ -227,6 +230,8 @@ void erf_slow_rhs_post (int level, int finest_level,
 
       for ( MFIter mfi(S_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
+        BoxCostTimer box_timer(costs, mfi);
+
         Box tbx  = mfi.tilebox();
 
         // *************************************************************************
@@ -271,7 +276,7 @@ void erf_slow_rhs_post (int level, int finest_level,
         const Array4<const Real> & u = xvel.array(mfi);
         const Array4<const Real> & v = yvel.array(mfi);
 
-        const Array4<Real const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const Real>{};
+        const Array4<AuxReal const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const AuxReal>{};
 
         const Array4<const Real>& z_nd         = l_use_terrain    ? z_phys_nd->const_array(mfi) : Array4<const Real>{};
         const Array4<const Real>& detJ_new_arr = l_moving_terrain ? detJ_new->const_array(mfi)    : Array4<const Real>{};
@@ -282,7 +287,7 @@ void erf_slow_rhs_post (int level, int finest_level,
         const Array4<const Real>& mf_v = mapfac_v->const_array(mfi);
 
         // SmnSmn for KE src with Deardorff
-        const Array4<const Real>& SmnSmn_a = l_use_deardorff ? SmnSmn->const_array(mfi) : Array4<const Real>{};
+        const Array4<const AuxReal>& SmnSmn_a = l_use_deardorff ? SmnSmn->const_array(mfi) : Array4<const AuxReal>{};
 
         // **************************************************************************
         // Here we fill the "current" data with "new" data because that is the result of the previous RK stage
@@ -330,9 +335,13 @@ void erf_slow_rhs_post (int level, int finest_level,
         auto const& az_arr   = ebfact.getAreaFrac()[2]->const_array(mfi);
         const auto& detJ_arr = ebfact.getVolFrac().const_array(mfi);
 #else
-        auto const& ax_arr   = ax->const_array(mfi);
-        auto const& ay_arr   = ay->const_array(mfi);
-        auto const& az_arr   = az->const_array(mfi);
+        // With compact terrain metrics the face areas are computed on the fly
+        MetricArray4 ax_arr   = (compact_metric) ? compact_metric->array(mfi, MetricArray4::ax)
+                                                 : MetricArray4(ax->const_array(mfi));
+        MetricArray4 ay_arr   = (compact_metric) ? compact_metric->array(mfi, MetricArray4::ay)
+                                                 : MetricArray4(ay->const_array(mfi));
+        MetricArray4 az_arr   = (compact_metric) ? compact_metric->array(mfi, MetricArray4::az)
+                                                 : MetricArray4(az->const_array(mfi));
         auto const& detJ_arr = detJ->const_array(mfi);
 #endif
 
@@ -62,6 +62,7 @@ using namespace amrex;
  * @param[in] mapfac_v map factor at y-faces
  * @param[inout] fr_as_crse YAFluxRegister at level l at level l   / l+1 interface
  * @param[inout] fr_as_fine YAFluxRegister at level l at level l-1 / l   interface
+ * @param[inout] costs measured cost of each box, or null if not measured
  */
 
 void erf_slow_rhs_pre (int level, int finest_level,
@@ -84,8 +85,8 @@ void erf_slow_rhs_pre (int level, int finest_level,
                        MultiFab* Tau11, MultiFab* Tau22, MultiFab* Tau33,
                        MultiFab* Tau12, MultiFab* Tau13, MultiFab* Tau21,
                        MultiFab* Tau23, MultiFab* Tau31, MultiFab* Tau32,
-                       MultiFab* SmnSmn,
-                       MultiFab* eddyDiffs,
+                       AuxMultiFab* SmnSmn,
+                       AuxMultiFab* eddyDiffs,
                        MultiFab* Hfx1,
                        MultiFab* Hfx2,
                        MultiFab* Hfx3,
@@ -104,6 +105,7 @@ void erf_slow_rhs_pre (int level, int finest_level,
                        std::unique_ptr<MultiFab>& ay,
                        std::unique_ptr<MultiFab>& az,
                        std::unique_ptr<MultiFab>& detJ,
+                       const CompactTerrain* compact_metric,
                        const MultiFab* p0,
 #ifdef ERF_USE_POISSON_SOLVE
                        const MultiFab& pp_inc,
@@ -115,12 +117,13 @@ void erf_slow_rhs_pre (int level, int finest_level,
                        EBFArrayBoxFactory const& ebfact,
 #endif
                        YAFluxRegister* fr_as_crse,
-                       YAFluxRegister* fr_as_fine)
+                       YAFluxRegister* fr_as_fine,
+                       LayoutData<Real>* costs)
 {
     BL_PROFILE_REGION("erf_slow_rhs_pre()");
 
 #ifdef ERF_USE_EB
-    amrex::ignore_unused(ax,ay,az,detJ);
+    amrex::ignore_unused(ax,ay,az,detJ,compact_metric);
 #endif
 
     const BCRec* bc_ptr_d = domain_bcs_type_d.data();
@@ -164,9 +167,8 @@ void erf_slow_rhs_pre (int level, int finest_level,
     const bool l_incompressible = solverChoice.incompressible[level];
     const bool l_const_rho      = solverChoice.constant_density;
 
-    // We cannot use incompressible with terrain or with moisture
-    AMREX_ALWAYS_ASSERT(!l_use_terrain  || !l_incompressible);
-    AMREX_ALWAYS_ASSERT(!l_use_moisture || !l_incompressible);
+    // We cannot use incompressible with moisture (but we can use anelastic)
+    AMREX_ALWAYS_ASSERT(!l_use_moisture || !l_incompressible || solverChoice.anelastic);
 #else
     const bool l_incompressible = false;
     const bool l_const_rho      = false;
@@ -249,6 +251,8 @@ void erf_slow_rhs_pre (int level, int finest_level,
 
     for ( MFIter mfi(S_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
     {
+        BoxCostTimer box_timer(costs, mfi);
+
         Box bx  = mfi.tilebox();
         Box tbx = mfi.nodaltilebox(0);
         Box tby = mfi.nodaltilebox(1);
@@ -311,7 +315,7 @@ void erf_slow_rhs_pre (int level, int finest_level,
         const Array4<Real>& rho_v_rhs = S_rhs[IntVars::ymom].array(mfi);
         const Array4<Real>& rho_w_rhs = S_rhs[IntVars::zmom].array(mfi);
 
-        const Array4<Real const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const Real>{};
+        const Array4<AuxReal const>& mu_turb = l_use_turb ? eddyDiffs->const_array(mfi) : Array4<const AuxReal>{};
 
         // Terrain metrics
         const Array4<const Real>& z_nd     = l_use_terrain ? z_phys_nd->const_array(mfi) : Array4<const Real>{};
@@ -440,11 +444,11 @@ void erf_slow_rhs_pre (int level, int finest_level,
         }
 
         // Strain magnitude
-        Array4<Real> SmnSmn_a;
+        Array4<AuxReal> SmnSmn_a;
         if (tc.les_type == LESType::Deardorff) {
             SmnSmn_a = SmnSmn->array(mfi);
         } else {
-            SmnSmn_a = Array4<Real>{};
+            SmnSmn_a = Array4<AuxReal>{};
         }
 
         // *****************************************************************************
@@ -456,9 +460,13 @@ void erf_slow_rhs_pre (int level, int finest_level,
         auto const& az_arr   = ebfact.getAreaFrac()[2]->const_array(mfi);
         const auto& detJ_arr = ebfact.getVolFrac().const_array(mfi);
 #else
-        auto const& ax_arr   = ax->const_array(mfi);
-        auto const& ay_arr   = ay->const_array(mfi);
-        auto const& az_arr   = az->const_array(mfi);
+        // With compact terrain metrics the face areas are computed on the fly
+        MetricArray4 ax_arr   = (compact_metric) ? compact_metric->array(mfi, MetricArray4::ax)
+                                                 : MetricArray4(ax->const_array(mfi));
+        MetricArray4 ay_arr   = (compact_metric) ? compact_metric->array(mfi, MetricArray4::ay)
+                                                 : MetricArray4(ay->const_array(mfi));
+        MetricArray4 az_arr   = (compact_metric) ? compact_metric->array(mfi, MetricArray4::az)
+                                                 : MetricArray4(az->const_array(mfi));
         auto const& detJ_arr = detJ->const_array(mfi);
 #endif
 
@@ -524,7 +532,9 @@ void erf_slow_rhs_pre (int level, int finest_level,
         const Array4<Real const>& source_arr   = cc_src.const_array(mfi);
         ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            cell_rhs(i,j,k,Rho_comp)      += source_arr(i,j,k,Rho_comp);
+            if (!l_const_rho) {
+                cell_rhs(i,j,k,Rho_comp)  += source_arr(i,j,k,Rho_comp);
+            }
             cell_rhs(i,j,k,RhoTheta_comp) += source_arr(i,j,k,RhoTheta_comp);
         });
 
@@ -590,6 +600,14 @@ void erf_slow_rhs_pre (int level, int finest_level,
                                      dxInv,
                                      mf_m, mf_u, mf_v);
             }
+
+            // The implicit share of the turbulent vertical momentum flux is
+            // applied after the RK update in ImplicitDiffForMom
+            if (l_use_turb && (dc.vert_implicit_fac > 0.0)) {
+                ImplicitDiffSrcForMom(tbx, tby, domain, dc.vert_implicit_fac,
+                                      rho_u_rhs, rho_v_rhs, u, v, mu_turb,
+                                      z_nd, detJ_arr, dxInv, l_use_terrain);
+            }
         }
 
         auto abl_pressure_grad    = solverChoice.abl_pressure_grad;
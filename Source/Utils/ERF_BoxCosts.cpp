@@ -0,0 +1,67 @@
+#include <ERF_BoxCosts.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+
+using namespace amrex;
+
+void
+add_box_costs (LayoutData<Real>& costs, Real elapsed, const Vector<Real>& weight)
+{
+    Real wsum = 0.0;
+    for (MFIter mfi(costs, false); mfi.isValid(); ++mfi) {
+        wsum += weight[mfi.index()];
+    }
+    for (MFIter mfi(costs, false); mfi.isValid(); ++mfi) {
+        costs[mfi] += (wsum > 0.0) ? elapsed*weight[mfi.index()]/wsum
+                                   : elapsed/costs.local_size();
+    }
+}
+
+Vector<Real>
+gather_box_costs (const LayoutData<Real>& costs)
+{
+    Vector<Real> cost(costs.size(), 0.0);
+    for (MFIter mfi(costs, false); mfi.isValid(); ++mfi) {
+        cost[mfi.index()] = costs[mfi];
+    }
+    ParallelAllReduce::Sum(cost.data(), cost.size(), ParallelContext::CommunicatorSub());
+    return cost;
+}
+
+Vector<Real>
+remap_box_costs (const Vector<Real>& cost_old, const BoxArray& ba_old, const BoxArray& ba)
+{
+    Real total_cost = 0.0;
+    for (const auto& c : cost_old) { total_cost += c; }
+    Real mean_cost_per_cell = total_cost / static_cast<Real>(ba_old.numPts());
+
+    Vector<Real> cost(ba.size(), 0.0);
+    for (int i = 0; i < ba.size(); i++) {
+        Long covered = 0;
+        for (const auto& is : ba_old.intersections(ba[i])) {
+            const Long npts = is.second.numPts();
+            cost[i] += cost_old[is.first] * static_cast<Real>(npts)
+                                          / static_cast<Real>(ba_old[is.first].numPts());
+            covered += npts;
+        }
+        // Newly refined cells cost the mean
+        cost[i] += mean_cost_per_cell * static_cast<Real>(ba[i].numPts() - covered);
+    }
+    return cost;
+}
+
+Real
+box_cost_efficiency (const Vector<Real>& cost, const DistributionMapping& dm)
+{
+    const int nprocs = ParallelContext::NProcsSub();
+    Vector<Real> rank_cost(nprocs, 0.0);
+    for (int i = 0; i < cost.size(); i++) {
+        rank_cost[dm[i]] += cost[i];
+    }
+    Real sum = 0.0, max = 0.0;
+    for (const auto& c : rank_cost) {
+        sum += c;
+        max = amrex::max(max, c);
+    }
+    return (max > 0.0) ? sum / (nprocs*max) : 1.0;
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <functional>
+
 #include <ERF_Utils.H>
 
 using namespace amrex;
@@ -33,3 +36,96 @@ ChopGrids2D (BoxArray& ba, const Box& domain, int target_size)
         }
     }
 }
+
+bool
+AllBoxesAreColumns (const BoxArray& ba, const Box& domain)
+{
+    for (int i = 0; i < ba.size(); i++) {
+        if (ba[i].smallEnd(2) != domain.smallEnd(2) || ba[i].bigEnd(2) != domain.bigEnd(2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BoxArray
+ColumnBoxArray (const BoxArray& ba, const Box& domain)
+{
+    BoxList bl;
+    for (int i = 0; i < ba.size(); i++) {
+        Box bx(ba[i]);
+        bx.setRange(2, domain.smallEnd(2), domain.length(2));
+        bl.push_back(bx);
+    }
+    BoxArray col_ba(std::move(bl));
+
+    // Grids stacked in the vertical extend to the same column
+    col_ba.removeOverlap();
+    return col_ba;
+}
+
+DistributionMapping
+ColumnDistributionMapping (const BoxArray& ba, const Vector<Real>& cost, bool use_sfc)
+{
+    AMREX_ALWAYS_ASSERT(cost.size() == ba.size());
+
+    if (use_sfc) {
+        // All boxes span the same z range, so the curve only needs to visit
+        // their (x,y) footprints
+        BoxList bl;
+        for (int i = 0; i < ba.size(); i++) {
+            Box bx(ba[i]);
+            bx.setRange(2, ba[i].smallEnd(2));
+            bl.push_back(bx);
+        }
+        return DistributionMapping::makeSFC(cost, BoxArray(std::move(bl)));
+    } else {
+        return DistributionMapping::makeKnapSack(cost);
+    }
+}
+
+Vector<int>
+MatchingBoxes (const BoxArray& ba, const BoxArray& ba_old)
+{
+    Vector<int> old_index(ba.size(), -1);
+    for (int i = 0; i < ba.size(); i++) {
+        for (const auto& isect : ba_old.intersections(ba[i])) {
+            if (ba_old[isect.first] == ba[i]) {
+                old_index[i] = isect.first;
+                break;
+            }
+        }
+    }
+    return old_index;
+}
+
+DistributionMapping
+IncrementalDistributionMapping (const BoxArray& ba, const Vector<Real>& cost,
+                                const BoxArray& ba_old, const DistributionMapping& dm_old)
+{
+    AMREX_ALWAYS_ASSERT(cost.size() == ba.size());
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    Vector<int> old_index = MatchingBoxes(ba, ba_old);
+
+    Vector<int>  pmap(ba.size(), -1);
+    Vector<Real> load(nprocs, 0.0);
+    Vector<std::pair<Real,int>> unmatched;
+    for (int i = 0; i < ba.size(); i++) {
+        if (old_index[i] >= 0) {
+            pmap[i] = dm_old[old_index[i]];
+            load[pmap[i]] += cost[i];
+        } else {
+            unmatched.emplace_back(cost[i], i);
+        }
+    }
+
+    std::sort(unmatched.begin(), unmatched.end(), std::greater<>());
+    for (const auto& box : unmatched) {
+        int proc = static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+        pmap[box.second] = proc;
+        load[proc] += box.first;
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
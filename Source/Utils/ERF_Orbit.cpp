@@ -8,6 +8,7 @@ zenith (int& calday,
         amrex::MultiFab* clon,
         real1d& coszrs,
         int& ncol,
+        const Box& chunk_box,
         const Real& eccen,
         const Real& mvelpp,
         const Real& lambm0,
@@ -22,9 +23,16 @@ zenith (int& calday,
 
     // If we have a valid pointer, go through the whole machinery
     if (clat) {
+        // Columns are numbered within the chunk of rows being processed
+        const int ilo = chunk_box.smallEnd(0);
+        const int jlo = chunk_box.smallEnd(1);
+        const int nx  = chunk_box.length(0);
+        Box cbx2d(chunk_box);
+        cbx2d.setRange(2,0);
+
         for (MFIter mfi(*clat); mfi.isValid(); ++mfi) {
-            const auto& tbx = mfi.tilebox();
-            auto nx = tbx.length(0);
+            const auto& tbx = mfi.tilebox() & cbx2d;
+            if (!tbx.ok()) continue;
 
             auto lat_array = clat->array(mfi);
             auto lon_array = clon->array(mfi);
@@ -32,7 +40,7 @@ zenith (int& calday,
             // NOTE: lat/lon are 2D multifabs!
             ParallelFor(tbx, [=] AMREX_GPU_DEVICE (int i, int j, int /*k*/)
             {
-                auto icol = j*nx+i+1;
+                auto icol = (j-jlo)*nx + (i-ilo) + 1;
                 coszrs(icol) = shr_orb_cosz(calday, lat_array(i,j,0), lon_array(i,j,0), delta, uniform_angle);
             });
        }
@@ -1,6 +1,7 @@
 #include "ERF.H"
 #include <AMReX_MLMG.H>
 #include <AMReX_MLABecLaplacian.H>
+#include <AMReX_Utility.H>
 #include "ERF_Utils.H"
 
 #ifdef ERF_USE_POISSON_SOLVE
@@ -47,19 +48,28 @@ bool ERF::projection_has_dirichlet (Array<LinOpBCType,AMREX_SPACEDIM> bcs) const
 /**
  * Project the single-level velocity field to enforce incompressibility
  * Note that the level may or may not be level 0.
+ *
+ * For the anelastic dycore vmf holds the momenta (rho_0 u) instead, which are projected
+ * onto D(rho_0 u) = 0 with the update (rho_0 u) -= dt grad(phi)
  */
 void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFab& pmf)
 {
     BL_PROFILE("ERF::project_velocities()");
-    AMREX_ALWAYS_ASSERT(!solverChoice.use_terrain);
 
     // Make sure the solver only sees the levels over which we are solving
-    LPInfo info;
     Vector<BoxArray>            ba_tmp;   ba_tmp.push_back(vmf[Vars::cons].boxArray());
     Vector<DistributionMapping> dm_tmp;   dm_tmp.push_back(vmf[Vars::cons].DistributionMap());
     Vector<Geometry>          geom_tmp; geom_tmp.push_back(geom[lev]);
 
-    MLABecLaplacian mlabec(geom_tmp, ba_tmp, dm_tmp, info);
+    // The terrain-following multigrid solves on a single level that covers its domain;
+    // a fine level that does not falls back to MLMG (which cannot handle terrain)
+    bool use_terrain_mg = solverChoice.use_terrain || projection_terrain_mg;
+    if (use_terrain_mg && ba_tmp[0].numPts() != geom[lev].Domain().numPts()) {
+        if (solverChoice.use_terrain) {
+            Abort("The projection with terrain needs a level that covers its domain");
+        }
+        use_terrain_mg = false;
+    }
 
     //
     // This will hold (1/rho) on faces
@@ -71,7 +81,6 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
     // Here we set alpha to 0 and beta to -1
     // Then b is (dt/rho)
     //
-    mlabec.setScalars(0.0, -1.0);
     inv_rho[0].define(vmf[Vars::xvel].boxArray(),dm_tmp[0],1,0,MFInfo());
     inv_rho[1].define(vmf[Vars::yvel].boxArray(),dm_tmp[0],1,0,MFInfo());
     inv_rho[2].define(vmf[Vars::zvel].boxArray(),dm_tmp[0],1,0,MFInfo());
@@ -81,6 +90,8 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
 
     MultiFab r_hse(base_state[lev], make_alias, 0, 1); // r_0 is first  component
 
+    const bool l_anelastic = solverChoice.anelastic;
+
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -94,7 +105,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         ParallelFor(bxx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i-1,j,k));
-            inv_rhox_arr(i,j,k) = l_dt * rho_0_arr(i,j,k) / rho_edge;
+            inv_rhox_arr(i,j,k) = (l_anelastic) ? l_dt : l_dt * rho_0_arr(i,j,k) / rho_edge;
         });
 
         Box const& bxy = mfi.nodaltilebox(1);
@@ -102,7 +113,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         ParallelFor(bxy, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i,j-1,k));
-            inv_rhoy_arr(i,j,k) = l_dt * rho_0_arr(i,j,k) / rho_edge;
+            inv_rhoy_arr(i,j,k) = (l_anelastic) ? l_dt : l_dt * rho_0_arr(i,j,k) / rho_edge;
         });
 
         Box const& bxz = mfi.nodaltilebox(2);
@@ -111,22 +122,10 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         {
             Real rho_edge = Real(0.5) * (rho_arr(i,j,k) + rho_arr(i,j,k-1));
             Real rho_0_edge = Real(0.5) * (rho_0_arr(i,j,k) + rho_0_arr(i,j,k-1));
-            inv_rhoz_arr(i,j,k) = l_dt * rho_0_edge / rho_edge;
+            inv_rhoz_arr(i,j,k) = (l_anelastic) ? l_dt : l_dt * rho_0_edge / rho_edge;
         });
     } // mfi
 
-    mlabec.setBCoeffs(0, GetArrOfConstPtrs(inv_rho));
-
-    auto bclo = get_projection_bc(Orientation::low);
-    auto bchi = get_projection_bc(Orientation::high);
-    bool need_adjust_rhs = (projection_has_dirichlet(bclo) || projection_has_dirichlet(bchi)) ? false : true;
-    mlabec.setDomainBC(bclo, bchi);
-
-    if (lev > 0) {
-        mlabec.setCoarseFineBC(nullptr, ref_ratio[lev-1], LinOpBCType::Neumann);
-    }
-    mlabec.setLevelBC(0, nullptr);
-
     Vector<MultiFab> rhs;
     Vector<MultiFab> phi;
     Vector<Array<MultiFab,AMREX_SPACEDIM> > fluxes;
@@ -161,7 +160,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         Array4<Real      > const& rho0_u_arr = rho0_u[0].array(mfi);
         ParallelFor(bxx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            rho0_u_arr(i,j,k) = u_arr(i,j,k) * rho0_arr(i,j,k);
+            rho0_u_arr(i,j,k) = (l_anelastic) ? u_arr(i,j,k) : u_arr(i,j,k) * rho0_arr(i,j,k);
         });
 
         Box const& bxy = mfi.nodaltilebox(1);
@@ -169,7 +168,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         Array4<Real      > const& rho0_v_arr = rho0_u[1].array(mfi);
         ParallelFor(bxy, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            rho0_v_arr(i,j,k) = v_arr(i,j,k) * rho0_arr(i,j,k);
+            rho0_v_arr(i,j,k) = (l_anelastic) ? v_arr(i,j,k) : v_arr(i,j,k) * rho0_arr(i,j,k);
         });
 
         Box const& bxz = mfi.nodaltilebox(2);
@@ -178,7 +177,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         ParallelFor(bxz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real rho0_edge = Real(0.5) * (rho0_arr(i,j,k) + rho0_arr(i,j,k-1));
-            rho0_w_arr(i,j,k) = w_arr(i,j,k) * rho0_edge;
+            rho0_w_arr(i,j,k) = (l_anelastic) ? w_arr(i,j,k) : w_arr(i,j,k) * rho0_edge;
         });
     } // mfi
 
@@ -187,46 +186,89 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
     rho0_u_const[1] = &rho0_u[1];
     rho0_u_const[2] = &rho0_u[2];
 
-    computeDivergence(rhs[0], rho0_u_const, geom_tmp[0]);
-    Print() << "Max norm of divergence after  at level " << lev << " : " << rhs[0].norm0() << std::endl;
+    Real start = amrex::second();
 
-    // If all Neumann BCs, adjust RHS to make sure we can converge
-    if (need_adjust_rhs)
+    if (use_terrain_mg)
     {
-        Real offset = volWgtSumMF(lev, rhs[0], 0, *mapfac_m[lev], false, false);
-        // amrex::Print() << "Poisson solvability offset = " << offset << std::endl;
-        rhs[0].plus(-offset, 0, 1);
+        int niter = solve_projection_terrain(lev, inv_rho, rho0_u, rhs[0], phi[0]);
+
+        Real elapsed = amrex::second() - start;
+        ParallelDescriptor::ReduceRealMax(elapsed);
+
+        projection_solves[1] += 1;
+        projection_iters[1]  += niter;
+        projection_time[1]   += elapsed;
+        if (mg_verbose > 0) {
+            Print() << "Projection at level " << lev << " with terrain_mg: " << niter
+                    << " iterations in " << elapsed << " s" << std::endl;
+        }
     }
+    else
+    {
+        LPInfo info;
+        MLABecLaplacian mlabec(geom_tmp, ba_tmp, dm_tmp, info);
+        mlabec.setScalars(0.0, -1.0);
+        mlabec.setBCoeffs(0, GetArrOfConstPtrs(inv_rho));
+
+        auto bclo = get_projection_bc(Orientation::low);
+        auto bchi = get_projection_bc(Orientation::high);
+        bool need_adjust_rhs = (projection_has_dirichlet(bclo) || projection_has_dirichlet(bchi)) ? false : true;
+        mlabec.setDomainBC(bclo, bchi);
+
+        if (lev > 0) {
+            mlabec.setCoarseFineBC(nullptr, ref_ratio[lev-1], LinOpBCType::Neumann);
+        }
+        mlabec.setLevelBC(0, nullptr);
 
-    // Initialize phi to 0
-    phi[0].setVal(0.0);
+        computeDivergence(rhs[0], rho0_u_const, geom_tmp[0]);
+        Print() << "Max norm of divergence after  at level " << lev << " : " << rhs[0].norm0() << std::endl;
+
+        // If all Neumann BCs, adjust RHS to make sure we can converge
+        if (need_adjust_rhs)
+        {
+            Real offset = volWgtSumMF(lev, rhs[0], 0, *mapfac_m[lev], false, false);
+            // amrex::Print() << "Poisson solvability offset = " << offset << std::endl;
+            rhs[0].plus(-offset, 0, 1);
+        }
+
+        // Initialize phi to 0
+        phi[0].setVal(0.0);
 
-    MLMG mlmg(mlabec);
-    int max_iter = 100;
-    mlmg.setMaxIter(max_iter);
+        MLMG mlmg(mlabec);
+        int max_iter = 100;
+        mlmg.setMaxIter(max_iter);
 
-    mlmg.setVerbose(mg_verbose);
-    mlmg.setBottomVerbose(0);
+        mlmg.setVerbose(mg_verbose);
+        mlmg.setBottomVerbose(0);
 
-    mlmg.solve(GetVecOfPtrs(phi),
-               GetVecOfConstPtrs(rhs),
-               solverChoice.poisson_reltol,
-               solverChoice.poisson_abstol);
+        mlmg.solve(GetVecOfPtrs(phi),
+                   GetVecOfConstPtrs(rhs),
+                   solverChoice.poisson_reltol,
+                   solverChoice.poisson_abstol);
 
-    mlmg.getFluxes(GetVecOfArrOfPtrs(fluxes));
+        Real elapsed = amrex::second() - start;
+        ParallelDescriptor::ReduceRealMax(elapsed);
+
+        projection_solves[0] += 1;
+        projection_iters[0]  += mlmg.getNumIters();
+        projection_time[0]   += elapsed;
+        if (mg_verbose > 0) {
+            Print() << "Projection at level " << lev << " with mlmg: " << mlmg.getNumIters()
+                    << " iterations in " << elapsed << " s" << std::endl;
+        }
+
+        mlmg.getFluxes(GetVecOfArrOfPtrs(fluxes));
+
+        // Subtract (dt rho0/rho) grad(phi) from the rho0-weighted velocity components
+        MultiFab::Add(rho0_u[0], fluxes[0][0], 0,0,1,0);
+        MultiFab::Add(rho0_u[1], fluxes[0][1], 0,0,1,0);
+        MultiFab::Add(rho0_u[2], fluxes[0][2], 0,0,1,0);
+    }
 
     // Update pressure variable with phi -- note that phi is change in pressure, not the full pressure
     MultiFab::Saxpy(pmf, 1.0, phi[0],0,0,1,0);
     pmf.FillBoundary(geom[lev].periodicity());
 
-    // Subtract (dt rho0/rho) grad(phi) from the rho0-weighted velocity components
-    // MultiFab::Add(vmf[Vars::xvel], fluxes[0][0], 0,0,1,0);
-    // MultiFab::Add(vmf[Vars::yvel], fluxes[0][1], 0,0,1,0);
-    // MultiFab::Add(vmf[Vars::zvel], fluxes[0][2], 0,0,1,0);
-    MultiFab::Add(rho0_u[0], fluxes[0][0], 0,0,1,0);
-    MultiFab::Add(rho0_u[1], fluxes[0][1], 0,0,1,0);
-    MultiFab::Add(rho0_u[2], fluxes[0][2], 0,0,1,0);
-
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -239,7 +281,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         Array4<Real const> const& rho0_u_arr = rho0_u[0].array(mfi);
         ParallelFor(bxx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            u_arr(i,j,k) = rho0_u_arr(i,j,k) / rho0_arr(i,j,k);
+            u_arr(i,j,k) = (l_anelastic) ? rho0_u_arr(i,j,k) : rho0_u_arr(i,j,k) / rho0_arr(i,j,k);
         });
 
         Box const& bxy = mfi.nodaltilebox(1);
@@ -247,7 +289,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         Array4<Real const> const& rho0_v_arr = rho0_u[1].array(mfi);
         ParallelFor(bxy, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            v_arr(i,j,k) = rho0_v_arr(i,j,k) / rho0_arr(i,j,k);
+            v_arr(i,j,k) = (l_anelastic) ? rho0_v_arr(i,j,k) : rho0_v_arr(i,j,k) / rho0_arr(i,j,k);
         });
 
         Box const& bxz = mfi.nodaltilebox(2);
@@ -256,7 +298,7 @@ void ERF::project_velocities (int lev, Real l_dt, Vector<MultiFab>& vmf, MultiFa
         ParallelFor(bxz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             Real rho0_edge = Real(0.5) * (rho0_arr(i,j,k) + rho0_arr(i,j,k-1));
-            w_arr(i,j,k) = rho0_w_arr(i,j,k) / rho0_edge;
+            w_arr(i,j,k) = (l_anelastic) ? rho0_w_arr(i,j,k) : rho0_w_arr(i,j,k) / rho0_edge;
         });
     } // mfi
 
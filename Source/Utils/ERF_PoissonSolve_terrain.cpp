@@ -0,0 +1,69 @@
+#include "ERF.H"
+
+#ifdef ERF_USE_POISSON_SOLVE
+
+using namespace amrex;
+
+/**
+ * Solve for the projection of a single level with the terrain-following multigrid.
+ * beta = (dt rho0/rho) on faces, rho0_u holds the rho0-weighted velocities on entry
+ * and their projection on exit, phi the change in pressure.
+ *
+ * The multigrid hierarchy is built the first time it is needed and again only when the
+ * grids of the level change; the metric terms are recomputed only if the terrain moves.
+ */
+int
+ERF::solve_projection_terrain (int lev,
+                               const Array<MultiFab,AMREX_SPACEDIM>& beta,
+                               Array<MultiFab,AMREX_SPACEDIM>& rho0_u,
+                               MultiFab& rhs, MultiFab& phi)
+{
+    BL_PROFILE("ERF::solve_projection_terrain()");
+
+    const BoxArray&            ba = phi.boxArray();
+    const DistributionMapping& dm = phi.DistributionMap();
+
+    bool new_hierarchy = false;
+    if (!terrain_poisson[lev] || !terrain_poisson[lev]->sameGrids(ba, dm))
+    {
+        terrain_poisson[lev] = std::make_unique<TerrainPoisson>(geom[lev], ba, dm,
+                                                                get_projection_bc(Orientation::low),
+                                                                get_projection_bc(Orientation::high));
+        new_hierarchy = true;
+        if (mg_verbose > 0) {
+            Print() << "Terrain-following multigrid at level " << lev << " built with "
+                    << terrain_poisson[lev]->numLevels() << " levels" << std::endl;
+        }
+    }
+
+    TerrainPoisson& tp = *terrain_poisson[lev];
+    tp.setVerbose(mg_verbose);
+    tp.setMaxIter(projection_mg_max_iter);
+    tp.setSmoothSweeps(projection_mg_sweeps);
+    tp.setBottomSweeps(projection_mg_bottom_sweeps);
+    tp.setUseBiCGStab(projection_mg_bicgstab);
+
+    if (new_hierarchy || solverChoice.terrain_type != TerrainType::Static) {
+        tp.setTerrain(solverChoice.use_terrain ? z_phys_nd[lev].get() : nullptr);
+    }
+    tp.setCoeffs(GetArrOfConstPtrs(beta));
+
+    tp.computeDivergence(rhs, GetArrOfConstPtrs(rho0_u));
+    Print() << "Max norm of divergence before solve at level " << lev << " : " << rhs.norm0() << std::endl;
+
+    phi.setVal(0.0);
+    int niter = tp.solve(phi, rhs, solverChoice.poisson_reltol, solverChoice.poisson_abstol);
+
+    // Subtract beta grad(phi) from the rho0-weighted velocity components
+    Array<MultiFab,AMREX_SPACEDIM> fluxes;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        fluxes[idim].define(rho0_u[idim].boxArray(), dm, 1, 0);
+    }
+    tp.getFluxes(GetArrOfPtrs(fluxes));
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        MultiFab::Subtract(rho0_u[idim], fluxes[idim], 0, 0, 1, 0);
+    }
+
+    return niter;
+}
+#endif
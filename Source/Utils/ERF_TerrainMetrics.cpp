@@ -96,7 +96,8 @@ init_terrain_grid (int lev, const Geometry& geom, MultiFab& z_phys_nd,
         if (all_boxes_touch_bottom) {
             init_which_terrain_grid(lev, geom, z_phys_nd, z_levels_h);
         } else {
-
+            // The grids do not hold whole columns (see erf.column_grids), so
+            // build the terrain on a temporary column decomposition
             BoxArray ba_new(domain);
             ChopGrids2D(ba_new, domain, ParallelDescriptor::NProcs());
 
@@ -671,3 +672,76 @@ make_zcc (const Geometry& geom,
     }
     z_phys_cc.FillBoundary(geom.periodicity());
 }
+
+/**
+ * Set up compact metrics from the nodal heights of a level and check that they reproduce them
+ */
+bool
+CompactTerrain::define (const Geometry& geom,
+                        const MultiFab& z_phys_nd,
+                        const Vector<Real>& zlevels_stag)
+{
+    const Box& domain = geom.Domain();
+    int domlo_z = domain.smallEnd(2);
+    int domhi_z = domain.bigEnd(2) + 1; // nodal
+    int nz = domain.length(2) + 1;
+    AMREX_ALWAYS_ASSERT(static_cast<int>(zlevels_stag.size()) == nz);
+
+    // Level heights with the linear extrapolation used for the z ghost nodes of z_phys_nd
+    Vector<Real> z_lev_h(nz+2);
+    for (int k = 0; k < nz; k++) {
+        z_lev_h[k+1] = zlevels_stag[k];
+    }
+    z_lev_h[0]    = 2.0*zlevels_stag[0]    - zlevels_stag[1];
+    z_lev_h[nz+1] = 2.0*zlevels_stag[nz-1] - zlevels_stag[nz-2];
+
+    m_z_lev.resize(nz+2);
+    Gpu::copy(Gpu::hostToDevice, z_lev_h.begin(), z_lev_h.end(), m_z_lev.begin());
+
+    m_domlo_z   = domlo_z;
+    m_z_top     = zlevels_stag[nz-1];
+    m_z_lev_sfc = zlevels_stag[0];
+    m_dzInv     = geom.InvCellSize(2);
+
+    // Surface heights on the grids of z_phys_nd, flattened to k = 0
+    BoxList bl2d = z_phys_nd.boxArray().boxList();
+    for (auto& b : bl2d) {
+        b.setRange(2,0);
+    }
+    BoxArray ba2d(std::move(bl2d));
+    IntVect ng2d = z_phys_nd.nGrowVect(); ng2d[2] = 0;
+    m_z_sfc = std::make_unique<MultiFab>(ba2d, z_phys_nd.DistributionMap(), 1, ng2d);
+    m_z_sfc->ParallelCopy(z_phys_nd, 0, 0, 1, ng2d, ng2d);
+
+    // Compare with the stored heights over the valid nodes and the ghost nodes set by
+    // init_terrain_grid
+    ReduceOps<ReduceOpMax> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    for (MFIter mfi(z_phys_nd); mfi.isValid(); ++mfi)
+    {
+        Box gbx = mfi.growntilebox(ng2d);
+        if (gbx.smallEnd(2) == domlo_z) { gbx.setSmall(2, domlo_z-1); }
+        if (gbx.bigEnd(2)   == domhi_z) { gbx.setBig  (2, domhi_z+1); }
+
+        const auto z_arr = z_phys_nd.const_array(mfi);
+        const CompactTerrainMetric cm = view(mfi);
+
+        reduce_op.eval(gbx, reduce_data, [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+            return { std::abs(z_arr(i,j,k) - cm.z_nd(i,j,k)) };
+        });
+    }
+
+    Real max_diff = amrex::get<0>(reduce_data.value());
+    ParallelDescriptor::ReduceRealMax(max_diff);
+
+    Real tol = 1.0e-10 * std::abs(m_z_top - z_lev_h[0]);
+    if (max_diff > tol) {
+        m_z_sfc.reset();
+        m_z_lev.clear();
+        return false;
+    }
+    return true;
+}
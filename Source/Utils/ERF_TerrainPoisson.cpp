@@ -0,0 +1,886 @@
+#include <ERF_TerrainPoisson.H>
+#include <ERF_TerrainMetrics.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+namespace {
+    // Treatment of the faces of a cell on the domain boundary
+    enum { TP_interior = 0, TP_neumann, TP_dirichlet };
+
+    int tp_bc_type (LinOpBCType bc)
+    {
+        if (bc == LinOpBCType::Dirichlet) { return TP_dirichlet; }
+        if (bc == LinOpBCType::Neumann)   { return TP_neumann; }
+        return TP_interior;
+    }
+}
+
+/**
+ * Vertical derivative of phi averaged onto an x-face (ioff = 1) or y-face (joff = 1),
+ * one-sided at the bottom and top as in the pressure gradient of slow_rhs_pre
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_gp_zeta (int i, int j, int k, int ioff, int joff,
+            const Array4<const Real>& phi, Real dzInv, int domlo_z, int domhi_z)
+{
+    if (k == domlo_z) {
+        return 0.5 * dzInv * ( phi(i-ioff,j-joff,k+1) + phi(i,j,k+1)
+                             - phi(i-ioff,j-joff,k  ) - phi(i,j,k  ) );
+    } else if (k == domhi_z) {
+        return 0.5 * dzInv * ( phi(i-ioff,j-joff,k  ) + phi(i,j,k  )
+                             - phi(i-ioff,j-joff,k-1) - phi(i,j,k-1) );
+    }
+    return 0.25 * dzInv * ( phi(i-ioff,j-joff,k+1) + phi(i,j,k+1)
+                          - phi(i-ioff,j-joff,k-1) - phi(i,j,k-1) );
+}
+
+/**
+ * beta G(phi) on x-face (i,j,k); zero on a Neumann domain face and the normal derivative
+ * to phi = 0 on the face on a Dirichlet domain face
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_flux_x (int i, int j, int k,
+           const Array4<const Real>& phi, const Array4<const Real>& beta,
+           const Array4<const Real>& z_nd, const GpuArray<Real,AMREX_SPACEDIM>& dxInv,
+           const Box& domain, int bclo, int bchi)
+{
+    if (i == domain.smallEnd(0) && bclo != TP_interior) {
+        return (bclo == TP_dirichlet) ?  2.0 * dxInv[0] * beta(i,j,k) * phi(i,j,k) : 0.0;
+    }
+    if (i == domain.bigEnd(0)+1 && bchi != TP_interior) {
+        return (bchi == TP_dirichlet) ? -2.0 * dxInv[0] * beta(i,j,k) * phi(i-1,j,k) : 0.0;
+    }
+    Real met_h_xi   = Compute_h_xi_AtIface  (i, j, k, dxInv, z_nd);
+    Real met_h_zeta = Compute_h_zeta_AtIface(i, j, k, dxInv, z_nd);
+    Real gpx = dxInv[0] * (phi(i,j,k) - phi(i-1,j,k))
+             - (met_h_xi / met_h_zeta) * tp_gp_zeta(i, j, k, 1, 0, phi, dxInv[2],
+                                                     domain.smallEnd(2), domain.bigEnd(2));
+    return beta(i,j,k) * gpx;
+}
+
+/**
+ * beta G(phi) on y-face (i,j,k)
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_flux_y (int i, int j, int k,
+           const Array4<const Real>& phi, const Array4<const Real>& beta,
+           const Array4<const Real>& z_nd, const GpuArray<Real,AMREX_SPACEDIM>& dxInv,
+           const Box& domain, int bclo, int bchi)
+{
+    if (j == domain.smallEnd(1) && bclo != TP_interior) {
+        return (bclo == TP_dirichlet) ?  2.0 * dxInv[1] * beta(i,j,k) * phi(i,j,k) : 0.0;
+    }
+    if (j == domain.bigEnd(1)+1 && bchi != TP_interior) {
+        return (bchi == TP_dirichlet) ? -2.0 * dxInv[1] * beta(i,j,k) * phi(i,j-1,k) : 0.0;
+    }
+    Real met_h_eta  = Compute_h_eta_AtJface (i, j, k, dxInv, z_nd);
+    Real met_h_zeta = Compute_h_zeta_AtJface(i, j, k, dxInv, z_nd);
+    Real gpy = dxInv[1] * (phi(i,j,k) - phi(i,j-1,k))
+             - (met_h_eta / met_h_zeta) * tp_gp_zeta(i, j, k, 0, 1, phi, dxInv[2],
+                                                      domain.smallEnd(2), domain.bigEnd(2));
+    return beta(i,j,k) * gpy;
+}
+
+/**
+ * beta G(phi) on z-face (i,j,k); the bottom and top are walls
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_flux_z (int i, int j, int k,
+           const Array4<const Real>& phi, const Array4<const Real>& beta,
+           const Array4<const Real>& z_nd, const GpuArray<Real,AMREX_SPACEDIM>& dxInv,
+           const Box& domain)
+{
+    if (k == domain.smallEnd(2) || k == domain.bigEnd(2)+1) { return 0.0; }
+    Real met_h_zeta = Compute_h_zeta_AtKface(i, j, k, dxInv, z_nd);
+    return beta(i,j,k) * dxInv[2] * (phi(i,j,k) - phi(i,j,k-1)) / met_h_zeta;
+}
+
+/**
+ * Terrain-following divergence of (fx, fy) and the contravariant vertical flux Omega
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_divergence (int i, int j, int k,
+               const Array4<const Real>& fx, const Array4<const Real>& fy,
+               Real omega_lo, Real omega_hi,
+               const Array4<const Real>& z_nd, const Array4<const Real>& detJ,
+               const GpuArray<Real,AMREX_SPACEDIM>& dxInv)
+{
+    Real ax_lo = Compute_h_zeta_AtIface(i  , j  , k, dxInv, z_nd);
+    Real ax_hi = Compute_h_zeta_AtIface(i+1, j  , k, dxInv, z_nd);
+    Real ay_lo = Compute_h_zeta_AtJface(i  , j  , k, dxInv, z_nd);
+    Real ay_hi = Compute_h_zeta_AtJface(i  , j+1, k, dxInv, z_nd);
+    return ( (ax_hi * fx(i+1,j,k) - ax_lo * fx(i,j,k)) * dxInv[0]
+           + (ay_hi * fy(i,j+1,k) - ay_lo * fy(i,j,k)) * dxInv[1]
+           + (omega_hi - omega_lo) * dxInv[2] ) / detJ(i,j,k);
+}
+
+/**
+ * Coefficient of the vertical coupling through z-face (i,j,k) used by the line smoother:
+ * the flux beta_z dphi/dz plus the part of Omega carried by the terrain slopes
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_line_cz (int i, int j, int k,
+            const Array4<const Real>& bx, const Array4<const Real>& by,
+            const Array4<const Real>& bz, const Array4<const Real>& z_nd,
+            const GpuArray<Real,AMREX_SPACEDIM>& dxInv, const Box& domain)
+{
+    if (k == domain.smallEnd(2) || k == domain.bigEnd(2)+1) { return 0.0; }
+    Real met_h_xi   = Compute_h_xi_AtKface  (i, j, k, dxInv, z_nd);
+    Real met_h_eta  = Compute_h_eta_AtKface (i, j, k, dxInv, z_nd);
+    Real met_h_zeta = Compute_h_zeta_AtKface(i, j, k, dxInv, z_nd);
+    Real bx_avg = 0.25 * ( bx(i,j,k-1) + bx(i+1,j,k-1) + bx(i,j,k) + bx(i+1,j,k) );
+    Real by_avg = 0.25 * ( by(i,j,k-1) + by(i,j+1,k-1) + by(i,j,k) + by(i,j+1,k) );
+    return (bz(i,j,k) + met_h_xi*met_h_xi*bx_avg + met_h_eta*met_h_eta*by_avg) * dxInv[2] / met_h_zeta;
+}
+
+/**
+ * Weight of a lateral face in the diagonal of the line smoother
+ */
+AMREX_GPU_DEVICE
+AMREX_FORCE_INLINE
+Real
+tp_face_weight (bool on_domain_face, int bc)
+{
+    if (!on_domain_face || bc == TP_interior) { return 1.0; }
+    return (bc == TP_dirichlet) ? 2.0 : 0.0;
+}
+
+TerrainPoisson::TerrainPoisson (const Geometry& geom,
+                                const BoxArray& ba,
+                                const DistributionMapping& dm,
+                                const Array<LinOpBCType,AMREX_SPACEDIM>& bclo,
+                                const Array<LinOpBCType,AMREX_SPACEDIM>& bchi)
+    : m_bclo(bclo), m_bchi(bchi)
+{
+    BL_PROFILE("TerrainPoisson::TerrainPoisson()");
+
+    // The bottom and top are walls in tp_flux_z and tp_line_cz
+    if (bclo[2] == LinOpBCType::Dirichlet || bchi[2] == LinOpBCType::Dirichlet) {
+        Abort("TerrainPoisson: the bottom and top of the domain must be walls, not Outflow");
+    }
+
+    for (int dir = 0; dir < 2; ++dir) {
+        if (bclo[dir] == LinOpBCType::Dirichlet || bchi[dir] == LinOpBCType::Dirichlet) {
+            m_singular = false;
+        }
+    }
+
+    //
+    // Coarsen in x and/or y until the grids cannot be coarsened any more; a direction is
+    // only coarsened while its cells are not much wider than in the other direction
+    //
+    m_geom.push_back(geom);
+    m_ba.push_back(ba);
+    m_dmap.push_back(dm);
+    while (true)
+    {
+        const Geometry& g = m_geom.back();
+        const BoxArray& b = m_ba.back();
+        const Real* dx = g.CellSize();
+
+        bool dom_x = g.Domain().coarsenable(IntVect(2,1,1));
+        bool dom_y = g.Domain().coarsenable(IntVect(1,2,1));
+        bool can_x = dom_x && b.coarsenable(IntVect(2,1,1), IntVect(2,1,1));
+        bool can_y = dom_y && b.coarsenable(IntVect(1,2,1), IntVect(1,2,1));
+
+        // When the boxes are too small to be coarsened but the domain is not, the level is
+        //    gathered into a single box on one rank, which is then coarsened further
+        if (!can_x && !can_y && b.size() > 1 && (dom_x || dom_y)) {
+            Geometry g_agg = g;
+            BoxArray b_agg(g_agg.Domain());
+            m_ratio.push_back(IntVect(1));
+            m_geom.push_back(g_agg);
+            m_ba.push_back(b_agg);
+            m_dmap.push_back(DistributionMapping(Vector<int>{ParallelDescriptor::IOProcessorNumber()}));
+            continue;
+        }
+
+        bool crse_x = can_x && (!can_y || dx[0] <= 1.5*dx[1]);
+        bool crse_y = can_y && (!can_x || dx[1] <= 1.5*dx[0]);
+        if (!crse_x && !crse_y) { break; }
+
+        IntVect ratio(crse_x ? 2 : 1, crse_y ? 2 : 1, 1);
+        Geometry g_crse = amrex::coarsen(g, ratio);
+        BoxArray b_crse = amrex::coarsen(b, ratio);
+        m_ratio.push_back(ratio);
+        m_geom.push_back(g_crse);
+        m_ba.push_back(b_crse);
+        m_dmap.push_back(m_dmap.back());
+    }
+
+    int nlevs = numLevels();
+    m_z_nd.resize(nlevs);
+    m_detJ.resize(nlevs);
+    m_beta.resize(nlevs);
+    m_line.resize(nlevs);
+    m_phi.resize(nlevs);
+    m_rhs.resize(nlevs);
+    m_res.resize(nlevs);
+
+    for (int lev = 0; lev < nlevs; ++lev)
+    {
+        const BoxArray& b = m_ba[lev];
+        const DistributionMapping& d = m_dmap[lev];
+        m_z_nd[lev].define(convert(b,IntVect(1,1,1)), d, 1, 1);
+        m_detJ[lev].define(b, d, 1, 0);
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            m_beta[lev][dir].define(convert(b,IntVect::TheDimensionVector(dir)), d, 1, IntVect(0,0,1));
+            m_beta[lev][dir].setVal(0.0);
+        }
+        m_line[lev].define(b, d, 3, 0);
+        m_phi[lev].define(b, d, 1, IntVect(1,1,2));
+        m_rhs[lev].define(b, d, 1, 0);
+        m_res[lev].define(b, d, 1, 0);
+        m_z_nd[lev].setVal(0.0);
+        m_phi[lev].setVal(0.0);
+    }
+
+    for (auto* mf : {&m_sol, &m_phat, &m_shat}) {
+        mf->define(ba, dm, 1, IntVect(1,1,2));
+        mf->setVal(0.0);
+    }
+    for (auto* mf : {&m_b, &m_r, &m_rhat, &m_p, &m_v, &m_s, &m_t}) {
+        mf->define(ba, dm, 1, 0);
+    }
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        m_face[dir].define(convert(ba,IntVect::TheDimensionVector(dir)), dm, 1, IntVect(0,0,1));
+        m_face[dir].setVal(0.0);
+    }
+}
+
+bool
+TerrainPoisson::sameGrids (const BoxArray& ba, const DistributionMapping& dm) const
+{
+    return (m_ba[0] == ba) && (m_dmap[0] == dm);
+}
+
+void
+TerrainPoisson::setTerrain (const MultiFab* z_phys_nd)
+{
+    BL_PROFILE("TerrainPoisson::setTerrain()");
+
+    if (z_phys_nd) {
+        MultiFab::Copy(m_z_nd[0], *z_phys_nd, 0, 0, 1, 1);
+    } else {
+        const Real z_lo = m_geom[0].ProbLo(2);
+        const Real dz   = m_geom[0].CellSize(2);
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(m_z_nd[0], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& gbx = mfi.growntilebox();
+            const Array4<Real>& z_arr = m_z_nd[0].array(mfi);
+            ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                z_arr(i,j,k) = z_lo + k * dz;
+            });
+        }
+    }
+
+    // The coarse levels take the heights of the fine nodes they coincide with
+    for (int lev = 0; lev < numLevels()-1; ++lev)
+    {
+        if (agglomerated(lev)) {
+            m_z_nd[lev+1].ParallelCopy(m_z_nd[lev]);
+            m_z_nd[lev+1].FillBoundary(m_geom[lev+1].periodicity());
+            continue;
+        }
+
+        const int rx = m_ratio[lev][0];
+        const int ry = m_ratio[lev][1];
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(m_z_nd[lev+1], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const Array4<Real const>& z_fine = m_z_nd[lev  ].const_array(mfi);
+            const Array4<Real      >& z_crse = m_z_nd[lev+1].array(mfi);
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                z_crse(i,j,k) = z_fine(rx*i,ry*j,k);
+            });
+        }
+        m_z_nd[lev+1].FillBoundary(m_geom[lev+1].periodicity());
+    }
+
+    for (int lev = 0; lev < numLevels(); ++lev)
+    {
+        const auto dxInv = m_geom[lev].InvCellSizeArray();
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(m_detJ[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const Array4<Real const>& z_nd = m_z_nd[lev].const_array(mfi);
+            const Array4<Real      >& detJ = m_detJ[lev].array(mfi);
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                detJ(i,j,k) = Compute_h_zeta_AtCellCenter(i, j, k, dxInv, z_nd);
+            });
+        }
+    }
+
+    m_has_terrain = true;
+    m_has_coeffs  = false;
+}
+
+void
+TerrainPoisson::setCoeffs (const Array<const MultiFab*,AMREX_SPACEDIM>& beta)
+{
+    BL_PROFILE("TerrainPoisson::setCoeffs()");
+    AMREX_ALWAYS_ASSERT(m_has_terrain);
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        MultiFab::Copy(m_beta[0][dir], *beta[dir], 0, 0, 1, 0);
+        m_beta[0][dir].FillBoundary(m_geom[0].periodicity());
+    }
+
+    // The coarse face coefficients are the averages of the fine faces they cover
+    for (int lev = 0; lev < numLevels()-1; ++lev)
+    {
+        if (agglomerated(lev)) {
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                m_beta[lev+1][dir].ParallelCopy(m_beta[lev][dir]);
+                m_beta[lev+1][dir].FillBoundary(m_geom[lev+1].periodicity());
+            }
+            continue;
+        }
+
+        const int rx = m_ratio[lev][0];
+        const int ry = m_ratio[lev][1];
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(m_detJ[lev+1], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Array4<Real const>& bx_fine = m_beta[lev  ][0].const_array(mfi);
+            const Array4<Real const>& by_fine = m_beta[lev  ][1].const_array(mfi);
+            const Array4<Real const>& bz_fine = m_beta[lev  ][2].const_array(mfi);
+            const Array4<Real      >& bx_crse = m_beta[lev+1][0].array(mfi);
+            const Array4<Real      >& by_crse = m_beta[lev+1][1].array(mfi);
+            const Array4<Real      >& bz_crse = m_beta[lev+1][2].array(mfi);
+
+            ParallelFor(mfi.nodaltilebox(0), mfi.nodaltilebox(1), mfi.nodaltilebox(2),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real sum = 0.0;
+                for (int n = 0; n < ry; ++n) { sum += bx_fine(rx*i,ry*j+n,k); }
+                bx_crse(i,j,k) = sum / ry;
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real sum = 0.0;
+                for (int m = 0; m < rx; ++m) { sum += by_fine(rx*i+m,ry*j,k); }
+                by_crse(i,j,k) = sum / rx;
+            },
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real sum = 0.0;
+                for (int n = 0; n < ry; ++n) {
+                    for (int m = 0; m < rx; ++m) { sum += bz_fine(rx*i+m,ry*j+n,k); }
+                }
+                bz_crse(i,j,k) = sum / (rx*ry);
+            });
+        }
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            m_beta[lev+1][dir].FillBoundary(m_geom[lev+1].periodicity());
+        }
+    }
+
+    for (int lev = 0; lev < numLevels(); ++lev) {
+        make_line_coeffs(lev);
+    }
+    m_has_coeffs = true;
+}
+
+// Lower, diagonal and upper coefficients of the operator along each column
+void
+TerrainPoisson::make_line_coeffs (int lev)
+{
+    const Box domain = m_geom[lev].Domain();
+    const auto dxInv = m_geom[lev].InvCellSizeArray();
+    GpuArray<int,AMREX_SPACEDIM> bclo, bchi;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        bclo[dir] = tp_bc_type(m_bclo[dir]);
+        bchi[dir] = tp_bc_type(m_bchi[dir]);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(m_line[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const Array4<Real const>& z_nd = m_z_nd[lev].const_array(mfi);
+        const Array4<Real const>& detJ = m_detJ[lev].const_array(mfi);
+        const Array4<Real const>& beta_x = m_beta[lev][0].const_array(mfi);
+        const Array4<Real const>& beta_y = m_beta[lev][1].const_array(mfi);
+        const Array4<Real const>& beta_z = m_beta[lev][2].const_array(mfi);
+        const Array4<Real      >& line = m_line[lev].array(mfi);
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real J  = detJ(i,j,k);
+            Real lo = tp_line_cz(i, j, k  , beta_x, beta_y, beta_z, z_nd, dxInv, domain) * dxInv[2] / J;
+            Real up = tp_line_cz(i, j, k+1, beta_x, beta_y, beta_z, z_nd, dxInv, domain) * dxInv[2] / J;
+
+            Real cx_lo = Compute_h_zeta_AtIface(i  , j, k, dxInv, z_nd) * beta_x(i  ,j,k);
+            Real cx_hi = Compute_h_zeta_AtIface(i+1, j, k, dxInv, z_nd) * beta_x(i+1,j,k);
+            Real cy_lo = Compute_h_zeta_AtJface(i, j  , k, dxInv, z_nd) * beta_y(i,j  ,k);
+            Real cy_hi = Compute_h_zeta_AtJface(i, j+1, k, dxInv, z_nd) * beta_y(i,j+1,k);
+
+            Real diag = -(lo + up)
+                - ( tp_face_weight(i == domain.smallEnd(0), bclo[0]) * cx_lo
+                  + tp_face_weight(i == domain.bigEnd(0)  , bchi[0]) * cx_hi ) * dxInv[0] * dxInv[0] / J
+                - ( tp_face_weight(j == domain.smallEnd(1), bclo[1]) * cy_lo
+                  + tp_face_weight(j == domain.bigEnd(1)  , bchi[1]) * cy_hi ) * dxInv[1] * dxInv[1] / J;
+
+            line(i,j,k,0) = lo;
+            line(i,j,k,1) = diag;
+            line(i,j,k,2) = up;
+        });
+    }
+}
+
+// Lphi = L(phi); fills the ghost cells of phi
+void
+TerrainPoisson::apply (int lev, MultiFab& Lphi, MultiFab& phi)
+{
+    BL_PROFILE("TerrainPoisson::apply()");
+
+    phi.FillBoundary(m_geom[lev].periodicity());
+
+    const Box domain = m_geom[lev].Domain();
+    const auto dxInv = m_geom[lev].InvCellSizeArray();
+    const int bclo_x = tp_bc_type(m_bclo[0]);
+    const int bchi_x = tp_bc_type(m_bchi[0]);
+    const int bclo_y = tp_bc_type(m_bclo[1]);
+    const int bchi_y = tp_bc_type(m_bchi[1]);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(Lphi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        // Omega on the z-faces of bx needs the lateral fluxes one cell above and below
+        Box gbx = amrex::grow(bx, 2, 1);
+        gbx.setSmall(2, std::max(gbx.smallEnd(2), domain.smallEnd(2)));
+        gbx.setBig  (2, std::min(gbx.bigEnd(2)  , domain.bigEnd(2)));
+
+        FArrayBox fx_fab(surroundingNodes(gbx,0), 1, The_Async_Arena());
+        FArrayBox fy_fab(surroundingNodes(gbx,1), 1, The_Async_Arena());
+
+        const Array4<Real const>& phi_arr = phi.const_array(mfi);
+        const Array4<Real const>& z_nd    = m_z_nd[lev].const_array(mfi);
+        const Array4<Real const>& detJ    = m_detJ[lev].const_array(mfi);
+        const Array4<Real const>& beta_x  = m_beta[lev][0].const_array(mfi);
+        const Array4<Real const>& beta_y  = m_beta[lev][1].const_array(mfi);
+        const Array4<Real const>& beta_z  = m_beta[lev][2].const_array(mfi);
+        const Array4<Real      >& fx      = fx_fab.array();
+        const Array4<Real      >& fy      = fy_fab.array();
+        const Array4<Real      >& L_arr   = Lphi.array(mfi);
+
+        ParallelFor(fx_fab.box(), fy_fab.box(),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            fx(i,j,k) = tp_flux_x(i, j, k, phi_arr, beta_x, z_nd, dxInv, domain, bclo_x, bchi_x);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            fy(i,j,k) = tp_flux_y(i, j, k, phi_arr, beta_y, z_nd, dxInv, domain, bclo_y, bchi_y);
+        });
+
+        const Array4<Real const>& fx_c = fx_fab.const_array();
+        const Array4<Real const>& fy_c = fy_fab.const_array();
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real omega_lo = (k == domain.smallEnd(2)) ? 0.0 :
+                OmegaFromW(i, j, k  , tp_flux_z(i, j, k  , phi_arr, beta_z, z_nd, dxInv, domain),
+                           fx_c, fy_c, z_nd, dxInv);
+            Real omega_hi = (k == domain.bigEnd(2)) ? 0.0 :
+                OmegaFromW(i, j, k+1, tp_flux_z(i, j, k+1, phi_arr, beta_z, z_nd, dxInv, domain),
+                           fx_c, fy_c, z_nd, dxInv);
+            L_arr(i,j,k) = tp_divergence(i, j, k, fx_c, fy_c, omega_lo, omega_hi, z_nd, detJ, dxInv);
+        });
+    }
+}
+
+// res = rhs - L(phi)
+void
+TerrainPoisson::residual (int lev, MultiFab& res, MultiFab& phi, const MultiFab& rhs)
+{
+    apply(lev, res, phi);
+    MultiFab::Xpay(res, -1.0, rhs, 0, 0, 1, 0);
+}
+
+/**
+ * Zebra line relaxation: the columns of one color, (i+j) even or odd, are solved exactly
+ * within each box for the current residual, then the columns of the other color
+ */
+void
+TerrainPoisson::smooth (int lev, int nsweeps, int first_color)
+{
+    BL_PROFILE("TerrainPoisson::smooth()");
+
+    for (int sweep = 0; sweep < nsweeps; ++sweep) {
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            const int color = (first_color + pass) % 2;
+            residual(lev, m_res[lev], m_phi[lev], m_rhs[lev]);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(m_phi[lev]); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.validbox();
+                const int klo = bx.smallEnd(2);
+                const int khi = bx.bigEnd(2);
+
+                FArrayBox work_fab(bx, 2, The_Async_Arena());
+                const Array4<Real      >& work = work_fab.array();
+                const Array4<Real const>& line = m_line[lev].const_array(mfi);
+                const Array4<Real const>& res  = m_res[lev].const_array(mfi);
+                const Array4<Real      >& phi  = m_phi[lev].array(mfi);
+
+                ParallelFor(makeSlab(bx,2,klo), [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+                {
+                    if (((i+j) & 1) != color) { return; }
+
+                    // Thomas algorithm, with the couplings across the ends of the box lagged
+                    work(i,j,klo,0) = line(i,j,klo,2) / line(i,j,klo,1);
+                    work(i,j,klo,1) = res (i,j,klo  ) / line(i,j,klo,1);
+                    for (int k = klo+1; k <= khi; ++k) {
+                        Real m = line(i,j,k,1) - line(i,j,k,0) * work(i,j,k-1,0);
+                        work(i,j,k,0) =  line(i,j,k,2) / m;
+                        work(i,j,k,1) = (res(i,j,k) - line(i,j,k,0) * work(i,j,k-1,1)) / m;
+                    }
+                    Real delta = work(i,j,khi,1);
+                    phi(i,j,khi) += delta;
+                    for (int k = khi-1; k >= klo; --k) {
+                        delta = work(i,j,k,1) - work(i,j,k,0) * delta;
+                        phi(i,j,k) += delta;
+                    }
+                });
+            }
+        }
+    }
+}
+
+// rhs of level lev+1 = volume-weighted average of the residual of level lev
+void
+TerrainPoisson::restrict_residual (int lev)
+{
+    if (agglomerated(lev)) {
+        m_rhs[lev+1].ParallelCopy(m_res[lev]);
+        return;
+    }
+
+    const int rx = m_ratio[lev][0];
+    const int ry = m_ratio[lev][1];
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(m_rhs[lev+1], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const Array4<Real const>& res_fine  = m_res [lev  ].const_array(mfi);
+        const Array4<Real const>& detJ_fine = m_detJ[lev  ].const_array(mfi);
+        const Array4<Real const>& detJ_crse = m_detJ[lev+1].const_array(mfi);
+        const Array4<Real      >& rhs_crse  = m_rhs [lev+1].array(mfi);
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real sum = 0.0;
+            for (int n = 0; n < ry; ++n) {
+                for (int m = 0; m < rx; ++m) {
+                    sum += detJ_fine(rx*i+m,ry*j+n,k) * res_fine(rx*i+m,ry*j+n,k);
+                }
+            }
+            rhs_crse(i,j,k) = sum / (rx * ry * detJ_crse(i,j,k));
+        });
+    }
+}
+
+// phi of level lev += piecewise constant interpolation of the correction of level lev+1
+void
+TerrainPoisson::prolong_correction (int lev)
+{
+    if (agglomerated(lev)) {
+        MultiFab corr(m_ba[lev], m_dmap[lev], 1, 0);
+        corr.ParallelCopy(m_phi[lev+1]);
+        MultiFab::Add(m_phi[lev], corr, 0, 0, 1, 0);
+        return;
+    }
+
+    const int rx = m_ratio[lev][0];
+    const int ry = m_ratio[lev][1];
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(m_phi[lev], TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const Array4<Real const>& phi_crse = m_phi[lev+1].const_array(mfi);
+        const Array4<Real      >& phi_fine = m_phi[lev  ].array(mfi);
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            phi_fine(i,j,k) += phi_crse(i/rx,j/ry,k);
+        });
+    }
+}
+
+// Approximate solve of L(phi) = rhs on level lev, starting from m_phi[lev]
+void
+TerrainPoisson::vcycle (int lev)
+{
+    if (lev == numLevels()-1) {
+        smooth(lev, m_bottom_sweeps, 0);
+        return;
+    }
+
+    smooth(lev, m_nu, 0);
+
+    residual(lev, m_res[lev], m_phi[lev], m_rhs[lev]);
+    restrict_residual(lev);
+    m_phi[lev+1].setVal(0.0);
+
+    vcycle(lev+1);
+
+    prolong_correction(lev);
+    smooth(lev, m_nu, 1);
+}
+
+// z = one V-cycle applied to r
+void
+TerrainPoisson::precondition (MultiFab& z, const MultiFab& r)
+{
+    MultiFab::Copy(m_rhs[0], r, 0, 0, 1, 0);
+    m_phi[0].setVal(0.0);
+    vcycle(0);
+    MultiFab::Copy(z, m_phi[0], 0, 0, 1, 0);
+}
+
+// BiCGStab preconditioned with a V-cycle for L(m_sol) = m_b
+int
+TerrainPoisson::bicgstab (Real tol, Real& rnorm)
+{
+    residual(0, m_r, m_sol, m_b);
+    rnorm = m_r.norm0();
+    if (rnorm <= tol) { return 0; }
+
+    MultiFab::Copy(m_rhat, m_r, 0, 0, 1, 0);
+    m_p.setVal(0.0);
+    m_v.setVal(0.0);
+
+    Real rho = 1.0, alpha = 1.0, omega = 1.0;
+    for (int iter = 1; iter <= m_max_iter; ++iter)
+    {
+        Real rho_new = MultiFab::Dot(m_rhat, 0, m_r, 0, 1, 0);
+        if (rho_new == 0.0) { return iter; }
+
+        if (iter == 1) {
+            MultiFab::Copy(m_p, m_r, 0, 0, 1, 0);
+        } else {
+            Real beta = (rho_new / rho) * (alpha / omega);
+            MultiFab::Saxpy(m_p, -omega, m_v, 0, 0, 1, 0);
+            MultiFab::Xpay (m_p,   beta, m_r, 0, 0, 1, 0);
+        }
+
+        precondition(m_phat, m_p);
+        apply(0, m_v, m_phat);
+        alpha = rho_new / MultiFab::Dot(m_rhat, 0, m_v, 0, 1, 0);
+
+        MultiFab::Saxpy(m_sol, alpha, m_phat, 0, 0, 1, 0);
+        MultiFab::LinComb(m_s, 1.0, m_r, 0, -alpha, m_v, 0, 0, 1, 0);
+        rnorm = m_s.norm0();
+        if (m_verbose > 1) {
+            Print() << "TerrainPoisson: BiCGStab iteration " << iter << " half step residual " << rnorm << std::endl;
+        }
+        if (rnorm <= tol) { return iter; }
+
+        precondition(m_shat, m_s);
+        apply(0, m_t, m_shat);
+        Real tt = MultiFab::Dot(m_t, 0, m_t, 0, 1, 0);
+        omega = (tt > 0.0) ? MultiFab::Dot(m_t, 0, m_s, 0, 1, 0) / tt : 0.0;
+
+        MultiFab::Saxpy(m_sol, omega, m_shat, 0, 0, 1, 0);
+        MultiFab::LinComb(m_r, 1.0, m_s, 0, -omega, m_t, 0, 0, 1, 0);
+        rnorm = m_r.norm0();
+        if (m_verbose > 1) {
+            Print() << "TerrainPoisson: BiCGStab iteration " << iter << " residual " << rnorm << std::endl;
+        }
+        if (rnorm <= tol || omega == 0.0) { return iter; }
+
+        rho = rho_new;
+    }
+    return m_max_iter;
+}
+
+// V-cycles on their own for L(m_sol) = m_b
+int
+TerrainPoisson::vcycles (Real tol, Real& rnorm)
+{
+    for (int iter = 0; iter <= m_max_iter; ++iter)
+    {
+        residual(0, m_r, m_sol, m_b);
+        rnorm = m_r.norm0();
+        if (m_verbose > 1) {
+            Print() << "TerrainPoisson: V-cycle " << iter << " residual " << rnorm << std::endl;
+        }
+        if (rnorm <= tol || iter == m_max_iter) { return iter; }
+
+        precondition(m_phat, m_r);
+        MultiFab::Add(m_sol, m_phat, 0, 0, 1, 0);
+    }
+    return m_max_iter;
+}
+
+int
+TerrainPoisson::solve (MultiFab& phi, const MultiFab& rhs, Real reltol, Real abstol)
+{
+    BL_PROFILE("TerrainPoisson::solve()");
+    AMREX_ALWAYS_ASSERT(m_has_terrain && m_has_coeffs);
+
+    Real start = amrex::second();
+
+    MultiFab::Copy(m_b, rhs, 0, 0, 1, 0);
+
+    // Without a Dirichlet boundary the rhs must integrate to zero over the domain
+    if (m_singular) {
+        Real offset = MultiFab::Dot(m_detJ[0], 0, m_b, 0, 1, 0) / m_detJ[0].sum(0);
+        m_b.plus(-offset, 0, 1, 0);
+    }
+
+    Real tol = std::max(reltol * m_b.norm0(), abstol);
+
+    MultiFab::Copy(m_sol, phi, 0, 0, 1, 0);
+
+    Real rnorm = 0.0;
+    int niter = (m_use_bicgstab) ? bicgstab(tol, rnorm) : vcycles(tol, rnorm);
+
+    MultiFab::Copy(phi, m_sol, 0, 0, 1, 0);
+
+    m_solve_time = amrex::second() - start;
+    ParallelDescriptor::ReduceRealMax(m_solve_time);
+
+    if (m_verbose > 0) {
+        Print() << "TerrainPoisson: " << numLevels() << " levels, " << niter
+                << " iterations, residual " << rnorm << " (tolerance " << tol << ") in "
+                << m_solve_time << " s" << std::endl;
+    }
+    if (rnorm > tol) {
+        Abort("TerrainPoisson::solve failed to converge");
+    }
+
+    return niter;
+}
+
+void
+TerrainPoisson::getFluxes (const Array<MultiFab*,AMREX_SPACEDIM>& flux)
+{
+    BL_PROFILE("TerrainPoisson::getFluxes()");
+
+    m_sol.FillBoundary(m_geom[0].periodicity());
+
+    const Box domain = m_geom[0].Domain();
+    const auto dxInv = m_geom[0].InvCellSizeArray();
+    const int bclo_x = tp_bc_type(m_bclo[0]);
+    const int bchi_x = tp_bc_type(m_bchi[0]);
+    const int bclo_y = tp_bc_type(m_bclo[1]);
+    const int bchi_y = tp_bc_type(m_bchi[1]);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(m_sol, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Array4<Real const>& phi_arr = m_sol.const_array(mfi);
+        const Array4<Real const>& z_nd    = m_z_nd[0].const_array(mfi);
+        const Array4<Real const>& beta_x  = m_beta[0][0].const_array(mfi);
+        const Array4<Real const>& beta_y  = m_beta[0][1].const_array(mfi);
+        const Array4<Real const>& beta_z  = m_beta[0][2].const_array(mfi);
+        const Array4<Real      >& fx      = flux[0]->array(mfi);
+        const Array4<Real      >& fy      = flux[1]->array(mfi);
+        const Array4<Real      >& fz      = flux[2]->array(mfi);
+
+        ParallelFor(mfi.nodaltilebox(0), mfi.nodaltilebox(1), mfi.nodaltilebox(2),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            fx(i,j,k) = tp_flux_x(i, j, k, phi_arr, beta_x, z_nd, dxInv, domain, bclo_x, bchi_x);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            fy(i,j,k) = tp_flux_y(i, j, k, phi_arr, beta_y, z_nd, dxInv, domain, bclo_y, bchi_y);
+        },
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            fz(i,j,k) = tp_flux_z(i, j, k, phi_arr, beta_z, z_nd, dxInv, domain);
+        });
+    }
+}
+
+void
+TerrainPoisson::computeDivergence (MultiFab& rhs, const Array<const MultiFab*,AMREX_SPACEDIM>& U)
+{
+    BL_PROFILE("TerrainPoisson::computeDivergence()");
+    AMREX_ALWAYS_ASSERT(m_has_terrain);
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        MultiFab::Copy(m_face[dir], *U[dir], 0, 0, 1, 0);
+        m_face[dir].FillBoundary(m_geom[0].periodicity());
+    }
+
+    const Box domain = m_geom[0].Domain();
+    const auto dxInv = m_geom[0].InvCellSizeArray();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(rhs, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const Array4<Real const>& u    = m_face[0].const_array(mfi);
+        const Array4<Real const>& v    = m_face[1].const_array(mfi);
+        const Array4<Real const>& w    = m_face[2].const_array(mfi);
+        const Array4<Real const>& z_nd = m_z_nd[0].const_array(mfi);
+        const Array4<Real const>& detJ = m_detJ[0].const_array(mfi);
+        const Array4<Real      >& div  = rhs.array(mfi);
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            Real omega_lo = OmegaFromW(i, j, k, w(i,j,k), u, v, z_nd, dxInv);
+            Real omega_hi;
+            if (k == domain.bigEnd(2)) {
+                // the velocities of the top cell stand in for those on the top face
+                Real met_h_xi  = Compute_h_xi_AtKface (i, j, k+1, dxInv, z_nd);
+                Real met_h_eta = Compute_h_eta_AtKface(i, j, k+1, dxInv, z_nd);
+                omega_hi = w(i,j,k+1) - met_h_xi  * 0.5 * (u(i,j,k) + u(i+1,j,k))
+                                      - met_h_eta * 0.5 * (v(i,j,k) + v(i,j+1,k));
+            } else {
+                omega_hi = OmegaFromW(i, j, k+1, w(i,j,k+1), u, v, z_nd, dxInv);
+            }
+            div(i,j,k) = tp_divergence(i, j, k, u, v, omega_lo, omega_hi, z_nd, detJ, dxInv);
+        });
+    }
+}
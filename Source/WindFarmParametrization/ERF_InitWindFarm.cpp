@@ -200,10 +200,126 @@ WindFarm::read_windfarm_spec_table(const std::string windfarm_spec_table)
 
 }
 
+/**
+ * Bin the turbines on the (i,j) columns of the domain of geom. A turbine is
+ * placed in the x-column that contains its disk and in every y-column the disk
+ * can reach, with one cell of padding; its index-space bounding box is kept so
+ * that tiles away from all disks can be skipped.
+ */
+void
+TurbineBins::build (const Geometry& geom,
+                    const Vector<Real>& xloc,
+                    const Vector<Real>& yloc,
+                    const Real& rotor_rad,
+                    const Real& hub_height)
+{
+    domain = geom.Domain();
+    ilo = domain.smallEnd(0); nx = domain.length(0) + 1;
+    jlo = domain.smallEnd(1); ny = domain.length(1) + 1;
+    int klo = domain.smallEnd(2);
+    int khi = domain.bigEnd(2) + 1;
+    auto dx = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+    int num_turb = xloc.size();
+
+    Vector<int> h_offsets(nx*ny+1, 0);
+    Vector<Box> h_boxes;
+    Vector<int> h_turb;
+    for (int it = 0; it < num_turb; it++) {
+        int i = static_cast<int>(std::floor((xloc[it]+1e-12 - ProbLoArr[0])/dx[0]));
+        if (i < ilo || i > ilo+nx-1) { continue; }
+
+        int j0 = static_cast<int>(std::floor((yloc[it]-rotor_rad - ProbLoArr[1])/dx[1] - 0.5));
+        int j1 = static_cast<int>(std::ceil ((yloc[it]+rotor_rad - ProbLoArr[1])/dx[1] - 0.5));
+        int k0 = static_cast<int>(std::floor((hub_height-rotor_rad - ProbLoArr[2])/dx[2] - 0.5));
+        int k1 = static_cast<int>(std::ceil ((hub_height+rotor_rad - ProbLoArr[2])/dx[2] - 0.5));
+        j0 = amrex::max(j0, jlo); j1 = amrex::min(j1, jlo+ny-1);
+        k0 = amrex::max(k0, klo); k1 = amrex::min(k1, khi);
+        if (j0 > j1 || k0 > k1) { continue; }
+
+        h_boxes.push_back(Box(IntVect(i,j0,k0), IntVect(i,j1,k1)));
+        h_turb.push_back(it);
+        for (int j = j0; j <= j1; j++) {
+            h_offsets[(j-jlo)*nx + (i-ilo) + 1]++;
+        }
+    }
+
+    for (int n = 0; n < nx*ny; n++) {
+        h_offsets[n+1] += h_offsets[n];
+    }
+
+    Vector<int> h_ids(h_offsets[nx*ny]);
+    Vector<int> cursor(h_offsets.begin(), h_offsets.end()-1);
+    for (int ib = 0; ib < h_boxes.size(); ib++) {
+        const Box& b = h_boxes[ib];
+        for (int j = b.smallEnd(1); j <= b.bigEnd(1); j++) {
+            h_ids[cursor[(j-jlo)*nx + (b.smallEnd(0)-ilo)]++] = h_turb[ib];
+        }
+    }
+
+    offsets.resize(h_offsets.size());
+    ids.resize(h_ids.size());
+    Gpu::copy(Gpu::hostToDevice, h_offsets.begin(), h_offsets.end(), offsets.begin());
+    Gpu::copy(Gpu::hostToDevice, h_ids.begin(), h_ids.end(), ids.begin());
+
+    disk_boxes = h_boxes.empty() ? BoxArray() : BoxArray(BoxList(std::move(h_boxes)));
+}
+
+void
+TurbineBins::sparse_layout (const BoxArray& ba,
+                            const DistributionMapping& dm,
+                            const IntVect& halo,
+                            bool all_k,
+                            BoxArray& ba_sparse,
+                            DistributionMapping& dm_sparse) const
+{
+    BoxList bl_region;
+    for (int ib = 0; ib < disk_boxes.size(); ib++) {
+        Box b = disk_boxes[ib];
+        b.grow(halo);
+        if (all_k) { b.setRange(2, domain.smallEnd(2), domain.length(2)); }
+        bl_region.push_back(b);
+    }
+
+    BoxList bl_sparse;
+    Vector<int> pmap;
+    if (!bl_region.isEmpty()) {
+        BoxArray ba_region(std::move(bl_region));
+        ba_region.removeOverlap();
+        for (int n = 0; n < ba.size(); n++) {
+            for (const auto& is : ba_region.intersections(ba[n])) {
+                bl_sparse.push_back(is.second);
+                pmap.push_back(dm[n]);
+            }
+        }
+    }
+
+    // Keep a single cell if no turbine reaches this level so the fields stay defined
+    if (bl_sparse.isEmpty()) {
+        bl_sparse.push_back(Box(ba[0].smallEnd(), ba[0].smallEnd()));
+        pmap.push_back(dm[0]);
+    }
+
+    ba_sparse = BoxArray(std::move(bl_sparse));
+    dm_sparse = DistributionMapping(std::move(pmap));
+}
+
+const TurbineBins&
+NullWindFarm::get_turb_bins (const Geometry& geom)
+{
+    for (const auto& bins : m_turb_bins) {
+        if (bins->domain == geom.Domain()) { return *bins; }
+    }
+    m_turb_bins.push_back(std::make_unique<TurbineBins>());
+    m_turb_bins.back()->build(geom, m_xloc, m_yloc, m_rotor_rad, m_hub_height);
+    return *m_turb_bins.back();
+}
+
 void
 WindFarm::fill_Nturb_multifab(const Geometry& geom,
                               MultiFab& mf_Nturb)
 {
+    const TurbineBins& bins = build_turb_bins(geom);
 
     amrex::Gpu::DeviceVector<Real> d_xloc(xloc.size());
     amrex::Gpu::DeviceVector<Real> d_yloc(yloc.size());
@@ -212,6 +328,9 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
 
     Real* d_xloc_ptr     = d_xloc.data();
     Real* d_yloc_ptr     = d_yloc.data();
+    const int* bin_off   = bins.offsets.data();
+    const int* bin_ids   = bins.ids.data();
+    int bin_ilo = bins.ilo; int bin_jlo = bins.jlo; int bin_nx = bins.nx;
 
     mf_Nturb.setVal(0);
 
@@ -219,7 +338,6 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
     int j_lo = geom.Domain().smallEnd(1); int j_hi = geom.Domain().bigEnd(1);
     auto dx = geom.CellSizeArray();
     auto ProbLoArr = geom.ProbLoArray();
-    int num_turb = xloc.size();
 
      // Initialize wind farm
     for ( MFIter mfi(mf_Nturb,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
@@ -234,7 +352,9 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
             Real y1 = ProbLoArr[1] + lj*dx[1];
             Real y2 = ProbLoArr[1] + (lj+1)*dx[1];
 
-            for(int it=0; it<num_turb; it++){
+            int n = (lj-bin_jlo)*bin_nx + (li-bin_ilo);
+            for(int ib=bin_off[n]; ib<bin_off[n+1]; ib++){
+                int it = bin_ids[ib];
                 if( d_xloc_ptr[it]+1e-12 > x1 and d_xloc_ptr[it]+1e-12 < x2 and
                     d_yloc_ptr[it]+1e-12 > y1 and d_yloc_ptr[it]+1e-12 < y2){
                        Nturb_array(i,j,k,0) = Nturb_array(i,j,k,0) + 1;
@@ -242,6 +362,9 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
             }
         });
     }
+
+    // The ghost cells of the sparse boxes may lie inside neighboring ones
+    mf_Nturb.FillBoundary(geom.periodicity());
 }
 
 
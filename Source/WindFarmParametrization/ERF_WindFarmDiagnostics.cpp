@@ -0,0 +1,201 @@
+/**
+ * \file ERF_WindFarmDiagnostics.cpp
+ */
+
+#include <ERF_WindFarm.H>
+#include <ERF_IndexDefines.H>
+#include <ERF_Constants.H>
+#include <ERF_Interpolation_1D.H>
+
+using namespace amrex;
+
+/**
+ * Sum the cell-centered velocity and density over the actuator disk cells of each
+ * turbine. Only the cells of the sparse forcing layout are visited; the sums are
+ * returned per turbine as (u, v, w, rho, ncells) and are reduced across ranks.
+ */
+void
+NullWindFarm::rotor_averages (const Geometry& geom,
+                              const MultiFab& mf_vars_windfarm,
+                              const MultiFab& cons_in,
+                              const MultiFab& U_old,
+                              const MultiFab& V_old,
+                              const MultiFab& W_old,
+                              Vector<Real>& avg)
+{
+    int nturb = m_xloc.size();
+    avg.assign(5*nturb, 0.0);
+    if (nturb == 0) { return; }
+
+    const TurbineBins& bins = get_turb_bins(geom);
+    const int* bin_off = bins.offsets.data();
+    const int* bin_ids = bins.ids.data();
+    int bin_ilo = bins.ilo; int bin_jlo = bins.jlo; int bin_nx = bins.nx;
+
+    Gpu::DeviceVector<Real> d_xloc(nturb);
+    Gpu::DeviceVector<Real> d_yloc(nturb);
+    Gpu::copy(Gpu::hostToDevice, m_xloc.begin(), m_xloc.end(), d_xloc.begin());
+    Gpu::copy(Gpu::hostToDevice, m_yloc.begin(), m_yloc.end(), d_yloc.begin());
+    const Real* d_xloc_ptr = d_xloc.data();
+    const Real* d_yloc_ptr = d_yloc.data();
+
+    Gpu::DeviceVector<Real> d_avg(5*nturb, 0.0);
+    Real* sums = d_avg.data();
+
+    auto dx = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+    Real d_rotor_rad  = m_rotor_rad;
+    Real d_hub_height = m_hub_height;
+
+    for (MFIter mfi(mf_vars_windfarm); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        const int ip = TurbineBins::parent_grid(cons_in.boxArray(), bx);
+        auto cons_arr = cons_in.const_array(ip);
+        auto u_vel    = U_old.const_array(ip);
+        auto v_vel    = V_old.const_array(ip);
+        auto w_vel    = W_old.const_array(ip);
+
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            Real x1 = ProbLoArr[0] + i*dx[0];
+            Real x2 = ProbLoArr[0] + (i+1)*dx[0];
+            Real y  = ProbLoArr[1] + (j+0.5)*dx[1];
+            Real z  = ProbLoArr[2] + (k+0.5)*dx[2];
+
+            int n = (j-bin_jlo)*bin_nx + (i-bin_ilo);
+            for (int ib = bin_off[n]; ib < bin_off[n+1]; ib++) {
+                int it = bin_ids[ib];
+                if (d_xloc_ptr[it]+1e-12 > x1 and d_xloc_ptr[it]+1e-12 < x2 and
+                    (y-d_yloc_ptr[it])*(y-d_yloc_ptr[it]) + (z-d_hub_height)*(z-d_hub_height)
+                    < d_rotor_rad*d_rotor_rad)
+                {
+                    Gpu::Atomic::AddNoRet(&sums[5*it  ], 0.5*(u_vel(i,j,k) + u_vel(i+1,j,k)));
+                    Gpu::Atomic::AddNoRet(&sums[5*it+1], 0.5*(v_vel(i,j,k) + v_vel(i,j+1,k)));
+                    Gpu::Atomic::AddNoRet(&sums[5*it+2], 0.5*(w_vel(i,j,k) + w_vel(i,j,k+1)));
+                    Gpu::Atomic::AddNoRet(&sums[5*it+3], cons_arr(i,j,k,Rho_comp));
+                    Gpu::Atomic::AddNoRet(&sums[5*it+4], Real(1.0));
+                }
+            }
+        });
+    }
+
+    Gpu::copy(Gpu::deviceToHost, d_avg.begin(), d_avg.end(), avg.begin());
+    ParallelDescriptor::ReduceRealSum(avg.data(), avg.size());
+}
+
+/**
+ * Thrust (N) and power (W) of a turbine from the thrust coefficient and power
+ * curves of the specifications table at the rotor-averaged wind speed
+ */
+void
+NullWindFarm::rotor_thrust_power (int /*it*/, const Real& umag, const Real& rho,
+                                  Real& thrust, Real& power) const
+{
+    int n = m_wind_speed.size();
+    if (n < 2) {
+        thrust = 0.0;
+        power  = 0.0;
+        return;
+    }
+    Real u = amrex::min(amrex::max(umag, m_wind_speed[0]), m_wind_speed[n-1]);
+    Real C_T = interpolate_1d(m_wind_speed.data(), m_thrust_coeff.data(), u, n);
+    thrust = 0.5*rho*PI*m_rotor_rad*m_rotor_rad*C_T*umag*umag;
+    power  = interpolate_1d(m_wind_speed.data(), m_power.data(), u, n)*1.0e3;
+}
+
+void
+WindFarm::init_turbine_diagnostics (const std::string& diag_file, int flush_int)
+{
+    m_diag_file = diag_file;
+    m_diag_flush_int = amrex::max(flush_int, 1);
+}
+
+/**
+ * Append one record (time, then u, v, w, |U|, thrust, power for each turbine) to the
+ * diagnostics buffer and write the buffer out every m_diag_flush_int records
+ */
+void
+WindFarm::sample_turbine_diagnostics (const Geometry& geom,
+                                      const Real& time,
+                                      const MultiFab& mf_vars_windfarm,
+                                      const MultiFab& cons_in,
+                                      const MultiFab& U_old,
+                                      const MultiFab& V_old,
+                                      const MultiFab& W_old)
+{
+    Vector<Real> avg;
+    m_windfarm_model[0]->rotor_averages(geom, mf_vars_windfarm, cons_in, U_old, V_old, W_old, avg);
+
+    int nturb = avg.size()/5;
+    if (m_diag_nturb < 0) { m_diag_nturb = nturb; }
+    AMREX_ALWAYS_ASSERT(nturb == m_diag_nturb);
+
+    m_diag_buffer.push_back(time);
+    for (int it = 0; it < nturb; it++) {
+        Real ncells = amrex::max(avg[5*it+4], Real(1.0));
+        Real u   = avg[5*it  ]/ncells;
+        Real v   = avg[5*it+1]/ncells;
+        Real w   = avg[5*it+2]/ncells;
+        Real rho = avg[5*it+3]/ncells;
+        Real umag = std::sqrt(u*u + v*v + w*w);
+        Real thrust, power;
+        m_windfarm_model[0]->rotor_thrust_power(it, umag, rho, thrust, power);
+        m_diag_buffer.insert(m_diag_buffer.end(), {u, v, w, umag, thrust, power});
+    }
+
+    if (++m_diag_nbuffered >= m_diag_flush_int) {
+        flush_turbine_diagnostics();
+    }
+}
+
+void
+WindFarm::restart_turbine_diagnostics (const Real& restart_time)
+{
+    m_diag_restart_time = restart_time;
+}
+
+void
+WindFarm::flush_turbine_diagnostics ()
+{
+    if (m_diag_nbuffered == 0) { return; }
+
+    bool append = m_diag_header_written;
+    if (ParallelDescriptor::IOProcessor()) {
+        if (!m_diag_header_written) {
+            std::ofstream header(m_diag_file + ".txt");
+            header << "nturbines " << m_diag_nturb << "\n"
+                   << "record: time, then per turbine: u v w |U| thrust(N) power(W)\n"
+                   << "values: float64, native byte order\n";
+
+            // Keep the records of the earlier run up to the restart time; a record
+            // beyond it was written after the checkpoint and will be sampled again
+            if (m_diag_restart_time >= 0.0) {
+                std::ifstream old_file(m_diag_file + ".bin", std::ios::binary);
+                if (old_file.is_open()) {
+                    const std::size_t nrec = 1 + 6*m_diag_nturb;
+                    Vector<double> kept, rec(nrec);
+                    while (old_file.read(reinterpret_cast<char*>(rec.data()), nrec*sizeof(double))) {
+                        if (rec[0] > m_diag_restart_time) { break; }
+                        kept.insert(kept.end(), rec.begin(), rec.end());
+                    }
+                    old_file.close();
+
+                    std::ofstream file(m_diag_file + ".bin", std::ios::binary | std::ios::trunc);
+                    file.write(reinterpret_cast<const char*>(kept.data()), kept.size()*sizeof(double));
+                    append = true;
+                }
+            }
+        }
+        std::ofstream file(m_diag_file + ".bin",
+                           append ? std::ios::binary | std::ios::app
+                                  : std::ios::binary | std::ios::trunc);
+        for (const Real& val : m_diag_buffer) {
+            double dval = static_cast<double>(val);
+            file.write(reinterpret_cast<const char*>(&dval), sizeof(double));
+        }
+    }
+
+    m_diag_header_written = true;
+    m_diag_buffer.clear();
+    m_diag_nbuffered = 0;
+}
@@ -66,16 +66,21 @@ Fitch::update (const Real& dt_advance,
                const MultiFab& mf_vars_fitch)
 {
 
-    for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    // The forcing only lives on the sparse boxes around the turbines
+    const BoxArray& ba = cons_in.boxArray();
+    for ( MFIter mfi(mf_vars_fitch,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const Box& vbx = mfi.validbox();
+        const int  ip  = TurbineBins::parent_grid(ba, vbx);
 
         Box bx  = mfi.tilebox();
-        Box tbx = mfi.nodaltilebox(0);
-        Box tby = mfi.nodaltilebox(1);
+        Box tbx = TurbineBins::owned_faces(mfi.nodaltilebox(0), vbx, ba[ip], 0);
+        Box tby = TurbineBins::owned_faces(mfi.nodaltilebox(1), vbx, ba[ip], 1);
 
-        auto cons_array  = cons_in.array(mfi);
+        auto cons_array  = cons_in.array(ip);
         auto fitch_array = mf_vars_fitch.array(mfi);
-        auto u_vel       = U_old.array(mfi);
-        auto v_vel       = V_old.array(mfi);
+        auto u_vel       = U_old.array(ip);
+        auto v_vel       = V_old.array(ip);
 
         ParallelFor(tbx, tby, bx,
         [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
@@ -128,14 +133,17 @@ Fitch::source_terms_cellcentered (const Geometry& geom,
     Gpu::copy(Gpu::hostToDevice, wind_speed.begin(), wind_speed.end(), d_wind_speed.begin());
     Gpu::copy(Gpu::hostToDevice, thrust_coeff.begin(), thrust_coeff.end(), d_thrust_coeff.begin());
 
-  for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+  for ( MFIter mfi(mf_vars_fitch,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const int ip = TurbineBins::parent_grid(cons_in.boxArray(), mfi.validbox());
 
         const Box& gbx = mfi.growntilebox(1);
+
         auto fitch_array = mf_vars_fitch.array(mfi);
         auto Nturb_array = mf_Nturb.array(mfi);
-        auto u_vel       = U_old.array(mfi);
-        auto v_vel       = V_old.array(mfi);
-        auto w_vel       = W_old.array(mfi);
+        auto u_vel       = U_old.array(ip);
+        auto v_vel       = V_old.array(ip);
+        auto w_vel       = W_old.array(ip);
 
         const Real* wind_speed_d     = d_wind_speed.dataPtr();
         const Real* thrust_coeff_d   = d_thrust_coeff.dataPtr();
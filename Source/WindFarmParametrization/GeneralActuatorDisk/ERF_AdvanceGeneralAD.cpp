@@ -0,0 +1,610 @@
+#include <ERF_GeneralAD.H>
+#include <ERF_IndexDefines.H>
+#include <ERF_Constants.H>
+#include <ERF_Interpolation_1D.H>
+#include <AMReX_ParmParse.H>
+#include <algorithm>
+#include <map>
+
+using namespace amrex;
+
+GeneralAD::GeneralAD ()
+{
+    ParmParse pp("erf");
+
+    std::string mode = "disk";
+    pp.query("gad_mode", mode);
+    if (mode == "line") {
+        m_line = true;
+    } else if (mode != "disk") {
+        Abort("erf.gad_mode has to be disk or line");
+    }
+
+    pp.query("gad_num_blades", m_num_blades);
+    pp.query("gad_num_azimuth", m_num_azimuth);
+    pp.query("gad_rotor_rpm", m_rotor_rpm);
+    pp.query("gad_epsilon_by_dx", m_eps_by_dx);
+
+    Real yaw_deg = 0.0, yaw_rate_deg = 0.0;
+    pp.query("gad_yaw", yaw_deg);
+    pp.query("gad_yaw_rate", yaw_rate_deg);
+    m_yaw_init = yaw_deg*PI/180.0;
+    m_yaw_rate = yaw_rate_deg*PI/180.0;
+
+    std::string blade_table, airfoil_table;
+    pp.get("gad_blade_table", blade_table);
+    pp.get("gad_airfoil_table", airfoil_table);
+    read_blade_table(blade_table);
+    read_airfoil_table(airfoil_table);
+
+    // Blade element theory needs the blade speed; a disk without rotation sees the
+    // in-plane wind as the relative velocity and gives meaningless forces
+    if (m_rotor_rpm <= 0.0) {
+        if (!m_line) {
+            Abort("erf.gad_rotor_rpm has to be positive when erf.gad_mode = disk");
+        }
+        Warning("erf.gad_rotor_rpm is not positive; the actuator lines are parked");
+    }
+}
+
+void
+GeneralAD::read_blade_table (const std::string& blade_table)
+{
+    // The first line is the number of blade elements; each following line gives the
+    // radius (m), radial width (m), chord (m) and twist (deg) of one element
+    std::ifstream file(blade_table);
+    if (!file.is_open()) {
+        Error("Blade table not found. Either the inputs is missing the erf.gad_blade_table"
+              " entry or the file specified in the entry - " + blade_table + " is missing.");
+    }
+
+    int nelem;
+    file >> nelem;
+    m_blade_r.resize(nelem);
+    m_blade_dr.resize(nelem);
+    m_blade_chord.resize(nelem);
+    m_blade_twist.resize(nelem);
+    for (int e = 0; e < nelem; e++) {
+        file >> m_blade_r[e] >> m_blade_dr[e] >> m_blade_chord[e] >> m_blade_twist[e];
+        m_blade_twist[e] *= PI/180.0;
+    }
+    file.close();
+
+    d_blade_r.resize(nelem);
+    d_blade_dr.resize(nelem);
+    d_blade_chord.resize(nelem);
+    d_blade_twist.resize(nelem);
+    Gpu::copy(Gpu::hostToDevice, m_blade_r.begin(), m_blade_r.end(), d_blade_r.begin());
+    Gpu::copy(Gpu::hostToDevice, m_blade_dr.begin(), m_blade_dr.end(), d_blade_dr.begin());
+    Gpu::copy(Gpu::hostToDevice, m_blade_chord.begin(), m_blade_chord.end(), d_blade_chord.begin());
+    Gpu::copy(Gpu::hostToDevice, m_blade_twist.begin(), m_blade_twist.end(), d_blade_twist.begin());
+}
+
+void
+GeneralAD::read_airfoil_table (const std::string& airfoil_table)
+{
+    // The first line is the number of entries; each following line gives the angle of
+    // attack (deg, increasing), lift coefficient and drag coefficient
+    std::ifstream file(airfoil_table);
+    if (!file.is_open()) {
+        Error("Airfoil table not found. Either the inputs is missing the erf.gad_airfoil_table"
+              " entry or the file specified in the entry - " + airfoil_table + " is missing.");
+    }
+
+    int nlines;
+    file >> nlines;
+    if (nlines < 2) {
+        Abort("The airfoil table needs at least two entries");
+    }
+    m_aoa.resize(nlines);
+    m_cl.resize(nlines);
+    m_cd.resize(nlines);
+    for (int iline = 0; iline < nlines; iline++) {
+        file >> m_aoa[iline] >> m_cl[iline] >> m_cd[iline];
+    }
+    file.close();
+
+    d_aoa.resize(nlines);
+    d_cl.resize(nlines);
+    d_cd.resize(nlines);
+    Gpu::copy(Gpu::hostToDevice, m_aoa.begin(), m_aoa.end(), d_aoa.begin());
+    Gpu::copy(Gpu::hostToDevice, m_cl.begin(), m_cl.end(), d_cl.begin());
+    Gpu::copy(Gpu::hostToDevice, m_cd.begin(), m_cd.end(), d_cd.begin());
+}
+
+IntVect
+GeneralAD::forcing_halo (const Geometry& geom) const
+{
+    // The disk bins span one x-column and the rotor in y and z; yawing can turn the
+    // rotor into x, and the Gaussian projection reaches 3 epsilon beyond the rotor
+    auto dx = geom.CellSizeArray();
+    Real reach = 3.0*m_eps_by_dx*dx[0];
+    return IntVect(static_cast<int>(std::ceil((m_rotor_rad + reach)/dx[0])) + 1,
+                   static_cast<int>(std::ceil(reach/dx[1])) + 1,
+                   static_cast<int>(std::ceil(reach/dx[2])) + 1);
+}
+
+Box
+GeneralAD::reach_box (const Geometry& geom, int t) const
+{
+    // Index-space box that the projected forces of rotor t can reach
+    auto dx = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+    Real reach = m_rotor_rad + 3.0*m_eps_by_dx*dx[0];
+    IntVect halo(AMREX_D_DECL(static_cast<int>(std::ceil(reach/dx[0])) + 1,
+                              static_cast<int>(std::ceil(reach/dx[1])) + 1,
+                              static_cast<int>(std::ceil(reach/dx[2])) + 1));
+    IntVect iv(AMREX_D_DECL(static_cast<int>(std::floor((m_xloc[t]   - ProbLoArr[0])/dx[0])),
+                            static_cast<int>(std::floor((m_yloc[t]   - ProbLoArr[1])/dx[1])),
+                            static_cast<int>(std::floor((m_hub_height - ProbLoArr[2])/dx[2]))));
+    return Box(iv - halo, iv + halo);
+}
+
+void
+GeneralAD::advance (const Geometry& geom,
+                    const Real& dt_advance,
+                    MultiFab& cons_in,
+                    MultiFab& mf_vars_gad,
+                    MultiFab& U_old,
+                    MultiFab& V_old,
+                    MultiFab& W_old,
+                    const MultiFab& mf_Nturb)
+{
+    AMREX_ALWAYS_ASSERT(mf_Nturb.nComp() > 0);
+
+    if (m_yaw.size() != m_xloc.size()) {
+        m_yaw.assign(m_xloc.size(), m_yaw_init);
+    }
+    if (!m_base_domain.ok()) {
+        m_base_domain = geom.Domain();
+    }
+
+    compute_blade_points();
+    compute_blade_forces(geom, cons_in, mf_vars_gad, U_old, V_old, W_old);
+    source_terms_cellcentered(geom, cons_in, mf_vars_gad);
+    update(geom, dt_advance, cons_in, U_old, V_old, W_old, mf_vars_gad);
+
+    if (geom.Domain() == m_base_domain) {
+        update_yaw(dt_advance);
+        m_azimuth = std::fmod(m_azimuth + m_rotor_rpm*2.0*PI/60.0*dt_advance, 2.0*PI);
+    }
+}
+
+void
+GeneralAD::compute_blade_points ()
+{
+    int nturb = m_xloc.size();
+    int nsec  = nsections();
+    int nelem = m_blade_r.size();
+    int npts  = nturb*nsec*nelem;
+
+    m_pts.resize(3*npts);
+    for (int t = 0; t < nturb; t++) {
+        Real sg = std::sin(m_yaw[t]);
+        Real cg = std::cos(m_yaw[t]);
+        for (int s = 0; s < nsec; s++) {
+            Real theta = m_azimuth + 2.0*PI*s/nsec;
+            for (int e = 0; e < nelem; e++) {
+                int p = (t*nsec + s)*nelem + e;
+                Real r = m_blade_r[e];
+                // The rotor plane is spanned by the horizontal (-sin(yaw), cos(yaw), 0) and z
+                m_pts[3*p  ] = m_xloc[t] - r*std::cos(theta)*sg;
+                m_pts[3*p+1] = m_yloc[t] + r*std::cos(theta)*cg;
+                m_pts[3*p+2] = m_hub_height + r*std::sin(theta);
+            }
+        }
+    }
+
+    d_pts.resize(m_pts.size());
+    Gpu::copy(Gpu::hostToDevice, m_pts.begin(), m_pts.end(), d_pts.begin());
+}
+
+void
+GeneralAD::compute_blade_forces (const Geometry& geom,
+                                 const MultiFab& cons_in,
+                                 const MultiFab& mf_vars_gad,
+                                 const MultiFab& U_old,
+                                 const MultiFab& V_old,
+                                 const MultiFab& W_old)
+{
+    int nturb = m_xloc.size();
+    int nsec  = nsections();
+    int nelem = m_blade_r.size();
+    int npts_turb = nsec*nelem;
+    int npts  = nturb*npts_turb;
+
+    const BoxArray& ba = cons_in.boxArray();
+    const DistributionMapping& dm = cons_in.DistributionMap();
+    const Box& domain = geom.Domain();
+    auto dx = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+    const int myproc = ParallelDescriptor::MyProc();
+
+    // Each point is sampled by the rank owning the cell it lies in; every rank can
+    // work out the owners from the BoxArray and DistributionMapping
+    Vector<int> owner(npts, -1);
+    Vector<Vector<int>> pts_on_grid(ba.size());
+    for (int p = 0; p < npts; p++) {
+        IntVect iv(AMREX_D_DECL(static_cast<int>(std::floor((m_pts[3*p  ] - ProbLoArr[0])/dx[0])),
+                                static_cast<int>(std::floor((m_pts[3*p+1] - ProbLoArr[1])/dx[1])),
+                                static_cast<int>(std::floor((m_pts[3*p+2] - ProbLoArr[2])/dx[2]))));
+        if (!domain.contains(iv)) { continue; }
+        auto isects = ba.intersections(Box(iv,iv), true, 0);
+        if (isects.empty()) { continue; }
+        owner[p] = dm[isects[0].first];
+        if (owner[p] == myproc) {
+            pts_on_grid[isects[0].first].push_back(p);
+        }
+    }
+
+    // The local points are grouped by grid so that there is one launch per local grid
+    Vector<int> h_off(1, 0), h_ids, h_grid;
+    for (int ig = 0; ig < ba.size(); ig++) {
+        if (pts_on_grid[ig].empty()) { continue; }
+        h_ids.insert(h_ids.end(), pts_on_grid[ig].begin(), pts_on_grid[ig].end());
+        h_off.push_back(h_ids.size());
+        h_grid.push_back(ig);
+    }
+    const int nlocal = h_ids.size();
+    Gpu::DeviceVector<int> d_ids(nlocal);
+    Gpu::copy(Gpu::hostToDevice, h_ids.begin(), h_ids.end(), d_ids.begin());
+
+    Gpu::DeviceVector<Real> d_yaw(nturb);
+    Gpu::copy(Gpu::hostToDevice, m_yaw.begin(), m_yaw.end(), d_yaw.begin());
+
+    // Sampled velocity (3) and force on the fluid (3) at each local point
+    Gpu::DeviceVector<Real> d_out(6*nlocal, 0.0);
+
+    const Real* pts       = d_pts.data();
+    const Real* yaw       = d_yaw.data();
+    const Real* blade_r   = d_blade_r.data();
+    const Real* blade_dr  = d_blade_dr.data();
+    const Real* chord     = d_blade_chord.data();
+    const Real* twist     = d_blade_twist.data();
+    const Real* aoa       = d_aoa.data();
+    const Real* cl        = d_cl.data();
+    const Real* cd        = d_cd.data();
+    const int   n_polar   = d_aoa.size();
+    const Real  azimuth   = m_azimuth;
+    const Real  omega     = m_rotor_rpm*2.0*PI/60.0;
+    const Real  scale     = m_line ? 1.0 : Real(m_num_blades)/Real(nsec);
+
+    for (int n = 0; n < h_grid.size(); n++) {
+        const int ig = h_grid[n];
+        const int* ids = d_ids.data() + h_off[n];
+        Real* out = d_out.data() + 6*h_off[n];
+        auto cons_arr = cons_in.const_array(ig);
+        auto u_vel    = U_old.const_array(ig);
+        auto v_vel    = V_old.const_array(ig);
+        auto w_vel    = W_old.const_array(ig);
+
+        ParallelFor(h_off[n+1] - h_off[n], [=] AMREX_GPU_DEVICE (int m) noexcept
+        {
+            int p = ids[m];
+            int i = static_cast<int>(std::floor((pts[3*p  ] - ProbLoArr[0])/dx[0]));
+            int j = static_cast<int>(std::floor((pts[3*p+1] - ProbLoArr[1])/dx[1]));
+            int k = static_cast<int>(std::floor((pts[3*p+2] - ProbLoArr[2])/dx[2]));
+
+            Real u = 0.5*(u_vel(i,j,k) + u_vel(i+1,j,k));
+            Real v = 0.5*(v_vel(i,j,k) + v_vel(i,j+1,k));
+            Real w = 0.5*(w_vel(i,j,k) + w_vel(i,j,k+1));
+            Real rho = cons_arr(i,j,k,Rho_comp);
+
+            int t = p/(nsec*nelem);
+            int s = (p/nelem)%nsec;
+            int e = p%nelem;
+
+            // Rotor normal and direction of blade motion
+            Real theta = azimuth + 2.0*PI*s/nsec;
+            Real nx =  std::cos(yaw[t]);
+            Real ny =  std::sin(yaw[t]);
+            Real ex =  std::sin(theta)*ny;
+            Real ey = -std::sin(theta)*nx;
+            Real ez =  std::cos(theta);
+
+            Real Un  = u*nx + v*ny;
+            Real Ut  = omega*blade_r[e] - (u*ex + v*ey + w*ez);
+            Real phi = std::atan2(Un, Ut);
+
+            Real alpha = (phi - twist[e])*180.0/PI;
+            alpha = amrex::min(amrex::max(alpha, aoa[0]), aoa[n_polar-1]);
+            Real C_L = interpolate_1d(aoa, cl, alpha, n_polar);
+            Real C_D = interpolate_1d(aoa, cd, alpha, n_polar);
+
+            Real q  = 0.5*rho*(Un*Un + Ut*Ut)*chord[e]*blade_dr[e];
+            Real Fn = q*(C_L*std::cos(phi) + C_D*std::sin(phi));
+            Real Ft = q*(C_L*std::sin(phi) - C_D*std::cos(phi));
+
+            out[6*m  ] = u;
+            out[6*m+1] = v;
+            out[6*m+2] = w;
+            out[6*m+3] = -scale*(Fn*nx + Ft*ex);
+            out[6*m+4] = -scale*(Fn*ny + Ft*ey);
+            out[6*m+5] = -scale*Ft*ez;
+        });
+    }
+
+    Vector<Real> h_out(6*nlocal);
+    Gpu::copy(Gpu::deviceToHost, d_out.begin(), d_out.end(), h_out.begin());
+
+    // Per-turbine sums of u and v (for the yaw control), thrust and power over the
+    // local points; only these 4 numbers per turbine are reduced across ranks
+    m_force.assign(3*npts, 0.0);
+    Vector<Real> sums(4*nturb, 0.0);
+    for (int m = 0; m < nlocal; m++) {
+        int p = h_ids[m];
+        int t = p/npts_turb;
+        int s = (p/nelem)%nsec;
+        int e = p%nelem;
+        for (int d = 0; d < 3; d++) {
+            m_force[3*p+d] = h_out[6*m+3+d];
+        }
+
+        // Rotor thrust and power follow from the reaction of the forces on the fluid
+        Real nx = std::cos(m_yaw[t]);
+        Real ny = std::sin(m_yaw[t]);
+        Real theta = m_azimuth + 2.0*PI*s/nsec;
+        Real ex =  std::sin(theta)*ny;
+        Real ey = -std::sin(theta)*nx;
+        Real ez =  std::cos(theta);
+        sums[4*t  ] += h_out[6*m  ];
+        sums[4*t+1] += h_out[6*m+1];
+        sums[4*t+2] -= m_force[3*p]*nx + m_force[3*p+1]*ny;
+        sums[4*t+3] -= (m_force[3*p]*ex + m_force[3*p+1]*ey + m_force[3*p+2]*ez)
+                     * m_blade_r[e]*omega;
+    }
+    ParallelDescriptor::ReduceRealSum(sums.data(), sums.size());
+
+    m_rotor_uv.resize(2*nturb);
+    m_thrust.resize(nturb);
+    m_power_out.resize(nturb);
+    for (int t = 0; t < nturb; t++) {
+        m_rotor_uv[2*t  ] = sums[4*t  ];
+        m_rotor_uv[2*t+1] = sums[4*t+1];
+        m_thrust[t]       = sums[4*t+2];
+        m_power_out[t]    = sums[4*t+3];
+    }
+
+#ifdef AMREX_USE_MPI
+    // The point forces of a turbine only go to the ranks whose forcing grids its
+    // projection reaches. Both sides walk the points in the same order, so the
+    // messages carry the forces only.
+    const BoxArray& ba_gad = mf_vars_gad.boxArray();
+    const DistributionMapping& dm_gad = mf_vars_gad.DistributionMap();
+    std::map<int, Vector<Real>> send_buf;
+    std::map<int, Vector<int>>  recv_ids;
+    for (int t = 0; t < nturb; t++) {
+        Vector<int> needs;
+        for (const auto& is : ba_gad.intersections(amrex::grow(reach_box(geom, t), 1))) {
+            needs.push_back(dm_gad[is.first]);
+        }
+        std::sort(needs.begin(), needs.end());
+        needs.erase(std::unique(needs.begin(), needs.end()), needs.end());
+        bool i_need = std::binary_search(needs.begin(), needs.end(), myproc);
+
+        for (int p = t*npts_turb; p < (t+1)*npts_turb; p++) {
+            if (owner[p] == myproc) {
+                for (int q : needs) {
+                    if (q == myproc) { continue; }
+                    auto& buf = send_buf[q];
+                    buf.insert(buf.end(), &m_force[3*p], &m_force[3*p] + 3);
+                }
+            } else if (owner[p] >= 0 && i_need) {
+                recv_ids[owner[p]].push_back(p);
+            }
+        }
+    }
+
+    const int tag = ParallelDescriptor::SeqNum();
+    std::map<int, Vector<Real>> recv_buf;
+    Vector<MPI_Request> reqs;
+    for (const auto& kv : recv_ids) {
+        auto& buf = recv_buf[kv.first];
+        buf.resize(3*kv.second.size());
+        reqs.push_back(ParallelDescriptor::Arecv(buf.data(), buf.size(), kv.first, tag).req());
+    }
+    for (const auto& kv : send_buf) {
+        reqs.push_back(ParallelDescriptor::Asend(kv.second.data(), kv.second.size(), kv.first, tag).req());
+    }
+    Vector<MPI_Status> stats(reqs.size());
+    ParallelDescriptor::Waitall(reqs, stats);
+
+    for (const auto& kv : recv_ids) {
+        const auto& buf = recv_buf[kv.first];
+        for (int m = 0; m < kv.second.size(); m++) {
+            int p = kv.second[m];
+            for (int d = 0; d < 3; d++) {
+                m_force[3*p+d] = buf[3*m+d];
+            }
+        }
+    }
+#else
+    amrex::ignore_unused(mf_vars_gad);
+#endif
+
+    d_force.resize(m_force.size());
+    Gpu::copy(Gpu::hostToDevice, m_force.begin(), m_force.end(), d_force.begin());
+}
+
+void
+GeneralAD::source_terms_cellcentered (const Geometry& geom,
+                                      const MultiFab& cons_in,
+                                      MultiFab& mf_vars_gad)
+{
+    BL_PROFILE("GeneralAD::source_terms_cellcentered()");
+
+    int nturb = m_xloc.size();
+    int nsec  = nsections();
+    int nelem = m_blade_r.size();
+
+    auto dx = geom.CellSizeArray();
+    auto ProbLoArr = geom.ProbLoArray();
+
+    // The order of variables are - dudt, dvdt, dwdt
+    mf_vars_gad.setVal(0.0);
+
+    // Index-space box that each rotor's projected forces can reach
+    Real eps = m_eps_by_dx*dx[0];
+    BoxList bl_turb;
+    for (int t = 0; t < nturb; t++) {
+        bl_turb.push_back(reach_box(geom, t));
+    }
+    if (bl_turb.isEmpty()) { return; }
+    BoxArray ba_turb(std::move(bl_turb));
+
+    // Turbines reaching each tile; the cells gather the forces of those turbines only
+    Vector<int> h_off(1, 0), h_turb;
+    for (MFIter mfi(mf_vars_gad,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        for (const auto& is : ba_turb.intersections(mfi.growntilebox(1))) {
+            h_turb.push_back(is.first);
+        }
+        h_off.push_back(h_turb.size());
+    }
+    Gpu::DeviceVector<int> d_turb(h_turb.size());
+    Gpu::copy(Gpu::hostToDevice, h_turb.begin(), h_turb.end(), d_turb.begin());
+
+    const Real* pts   = d_pts.data();
+    const Real* force = d_force.data();
+    const Real cut2   = 9.0*eps*eps;
+    const Real inv_eps2 = 1.0/(eps*eps);
+    const Real norm   = 1.0/(eps*eps*eps*std::pow(PI,1.5));
+    const int  npts_turb = nsec*nelem;
+
+    int itile = 0;
+    for (MFIter mfi(mf_vars_gad,TilingIfNotGPU()); mfi.isValid(); ++mfi, ++itile) {
+        int nt = h_off[itile+1] - h_off[itile];
+        if (nt == 0) { continue; }
+
+        const int ip = TurbineBins::parent_grid(cons_in.boxArray(), mfi.validbox());
+        const Box& gbx = mfi.growntilebox(1);
+        const int* turb = d_turb.data() + h_off[itile];
+        auto gad_array  = mf_vars_gad.array(mfi);
+        auto cons_arr   = cons_in.const_array(ip);
+
+        ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            Real x = ProbLoArr[0] + (i+0.5)*dx[0];
+            Real y = ProbLoArr[1] + (j+0.5)*dx[1];
+            Real z = ProbLoArr[2] + (k+0.5)*dx[2];
+
+            Real fx = 0.0, fy = 0.0, fz = 0.0;
+            for (int n = 0; n < nt; n++) {
+                int p0 = turb[n]*npts_turb;
+                for (int p = p0; p < p0 + npts_turb; p++) {
+                    Real d2 = (x-pts[3*p  ])*(x-pts[3*p  ])
+                            + (y-pts[3*p+1])*(y-pts[3*p+1])
+                            + (z-pts[3*p+2])*(z-pts[3*p+2]);
+                    if (d2 < cut2) {
+                        Real eta = norm*std::exp(-d2*inv_eps2);
+                        fx += force[3*p  ]*eta;
+                        fy += force[3*p+1]*eta;
+                        fz += force[3*p+2]*eta;
+                    }
+                }
+            }
+
+            Real rho = cons_arr(i,j,k,Rho_comp);
+            gad_array(i,j,k,0) = fx/rho;
+            gad_array(i,j,k,1) = fy/rho;
+            gad_array(i,j,k,2) = fz/rho;
+        });
+    }
+}
+
+void
+GeneralAD::update (const Geometry& geom,
+                   const Real& dt_advance,
+                   MultiFab& cons_in,
+                   MultiFab& U_old, MultiFab& V_old, MultiFab& W_old,
+                   const MultiFab& mf_vars_gad)
+{
+    const Box& domain = geom.Domain();
+    int domlo_z = domain.smallEnd(2);
+    int domhi_z = domain.bigEnd(2);
+
+    // The forcing only lives on the sparse boxes around the rotors
+    const BoxArray& ba = cons_in.boxArray();
+    for ( MFIter mfi(mf_vars_gad,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const Box& vbx = mfi.validbox();
+        const int  ip  = TurbineBins::parent_grid(ba, vbx);
+
+        Box tbx = TurbineBins::owned_faces(mfi.nodaltilebox(0), vbx, ba[ip], 0);
+        Box tby = TurbineBins::owned_faces(mfi.nodaltilebox(1), vbx, ba[ip], 1);
+        Box tbz = TurbineBins::owned_faces(mfi.nodaltilebox(2), vbx, ba[ip], 2);
+
+        // w stays untouched on the bottom and top boundaries
+        tbz.setSmall(2, amrex::max(tbz.smallEnd(2), domlo_z+1));
+        tbz.setBig  (2, amrex::min(tbz.bigEnd(2),   domhi_z));
+
+        auto gad_array = mf_vars_gad.array(mfi);
+        auto u_vel     = U_old.array(ip);
+        auto v_vel     = V_old.array(ip);
+        auto w_vel     = W_old.array(ip);
+
+        ParallelFor(tbx, tby, tbz,
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            u_vel(i,j,k) = u_vel(i,j,k) + (gad_array(i-1,j,k,0) + gad_array(i,j,k,0))/2.0*dt_advance;
+        },
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            v_vel(i,j,k) = v_vel(i,j,k) + (gad_array(i,j-1,k,1) + gad_array(i,j,k,1))/2.0*dt_advance;
+        },
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        {
+            w_vel(i,j,k) = w_vel(i,j,k) + (gad_array(i,j,k-1,2) + gad_array(i,j,k,2))/2.0*dt_advance;
+        });
+    }
+}
+
+void
+GeneralAD::update_yaw (const Real& dt_advance)
+{
+    if (m_yaw_rate <= 0.0) { return; }
+
+    // Turn each rotor towards the rotor-averaged wind direction at the maximum yaw rate
+    int nturb = m_xloc.size();
+    Real max_turn = m_yaw_rate*dt_advance;
+    for (int t = 0; t < nturb; t++) {
+        Real ubar = m_rotor_uv[2*t  ];
+        Real vbar = m_rotor_uv[2*t+1];
+        if (ubar == 0.0 && vbar == 0.0) { continue; }
+        Real turn = std::remainder(std::atan2(vbar, ubar) - m_yaw[t], 2.0*PI);
+        m_yaw[t] += amrex::min(amrex::max(turn, -max_turn), max_turn);
+    }
+}
+
+void
+GeneralAD::rotor_thrust_power (int it, const Real& /*umag*/, const Real& /*rho*/,
+                               Real& thrust, Real& power) const
+{
+    if (it < m_thrust.size()) {
+        thrust = m_thrust[it];
+        power  = m_power_out[it];
+    } else {
+        thrust = 0.0;
+        power  = 0.0;
+    }
+}
+
+void
+GeneralAD::write_rotor_state (std::ostream& os) const
+{
+    os << m_azimuth << "\n";
+    os << m_yaw.size() << "\n";
+    for (const auto& yaw : m_yaw) {
+        os << yaw << "\n";
+    }
+}
+
+void
+GeneralAD::read_rotor_state (std::istream& is)
+{
+    int nturb;
+    is >> m_azimuth >> nturb;
+    m_yaw.resize(nturb);
+    for (int t = 0; t < nturb; t++) {
+        is >> m_yaw[t];
+    }
+}
@@ -26,14 +26,19 @@ SimpleAD::update (const Real& dt_advance,
                   const MultiFab& mf_vars_simpleAD)
 {
 
-    for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    // The forcing only lives on the sparse boxes around the actuator disks
+    const BoxArray& ba = cons_in.boxArray();
+    for ( MFIter mfi(mf_vars_simpleAD,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
-        Box tbx = mfi.nodaltilebox(0);
-        Box tby = mfi.nodaltilebox(1);
+        const Box& vbx = mfi.validbox();
+        const int  ip  = TurbineBins::parent_grid(ba, vbx);
+
+        Box tbx = TurbineBins::owned_faces(mfi.nodaltilebox(0), vbx, ba[ip], 0);
+        Box tby = TurbineBins::owned_faces(mfi.nodaltilebox(1), vbx, ba[ip], 1);
 
         auto simpleAD_array = mf_vars_simpleAD.array(mfi);
-        auto u_vel       = U_old.array(mfi);
-        auto v_vel       = V_old.array(mfi);
+        auto u_vel       = U_old.array(ip);
+        auto v_vel       = V_old.array(ip);
 
         ParallelFor(tbx, tby,
         [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
@@ -54,6 +59,7 @@ SimpleAD::source_terms_cellcentered (const Geometry& geom,
                                      const MultiFab& U_old,
                                      const MultiFab& V_old)
 {
+    BL_PROFILE("SimpleAD::source_terms_cellcentered()");
 
     get_turb_loc(xloc, yloc);
     get_turb_spec(rotor_rad, hub_height, thrust_coeff_standing,
@@ -85,14 +91,22 @@ SimpleAD::source_terms_cellcentered (const Geometry& geom,
 
       Real* d_xloc_ptr = d_xloc.data();
       Real* d_yloc_ptr = d_yloc.data();
-      long unsigned int nturbs = xloc.size();
 
-    for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+      // Only the turbines binned on the (ii,jj) column of a cell can reach it
+      const TurbineBins& bins = get_turb_bins(geom);
+      const int* bin_off = bins.offsets.data();
+      const int* bin_ids = bins.ids.data();
+      int bin_ilo = bins.ilo; int bin_jlo = bins.jlo; int bin_nx = bins.nx;
+
+    for ( MFIter mfi(mf_vars_simpleAD,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+        const int ip = TurbineBins::parent_grid(cons_in.boxArray(), mfi.validbox());
 
         const Box& gbx      = mfi.growntilebox(1);
+
         auto simpleAD_array = mf_vars_simpleAD.array(mfi);
-        auto u_vel          = U_old.array(mfi);
-        auto v_vel          = V_old.array(mfi);
+        auto u_vel          = U_old.array(ip);
+        auto v_vel          = V_old.array(ip);
 
         ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
             int ii = amrex::min(amrex::max(i, domlo_x), domhi_x);
@@ -113,7 +127,9 @@ SimpleAD::source_terms_cellcentered (const Geometry& geom,
 
             int check_int = 0;
 
-            for(long unsigned int it=0;it<nturbs;it++){
+            int n = (jj-bin_jlo)*bin_nx + (ii-bin_ilo);
+            for(int ib=bin_off[n];ib<bin_off[n+1];ib++){
+                int it = bin_ids[ib];
                 if(d_xloc_ptr[it]+1e-12 > x1 and d_xloc_ptr[it]+1e-12 < x2) {
                    if(std::pow((y-d_yloc_ptr[it])*(y-d_yloc_ptr[it]) + (z-d_hub_height)*(z-d_hub_height),0.5) < d_rotor_rad) {
                         check_int++;
@@ -52,6 +52,16 @@ void add_par () {
 
    int n_error_buf = 0;
    pp.queryAdd("n_error_buf",n_error_buf);
+
+   // With erf.column_grids every box spans the full height of the domain, so we
+   // never chop the grids in z
+   bool column_grids = false;
+   ParmParse pp_erf("erf");
+   pp_erf.query("column_grids",column_grids);
+   if (column_grids) {
+       pp.add("refine_grid_layout_z",0);
+       pp.add("max_grid_size_z",1<<20);
+   }
 }
 
 /**
@@ -0,0 +1,10 @@
+# ------------------  INPUTS TO THE SATURATION TABLE BENCHMARK  -------------------
+# Times one SAMCloud sweep with the analytic saturation fits and with the
+# saturation lookup table (erf.use_sat_table) and reports the speedup and the
+# largest difference of the adjusted state.
+
+bench.n_cell        = 64 64 64   # cells in the single box
+bench.n_iter        = 20         # timed sweeps per variant
+bench.moisture_type = 1          # 1: water and ice, 2: water only
+bench.rh_max        = 1.2        # relative humidity w.r.t. water at the last x-cell
+bench.qn_init       = 1.0e-4     # initial cloud water in every other y-row